@@ -0,0 +1,829 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2019-2020 Ilwoong Jeong (https://github.com/ilwoong)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+#include "aes.h"
+#include "util.inc"
+
+/**
+ * Constant-time bitsliced AES.
+ *
+ * Four blocks are spread over eight 64-bit words, one word per bit of every byte,
+ * in the layout of T. Pornin's BearSSL aes_ct64. The words are kept in two 64-bit lanes
+ * of a vector, so every operation below runs on eight blocks at once (SSE2 on x86-64).
+ * There are no table lookups and no secret dependent branches.
+ *
+ * The round keys are stored in a compressed bitsliced form of 16 bytes per round,
+ * so the key buffer has the same size as for the other implementations.
+ */
+typedef uint64_t bs_word __attribute__ ((vector_size (16)));
+
+static const uint32_t RC[] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36,
+};
+
+/******************************************************************************
+ * bitslice conversion
+ *****************************************************************************/
+static inline void swap_bits(bs_word* x, bs_word* y, uint64_t cl, uint64_t ch, int s)
+{
+    bs_word a = *x;
+    bs_word b = *y;
+
+    *x = (a & cl) | ((b & cl) << s);
+    *y = ((a & ch) >> s) | (b & ch);
+}
+
+static void ortho(bs_word* q)
+{
+    swap_bits(&q[0], &q[1], 0x5555555555555555, 0xaaaaaaaaaaaaaaaa, 1);
+    swap_bits(&q[2], &q[3], 0x5555555555555555, 0xaaaaaaaaaaaaaaaa, 1);
+    swap_bits(&q[4], &q[5], 0x5555555555555555, 0xaaaaaaaaaaaaaaaa, 1);
+    swap_bits(&q[6], &q[7], 0x5555555555555555, 0xaaaaaaaaaaaaaaaa, 1);
+
+    swap_bits(&q[0], &q[2], 0x3333333333333333, 0xcccccccccccccccc, 2);
+    swap_bits(&q[1], &q[3], 0x3333333333333333, 0xcccccccccccccccc, 2);
+    swap_bits(&q[4], &q[6], 0x3333333333333333, 0xcccccccccccccccc, 2);
+    swap_bits(&q[5], &q[7], 0x3333333333333333, 0xcccccccccccccccc, 2);
+
+    swap_bits(&q[0], &q[4], 0x0f0f0f0f0f0f0f0f, 0xf0f0f0f0f0f0f0f0, 4);
+    swap_bits(&q[1], &q[5], 0x0f0f0f0f0f0f0f0f, 0xf0f0f0f0f0f0f0f0, 4);
+    swap_bits(&q[2], &q[6], 0x0f0f0f0f0f0f0f0f, 0xf0f0f0f0f0f0f0f0, 4);
+    swap_bits(&q[3], &q[7], 0x0f0f0f0f0f0f0f0f, 0xf0f0f0f0f0f0f0f0, 4);
+}
+
+// w holds the little-endian words of one block for each lane
+static inline void interleave_in(bs_word* q0, bs_word* q1, const bs_word* w)
+{
+    bs_word x0 = w[0];
+    bs_word x1 = w[1];
+    bs_word x2 = w[2];
+    bs_word x3 = w[3];
+
+    x0 = (x0 | (x0 << 16)) & 0x0000ffff0000ffff;
+    x1 = (x1 | (x1 << 16)) & 0x0000ffff0000ffff;
+    x2 = (x2 | (x2 << 16)) & 0x0000ffff0000ffff;
+    x3 = (x3 | (x3 << 16)) & 0x0000ffff0000ffff;
+
+    x0 = (x0 | (x0 << 8)) & 0x00ff00ff00ff00ff;
+    x1 = (x1 | (x1 << 8)) & 0x00ff00ff00ff00ff;
+    x2 = (x2 | (x2 << 8)) & 0x00ff00ff00ff00ff;
+    x3 = (x3 | (x3 << 8)) & 0x00ff00ff00ff00ff;
+
+    *q0 = x0 | (x2 << 8);
+    *q1 = x1 | (x3 << 8);
+}
+
+static inline void interleave_out(bs_word* w, bs_word q0, bs_word q1)
+{
+    bs_word x0 = q0 & 0x00ff00ff00ff00ff;
+    bs_word x1 = q1 & 0x00ff00ff00ff00ff;
+    bs_word x2 = (q0 >> 8) & 0x00ff00ff00ff00ff;
+    bs_word x3 = (q1 >> 8) & 0x00ff00ff00ff00ff;
+
+    x0 = (x0 | (x0 >> 8)) & 0x0000ffff0000ffff;
+    x1 = (x1 | (x1 >> 8)) & 0x0000ffff0000ffff;
+    x2 = (x2 | (x2 >> 8)) & 0x0000ffff0000ffff;
+    x3 = (x3 | (x3 >> 8)) & 0x0000ffff0000ffff;
+
+    w[0] = (x0 | (x0 >> 16)) & 0xffffffff;
+    w[1] = (x1 | (x1 >> 16)) & 0xffffffff;
+    w[2] = (x2 | (x2 >> 16)) & 0xffffffff;
+    w[3] = (x3 | (x3 >> 16)) & 0xffffffff;
+}
+
+// blocks 0-3 go to the first lane and blocks 4-7 to the second one
+static void load_blocks(bs_word* q, const uint8_t* src)
+{
+    uint32_t words[32];
+    bs_word w[4];
+
+    memcpy(words, src, 128);
+
+    for (int i = 0; i < 4; ++i) {
+        w[0] = (bs_word) {words[4 * i    ], words[4 * i + 16]};
+        w[1] = (bs_word) {words[4 * i + 1], words[4 * i + 17]};
+        w[2] = (bs_word) {words[4 * i + 2], words[4 * i + 18]};
+        w[3] = (bs_word) {words[4 * i + 3], words[4 * i + 19]};
+        interleave_in(&q[i], &q[i + 4], w);
+    }
+
+    ortho(q);
+}
+
+static void store_blocks(uint8_t* dst, bs_word* q)
+{
+    uint32_t words[32];
+    bs_word w[4];
+
+    ortho(q);
+
+    for (int i = 0; i < 4; ++i) {
+        interleave_out(w, q[i], q[i + 4]);
+        for (int j = 0; j < 4; ++j) {
+            words[4 * i + j     ] = (uint32_t) w[j][0];
+            words[4 * i + j + 16] = (uint32_t) w[j][1];
+        }
+    }
+
+    memcpy(dst, words, 128);
+}
+
+/******************************************************************************
+ * bitsliced sbox, circuit of J. Boyar and R. Peralta
+ *****************************************************************************/
+static void sub_bytes(bs_word* q)
+{
+    bs_word x0, x1, x2, x3, x4, x5, x6, x7;
+    bs_word y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11;
+    bs_word y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+    bs_word z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11, z12, z13, z14, z15, z16, z17;
+    bs_word t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15, t16;
+    bs_word t17, t18, t19, t20, t21, t22, t23, t24, t25, t26, t27, t28, t29, t30, t31, t32;
+    bs_word t33, t34, t35, t36, t37, t38, t39, t40, t41, t42, t43, t44, t45, t46, t47, t48;
+    bs_word t49, t50, t51, t52, t53, t54, t55, t56, t57, t58, t59, t60, t61, t62, t63, t64;
+    bs_word t65, t66, t67;
+    bs_word s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    // top linear transformation
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    // non-linear section
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    // bottom linear transformation
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+// inverse of the affine transformation of the sbox, which is an involution up to the sbox itself
+static inline void inv_affine(bs_word* q)
+{
+    bs_word q0 = ~q[0];
+    bs_word q1 = ~q[1];
+    bs_word q2 = q[2];
+    bs_word q3 = q[3];
+    bs_word q4 = q[4];
+    bs_word q5 = ~q[5];
+    bs_word q6 = ~q[6];
+    bs_word q7 = q[7];
+
+    q[7] = q1 ^ q4 ^ q6;
+    q[6] = q0 ^ q3 ^ q5;
+    q[5] = q7 ^ q2 ^ q4;
+    q[4] = q6 ^ q1 ^ q3;
+    q[3] = q5 ^ q0 ^ q2;
+    q[2] = q4 ^ q7 ^ q1;
+    q[1] = q3 ^ q6 ^ q0;
+    q[0] = q2 ^ q5 ^ q7;
+}
+
+static void inv_sub_bytes(bs_word* q)
+{
+    inv_affine(q);
+    sub_bytes(q);
+    inv_affine(q);
+}
+
+/******************************************************************************
+ * bitsliced linear layers
+ *****************************************************************************/
+static inline bs_word rotr16(bs_word x)
+{
+    return (x >> 16) | (x << 48);
+}
+
+static inline bs_word rotr32(bs_word x)
+{
+    return (x >> 32) | (x << 32);
+}
+
+static inline void shift_rows(bs_word* q)
+{
+    for (int i = 0; i < 8; ++i) {
+        bs_word x = q[i];
+
+        q[i] = (x & 0x000000000000ffff)
+            | ((x & 0x00000000fff00000) >> 4)
+            | ((x & 0x00000000000f0000) << 12)
+            | ((x & 0x0000ff0000000000) >> 8)
+            | ((x & 0x000000ff00000000) << 8)
+            | ((x & 0xf000000000000000) >> 12)
+            | ((x & 0x0fff000000000000) << 4);
+    }
+}
+
+static inline void inv_shift_rows(bs_word* q)
+{
+    for (int i = 0; i < 8; ++i) {
+        bs_word x = q[i];
+
+        q[i] = (x & 0x000000000000ffff)
+            | ((x & 0x000000000fff0000) << 4)
+            | ((x & 0x00000000f0000000) >> 12)
+            | ((x & 0x000000ff00000000) << 8)
+            | ((x & 0x0000ff0000000000) >> 8)
+            | ((x & 0x000f000000000000) << 12)
+            | ((x & 0xfff0000000000000) >> 4);
+    }
+}
+
+static inline void mix_columns(bs_word* q)
+{
+    bs_word q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    bs_word q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    bs_word r0 = rotr16(q0), r1 = rotr16(q1), r2 = rotr16(q2), r3 = rotr16(q3);
+    bs_word r4 = rotr16(q4), r5 = rotr16(q5), r6 = rotr16(q6), r7 = rotr16(q7);
+
+    q[0] = q7 ^ r7 ^ r0 ^ rotr32(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ rotr32(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ rotr32(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ rotr32(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ rotr32(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ rotr32(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ rotr32(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ rotr32(q7 ^ r7);
+}
+
+static inline void inv_mix_columns(bs_word* q)
+{
+    bs_word q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    bs_word q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    bs_word r0 = rotr16(q0), r1 = rotr16(q1), r2 = rotr16(q2), r3 = rotr16(q3);
+    bs_word r4 = rotr16(q4), r5 = rotr16(q5), r6 = rotr16(q6), r7 = rotr16(q7);
+
+    q[0] = q5 ^ q6 ^ q7 ^ r0 ^ r5 ^ r7 ^ rotr32(q0 ^ q5 ^ q6 ^ r0 ^ r5);
+    q[1] = q0 ^ q5 ^ r0 ^ r1 ^ r5 ^ r6 ^ r7 ^ rotr32(q1 ^ q5 ^ q7 ^ r1 ^ r5 ^ r6);
+    q[2] = q0 ^ q1 ^ q6 ^ r1 ^ r2 ^ r6 ^ r7 ^ rotr32(q0 ^ q2 ^ q6 ^ r2 ^ r6 ^ r7);
+    q[3] = q0 ^ q1 ^ q2 ^ q5 ^ q6 ^ r0 ^ r2 ^ r3 ^ r5 ^ rotr32(q0 ^ q1 ^ q3 ^ q5 ^ q6 ^ q7 ^ r0 ^ r3 ^ r5 ^ r7);
+    q[4] = q1 ^ q2 ^ q3 ^ q5 ^ r1 ^ r3 ^ r4 ^ r5 ^ r6 ^ r7 ^ rotr32(q1 ^ q2 ^ q4 ^ q5 ^ q7 ^ r1 ^ r4 ^ r5 ^ r6);
+    q[5] = q2 ^ q3 ^ q4 ^ q6 ^ r2 ^ r4 ^ r5 ^ r6 ^ r7 ^ rotr32(q2 ^ q3 ^ q5 ^ q6 ^ r2 ^ r5 ^ r6 ^ r7);
+    q[6] = q3 ^ q4 ^ q5 ^ q7 ^ r3 ^ r5 ^ r6 ^ r7 ^ rotr32(q3 ^ q4 ^ q6 ^ q7 ^ r3 ^ r6 ^ r7);
+    q[7] = q4 ^ q5 ^ q6 ^ r4 ^ r6 ^ r7 ^ rotr32(q4 ^ q5 ^ q7 ^ r4 ^ r7);
+}
+
+static inline void add_round_keys(bs_word* q, const bs_word* rk)
+{
+    for (int i = 0; i < 8; ++i) {
+        q[i] ^= rk[i];
+    }
+}
+
+/******************************************************************************
+ * key schedule
+ *****************************************************************************/
+static uint32_t sub_word(uint32_t value)
+{
+    bs_word q[8] = {{0}};
+
+    q[0][0] = value;
+    ortho(q);
+    sub_bytes(q);
+    ortho(q);
+
+    return (uint32_t) q[0][0];
+}
+
+static inline uint32_t rot32r8(uint32_t value)
+{
+    return (value >> 8) ^ (value << 24);
+}
+
+// compresses each round key to two words, 16 bytes per round
+static void compress_round_keys(uint64_t* rks, const uint32_t* words, size_t rounds)
+{
+    bs_word q[8];
+    bs_word w[4];
+
+    for (size_t i = 0; i <= rounds; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            w[j] = (bs_word) {words[4 * i + j], 0};
+        }
+        interleave_in(&q[0], &q[4], w);
+        q[1] = q[0]; q[2] = q[0]; q[3] = q[0];
+        q[5] = q[4]; q[6] = q[4]; q[7] = q[4];
+        ortho(q);
+
+        rks[2 * i    ] = (q[0][0] & 0x1111111111111111) | (q[1][0] & 0x2222222222222222)
+                       | (q[2][0] & 0x4444444444444444) | (q[3][0] & 0x8888888888888888);
+        rks[2 * i + 1] = (q[4][0] & 0x1111111111111111) | (q[5][0] & 0x2222222222222222)
+                       | (q[6][0] & 0x4444444444444444) | (q[7][0] & 0x8888888888888888);
+    }
+}
+
+// expands the compressed round keys to one bitsliced word per bit, the same for both lanes
+static void expand_round_keys(bs_word* erks, const uint8_t* rks, size_t rounds)
+{
+    uint64_t crks[2 * (AES256_ROUNDS + 1)];
+
+    memcpy(crks, rks, 16 * (rounds + 1));
+
+    for (size_t i = 0; i < 2 * (rounds + 1); ++i) {
+        uint64_t x0 = crks[i] & 0x1111111111111111;
+        uint64_t x1 = (crks[i] & 0x2222222222222222) >> 1;
+        uint64_t x2 = (crks[i] & 0x4444444444444444) >> 2;
+        uint64_t x3 = (crks[i] & 0x8888888888888888) >> 3;
+
+        x0 = (x0 << 4) - x0;
+        x1 = (x1 << 4) - x1;
+        x2 = (x2 << 4) - x2;
+        x3 = (x3 << 4) - x3;
+
+        erks[4 * i    ] = (bs_word) {x0, x0};
+        erks[4 * i + 1] = (bs_word) {x1, x1};
+        erks[4 * i + 2] = (bs_word) {x2, x2};
+        erks[4 * i + 3] = (bs_word) {x3, x3};
+    }
+
+    wipe(crks, sizeof(crks));
+}
+
+/******************************************************************************
+ * encryption / decryption of eight blocks
+ *****************************************************************************/
+static void aes_encrypt_8blk(uint8_t* dst, const uint8_t* src, const bs_word* erks, size_t rounds)
+{
+    bs_word q[8];
+
+    load_blocks(q, src);
+
+    add_round_keys(q, erks);
+
+    for (size_t i = 1; i < rounds; ++i) {
+        sub_bytes(q);
+        shift_rows(q);
+        mix_columns(q);
+        add_round_keys(q, erks + 8 * i);
+    }
+
+    sub_bytes(q);
+    shift_rows(q);
+    add_round_keys(q, erks + 8 * rounds);
+
+    store_blocks(dst, q);
+}
+
+static void aes_decrypt_8blk(uint8_t* dst, const uint8_t* src, const bs_word* erks, size_t rounds)
+{
+    bs_word q[8];
+
+    load_blocks(q, src);
+
+    add_round_keys(q, erks + 8 * rounds);
+
+    for (size_t i = rounds - 1; i > 0; --i) {
+        inv_shift_rows(q);
+        inv_sub_bytes(q);
+        add_round_keys(q, erks + 8 * i);
+        inv_mix_columns(q);
+    }
+
+    inv_shift_rows(q);
+    inv_sub_bytes(q);
+    add_round_keys(q, erks);
+
+    store_blocks(dst, q);
+}
+
+static void aes_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks, size_t rounds)
+{
+    bs_word erks[8 * (AES256_ROUNDS + 1)];
+    uint8_t block[128] = {0};
+
+    expand_round_keys(erks, rks, rounds);
+
+    while (nblocks >= 8) {
+        aes_encrypt_8blk(dst, src, erks, rounds);
+        src += 128;
+        dst += 128;
+        nblocks -= 8;
+    }
+
+    if (nblocks > 0) {
+        memcpy(block, src, 16 * nblocks);
+        aes_encrypt_8blk(block, block, erks, rounds);
+        memcpy(dst, block, 16 * nblocks);
+    }
+
+    wipe(erks, sizeof(erks));
+    wipe(block, sizeof(block));
+}
+
+static void aes_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks, size_t rounds)
+{
+    bs_word erks[8 * (AES256_ROUNDS + 1)];
+    uint8_t block[128] = {0};
+
+    expand_round_keys(erks, rks, rounds);
+
+    while (nblocks >= 8) {
+        aes_decrypt_8blk(dst, src, erks, rounds);
+        src += 128;
+        dst += 128;
+        nblocks -= 8;
+    }
+
+    if (nblocks > 0) {
+        memcpy(block, src, 16 * nblocks);
+        aes_decrypt_8blk(block, block, erks, rounds);
+        memcpy(dst, block, 16 * nblocks);
+    }
+
+    wipe(erks, sizeof(erks));
+    wipe(block, sizeof(block));
+}
+
+// adds one to the 128-bit big-endian counter
+static inline void increase_counter(uint8_t* ctr)
+{
+    for (size_t i = 16; i-- > 0 && ++ctr[i] == 0; ) {
+    }
+}
+
+// the counter blocks are written out and encrypted 8 at a time, under one key expansion
+static void aes_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks, size_t rounds)
+{
+    bs_word erks[8 * (AES256_ROUNDS + 1)];
+    uint8_t ks[128];
+
+    expand_round_keys(erks, rks, rounds);
+
+    while (nblocks > 0) {
+        size_t n = (nblocks < 8) ? nblocks : 8;
+
+        for (size_t i = 0; i < 8; ++i) {
+            memcpy(ks + 16 * i, ctr, 16);
+            if (i < n) {
+                increase_counter(ctr);
+            }
+        }
+        aes_encrypt_8blk(ks, ks, erks, rounds);
+
+        for (size_t i = 0; i < 16 * n; ++i) {
+            dst[i] = src[i] ^ ks[i];
+        }
+
+        dst += 16 * n;
+        src += 16 * n;
+        nblocks -= n;
+    }
+
+    wipe(erks, sizeof(erks));
+    wipe(ks, sizeof(ks));
+}
+
+/******************************************************************************
+ * AES 128 bit key
+ *****************************************************************************/
+void aes128_keygen(uint8_t* rks, const uint8_t* mk)
+{
+    uint32_t words[4 * (AES128_ROUNDS + 1)];
+    uint32_t* rk = words;
+
+    memcpy(rk, mk, 16);
+
+    for (int i = 0; i < 10; ++i) {
+        rk[4] = rk[0] ^ sub_word(rot32r8(rk[3])) ^ RC[i];
+        rk[5] = rk[1] ^ rk[4];
+        rk[6] = rk[2] ^ rk[5];
+        rk[7] = rk[3] ^ rk[6];
+        rk += 4;
+    }
+
+    compress_round_keys((uint64_t*) rks, words, AES128_ROUNDS);
+    wipe(words, sizeof(words));
+}
+
+void aes128_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aes_encrypt_blocks(dst, src, 1, rks, AES128_ROUNDS);
+}
+
+void aes128_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, 1, rks, AES128_ROUNDS);
+}
+
+void aes128_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aes_encrypt_blocks(dst, src, nblocks, rks, AES128_ROUNDS);
+}
+
+void aes128_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, nblocks, rks, AES128_ROUNDS);
+}
+
+void aes128_keygen_dec(uint8_t* rks, const uint8_t* mk)
+{
+    aes128_keygen(rks, mk);
+}
+
+void aes128_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, 1, rks, AES128_ROUNDS);
+}
+
+void aes128_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, nblocks, rks, AES128_ROUNDS);
+}
+
+void aes128_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    aes_ctr_blocks(dst, src, nblocks, ctr, rks, AES128_ROUNDS);
+}
+
+/******************************************************************************
+ * AES 192 bit key
+ *****************************************************************************/
+void aes192_keygen(uint8_t* rks, const uint8_t* mk)
+{
+    uint32_t words[4 * (AES192_ROUNDS + 1)];
+    uint32_t* rk = words;
+
+    memcpy(rk, mk, 24);
+
+    for (int i = 0; i < 7; ++i) {
+        rk[6] = rk[0] ^ sub_word(rot32r8(rk[5])) ^ RC[i];
+        rk[7] = rk[1] ^ rk[6];
+        rk[8] = rk[2] ^ rk[7];
+        rk[9] = rk[3] ^ rk[8];
+        rk[10] = rk[4] ^ rk[9];
+        rk[11] = rk[5] ^ rk[10];
+
+        rk += 6;
+    }
+
+    rk[6] = rk[0] ^ sub_word(rot32r8(rk[5])) ^ RC[7];
+    rk[7] = rk[1] ^ rk[6];
+    rk[8] = rk[2] ^ rk[7];
+    rk[9] = rk[3] ^ rk[8];
+
+    compress_round_keys((uint64_t*) rks, words, AES192_ROUNDS);
+    wipe(words, sizeof(words));
+}
+
+void aes192_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aes_encrypt_blocks(dst, src, 1, rks, AES192_ROUNDS);
+}
+
+void aes192_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, 1, rks, AES192_ROUNDS);
+}
+
+void aes192_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aes_encrypt_blocks(dst, src, nblocks, rks, AES192_ROUNDS);
+}
+
+void aes192_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, nblocks, rks, AES192_ROUNDS);
+}
+
+void aes192_keygen_dec(uint8_t* rks, const uint8_t* mk)
+{
+    aes192_keygen(rks, mk);
+}
+
+void aes192_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, 1, rks, AES192_ROUNDS);
+}
+
+void aes192_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, nblocks, rks, AES192_ROUNDS);
+}
+
+void aes192_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    aes_ctr_blocks(dst, src, nblocks, ctr, rks, AES192_ROUNDS);
+}
+
+/******************************************************************************
+ * AES 256 bit key
+ *****************************************************************************/
+void aes256_keygen(uint8_t* rks, const uint8_t* mk)
+{
+    uint32_t words[4 * (AES256_ROUNDS + 1)];
+    uint32_t* rk = words;
+
+    memcpy(rk, mk, 32);
+
+    for (int i = 0; i < 7; ++i) {
+        rk[8] = rk[0] ^ sub_word(rot32r8(rk[7])) ^ RC[i];
+        rk[9] = rk[1] ^ rk[8];
+        rk[10] = rk[2] ^ rk[9];
+        rk[11] = rk[3] ^ rk[10];
+
+        if (i == 6) {
+            break;
+        }
+
+        rk[12] = rk[4] ^ sub_word(rk[11]);
+        rk[13] = rk[5] ^ rk[12];
+        rk[14] = rk[6] ^ rk[13];
+        rk[15] = rk[7] ^ rk[14];
+        
+        rk += 8;
+    }
+
+    compress_round_keys((uint64_t*) rks, words, AES256_ROUNDS);
+    wipe(words, sizeof(words));
+}
+
+void aes256_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aes_encrypt_blocks(dst, src, 1, rks, AES256_ROUNDS);
+}
+
+void aes256_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, 1, rks, AES256_ROUNDS);
+}
+
+void aes256_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aes_encrypt_blocks(dst, src, nblocks, rks, AES256_ROUNDS);
+}
+
+void aes256_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, nblocks, rks, AES256_ROUNDS);
+}
+
+void aes256_keygen_dec(uint8_t* rks, const uint8_t* mk)
+{
+    aes256_keygen(rks, mk);
+}
+
+void aes256_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, 1, rks, AES256_ROUNDS);
+}
+
+void aes256_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aes_decrypt_blocks(dst, src, nblocks, rks, AES256_ROUNDS);
+}
+
+void aes256_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    aes_ctr_blocks(dst, src, nblocks, ctr, rks, AES256_ROUNDS);
+}
@@ -0,0 +1,291 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "aes.dispatch.h"
+#include "../tools/cpu.h"
+
+#include <string.h>
+
+typedef void (*aes_keygen_func)(uint8_t* rks, const uint8_t* mk);
+typedef void (*aes_block_func)(uint8_t* dst, const uint8_t* src, const uint8_t* rks);
+typedef void (*aes_blocks_func)(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+typedef void (*aes_ctr_func)(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+
+typedef struct st_aes_funcs {
+    aes_keygen_func keygen;
+    aes_block_func encrypt;
+    aes_block_func decrypt;
+    aes_blocks_func encrypt_blocks;
+    aes_blocks_func decrypt_blocks;
+    aes_keygen_func keygen_dec;
+    aes_block_func decrypt_eqinv;
+    aes_blocks_func decrypt_blocks_eqinv;
+    aes_ctr_func ctr_blocks;
+} aes_funcs;
+
+typedef struct st_aes_backend {
+    const char* name;
+    int (*supported)(const cpu_features* cpu);
+    aes_funcs aes128;
+    aes_funcs aes192;
+    aes_funcs aes256;
+} aes_backend;
+
+#define DECLARE_AES_FUNCS(ns, bits) \
+    void ns##_aes##bits##_keygen(uint8_t* rks, const uint8_t* mk); \
+    void ns##_aes##bits##_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks); \
+    void ns##_aes##bits##_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks); \
+    void ns##_aes##bits##_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks); \
+    void ns##_aes##bits##_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks); \
+    void ns##_aes##bits##_keygen_dec(uint8_t* rks, const uint8_t* mk); \
+    void ns##_aes##bits##_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks); \
+    void ns##_aes##bits##_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks); \
+    void ns##_aes##bits##_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+
+#define DECLARE_AES_BACKEND(ns) \
+    DECLARE_AES_FUNCS(ns, 128) \
+    DECLARE_AES_FUNCS(ns, 192) \
+    DECLARE_AES_FUNCS(ns, 256)
+
+// the VAES backend shares the key schedule of AES-NI
+#define AES_FUNCS(keyns, ns, bits) { \
+    keyns##_aes##bits##_keygen, \
+    ns##_aes##bits##_encrypt, \
+    ns##_aes##bits##_decrypt, \
+    ns##_aes##bits##_encrypt_blocks, \
+    ns##_aes##bits##_decrypt_blocks, \
+    keyns##_aes##bits##_keygen_dec, \
+    ns##_aes##bits##_decrypt_eqinv, \
+    ns##_aes##bits##_decrypt_blocks_eqinv, \
+    ns##_aes##bits##_ctr_blocks, \
+}
+
+DECLARE_AES_BACKEND(bitslice)
+DECLARE_AES_BACKEND(aesni)
+DECLARE_AES_BACKEND(vaes)
+
+static int bitslice_supported(const cpu_features* cpu)
+{
+    (void) cpu;
+    return 1;
+}
+
+static int aesni_supported(const cpu_features* cpu)
+{
+    return cpu->aesni && cpu->sse2;
+}
+
+static int vaes_supported(const cpu_features* cpu)
+{
+    return cpu->aesni && cpu->vaes && cpu->avx512f;
+}
+
+// ordered from the fastest
+static const aes_backend backends[] = {
+    {"vaes", vaes_supported, AES_FUNCS(aesni, vaes, 128), AES_FUNCS(aesni, vaes, 192), AES_FUNCS(aesni, vaes, 256)},
+    {"aesni", aesni_supported, AES_FUNCS(aesni, aesni, 128), AES_FUNCS(aesni, aesni, 192), AES_FUNCS(aesni, aesni, 256)},
+    {"bitslice", bitslice_supported, AES_FUNCS(bitslice, bitslice, 128), AES_FUNCS(bitslice, bitslice, 192), AES_FUNCS(bitslice, bitslice, 256)},
+};
+
+static const size_t NUM_BACKENDS = sizeof(backends) / sizeof(backends[0]);
+
+static const aes_backend* backend = &backends[sizeof(backends) / sizeof(backends[0]) - 1];
+
+static void __attribute__ ((constructor)) aes_dispatch_init(void)
+{
+    const cpu_features* cpu = cpu_get_features();
+
+    for (size_t i = 0; i < NUM_BACKENDS; ++i) {
+        if (backends[i].supported(cpu)) {
+            backend = &backends[i];
+            return;
+        }
+    }
+}
+
+const char* aes_backend_name(void)
+{
+    return backend->name;
+}
+
+int aes_select_backend(const char* name)
+{
+    const cpu_features* cpu = cpu_get_features();
+
+    for (size_t i = 0; i < NUM_BACKENDS; ++i) {
+        if (strcmp(backends[i].name, name) == 0 && backends[i].supported(cpu)) {
+            backend = &backends[i];
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/******************************************************************************
+ * AES 128 bit key
+ *****************************************************************************/
+void aes128_keygen(uint8_t* rks, const uint8_t* mk)
+{
+    backend->aes128.keygen(rks, mk);
+}
+
+void aes128_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    backend->aes128.encrypt(dst, src, rks);
+}
+
+void aes128_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    backend->aes128.decrypt(dst, src, rks);
+}
+
+void aes128_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    backend->aes128.encrypt_blocks(dst, src, nblocks, rks);
+}
+
+void aes128_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    backend->aes128.decrypt_blocks(dst, src, nblocks, rks);
+}
+
+void aes128_keygen_dec(uint8_t* rks, const uint8_t* mk)
+{
+    backend->aes128.keygen_dec(rks, mk);
+}
+
+void aes128_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    backend->aes128.decrypt_eqinv(dst, src, rks);
+}
+
+void aes128_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    backend->aes128.decrypt_blocks_eqinv(dst, src, nblocks, rks);
+}
+
+void aes128_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    backend->aes128.ctr_blocks(dst, src, nblocks, ctr, rks);
+}
+
+/******************************************************************************
+ * AES 192 bit key
+ *****************************************************************************/
+void aes192_keygen(uint8_t* rks, const uint8_t* mk)
+{
+    backend->aes192.keygen(rks, mk);
+}
+
+void aes192_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    backend->aes192.encrypt(dst, src, rks);
+}
+
+void aes192_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    backend->aes192.decrypt(dst, src, rks);
+}
+
+void aes192_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    backend->aes192.encrypt_blocks(dst, src, nblocks, rks);
+}
+
+void aes192_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    backend->aes192.decrypt_blocks(dst, src, nblocks, rks);
+}
+
+void aes192_keygen_dec(uint8_t* rks, const uint8_t* mk)
+{
+    backend->aes192.keygen_dec(rks, mk);
+}
+
+void aes192_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    backend->aes192.decrypt_eqinv(dst, src, rks);
+}
+
+void aes192_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    backend->aes192.decrypt_blocks_eqinv(dst, src, nblocks, rks);
+}
+
+void aes192_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    backend->aes192.ctr_blocks(dst, src, nblocks, ctr, rks);
+}
+
+/******************************************************************************
+ * AES 256 bit key
+ *****************************************************************************/
+void aes256_keygen(uint8_t* rks, const uint8_t* mk)
+{
+    backend->aes256.keygen(rks, mk);
+}
+
+void aes256_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    backend->aes256.encrypt(dst, src, rks);
+}
+
+void aes256_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    backend->aes256.decrypt(dst, src, rks);
+}
+
+void aes256_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    backend->aes256.encrypt_blocks(dst, src, nblocks, rks);
+}
+
+void aes256_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    backend->aes256.decrypt_blocks(dst, src, nblocks, rks);
+}
+
+void aes256_keygen_dec(uint8_t* rks, const uint8_t* mk)
+{
+    backend->aes256.keygen_dec(rks, mk);
+}
+
+void aes256_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    backend->aes256.decrypt_eqinv(dst, src, rks);
+}
+
+void aes256_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    backend->aes256.decrypt_blocks_eqinv(dst, src, nblocks, rks);
+}
+
+void aes256_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    backend->aes256.ctr_blocks(dst, src, nblocks, ctr, rks);
+}
@@ -0,0 +1,51 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CRYPTO_PRIMITIVES_AES_DISPATCH_H__
+#define __CRYPTO_PRIMITIVES_AES_DISPATCH_H__
+
+#include "aes.h"
+
+/**
+ * The aes.h functions are bound at startup to the fastest backend the CPU supports:
+ * VAES (AVX-512), AES-NI and the constant-time bitsliced fallback, in that order.
+ * Round keys are in the format of the selected backend, so they are not portable across processes.
+ */
+const char* aes_backend_name(void);
+
+/**
+ * Forces the backend "vaes", "aesni" or "bitslice".
+ * Returns 0 on success and -1 if it is unknown or not supported by this CPU, keeping the current one.
+ * The bitsliced round keys are compressed and the AES-NI and VAES ones are expanded schedules, so
+ * it must be called before any key is expanded: keys from another backend give wrong output silently.
+ * The backend is a plain global, so it is not thread-safe and must not race with any aes.h call.
+ */
+int aes_select_backend(const char* name);
+
+#endif
@@ -32,6 +32,49 @@
 #define AES192_ROUNDS 12
 #define AES256_ROUNDS 14
 
+/**
+ * The backends linked together behind the runtime dispatch (aes.dispatch.c) are built
+ * with -DAES_NAMESPACE=<prefix>, which renames their public symbols to <prefix>_aes128_encrypt and so on.
+ */
+#ifdef AES_NAMESPACE
+#define AES_NAMESPACE_CONCAT(ns, name) ns##_##name
+#define AES_NAMESPACE_NAME(ns, name) AES_NAMESPACE_CONCAT(ns, name)
+
+#define aes128_keygen AES_NAMESPACE_NAME(AES_NAMESPACE, aes128_keygen)
+#define aes128_encrypt AES_NAMESPACE_NAME(AES_NAMESPACE, aes128_encrypt)
+#define aes128_decrypt AES_NAMESPACE_NAME(AES_NAMESPACE, aes128_decrypt)
+#define aes128_encrypt_blocks AES_NAMESPACE_NAME(AES_NAMESPACE, aes128_encrypt_blocks)
+#define aes128_decrypt_blocks AES_NAMESPACE_NAME(AES_NAMESPACE, aes128_decrypt_blocks)
+#define aes128_keygen_dec AES_NAMESPACE_NAME(AES_NAMESPACE, aes128_keygen_dec)
+#define aes128_decrypt_eqinv AES_NAMESPACE_NAME(AES_NAMESPACE, aes128_decrypt_eqinv)
+#define aes128_decrypt_blocks_eqinv AES_NAMESPACE_NAME(AES_NAMESPACE, aes128_decrypt_blocks_eqinv)
+#define aes128_ctr_blocks AES_NAMESPACE_NAME(AES_NAMESPACE, aes128_ctr_blocks)
+#define aes192_keygen AES_NAMESPACE_NAME(AES_NAMESPACE, aes192_keygen)
+#define aes192_encrypt AES_NAMESPACE_NAME(AES_NAMESPACE, aes192_encrypt)
+#define aes192_decrypt AES_NAMESPACE_NAME(AES_NAMESPACE, aes192_decrypt)
+#define aes192_encrypt_blocks AES_NAMESPACE_NAME(AES_NAMESPACE, aes192_encrypt_blocks)
+#define aes192_decrypt_blocks AES_NAMESPACE_NAME(AES_NAMESPACE, aes192_decrypt_blocks)
+#define aes192_keygen_dec AES_NAMESPACE_NAME(AES_NAMESPACE, aes192_keygen_dec)
+#define aes192_decrypt_eqinv AES_NAMESPACE_NAME(AES_NAMESPACE, aes192_decrypt_eqinv)
+#define aes192_decrypt_blocks_eqinv AES_NAMESPACE_NAME(AES_NAMESPACE, aes192_decrypt_blocks_eqinv)
+#define aes192_ctr_blocks AES_NAMESPACE_NAME(AES_NAMESPACE, aes192_ctr_blocks)
+#define aes256_keygen AES_NAMESPACE_NAME(AES_NAMESPACE, aes256_keygen)
+#define aes256_encrypt AES_NAMESPACE_NAME(AES_NAMESPACE, aes256_encrypt)
+#define aes256_decrypt AES_NAMESPACE_NAME(AES_NAMESPACE, aes256_decrypt)
+#define aes256_encrypt_blocks AES_NAMESPACE_NAME(AES_NAMESPACE, aes256_encrypt_blocks)
+#define aes256_decrypt_blocks AES_NAMESPACE_NAME(AES_NAMESPACE, aes256_decrypt_blocks)
+#define aes256_keygen_dec AES_NAMESPACE_NAME(AES_NAMESPACE, aes256_keygen_dec)
+#define aes256_decrypt_eqinv AES_NAMESPACE_NAME(AES_NAMESPACE, aes256_decrypt_eqinv)
+#define aes256_decrypt_blocks_eqinv AES_NAMESPACE_NAME(AES_NAMESPACE, aes256_decrypt_blocks_eqinv)
+#define aes256_ctr_blocks AES_NAMESPACE_NAME(AES_NAMESPACE, aes256_ctr_blocks)
+#endif
+
+/**
+ * Single-block interface.
+ * The bitsliced backend expands the round keys and runs a full 8-block pass for every call,
+ * so a block costs about as much as eight; serial modes (CBC encryption, CMAC, the CCM MAC)
+ * should go through the multi-block functions or another backend where speed matters.
+ */
 void aes128_keygen(uint8_t* rks, const uint8_t* mk);
 void aes128_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks);
 void aes128_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks);
@@ -44,4 +87,41 @@ void aes256_keygen(uint8_t* rks, const uint8_t* mk);
 void aes256_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks);
 void aes256_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks);
 
+/* multi-block interface, provided by the backends which interleave blocks */
+void aes128_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+void aes128_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+
+void aes192_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+void aes192_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+
+void aes256_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+void aes256_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+
+/**
+ * Decryption with the equivalent inverse cipher (FIPS-197, 5.3.5).
+ * aes*_keygen_dec stores the InvMixColumns'ed round keys in decryption order,
+ * so aes*_decrypt_eqinv and aes*_decrypt_blocks_eqinv take it instead of the encryption round keys.
+ * The bitsliced backend has no such schedule: its keygen_dec is keygen and the eqinv functions are the plain ones.
+ */
+void aes128_keygen_dec(uint8_t* rks, const uint8_t* mk);
+void aes128_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks);
+void aes128_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+
+void aes192_keygen_dec(uint8_t* rks, const uint8_t* mk);
+void aes192_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks);
+void aes192_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+
+void aes256_keygen_dec(uint8_t* rks, const uint8_t* mk);
+void aes256_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks);
+void aes256_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+
+/**
+ * CTR keystream applied to nblocks whole blocks: dst = src ^ E(ctr), E(ctr + 1), ...
+ * ctr is a 128-bit big-endian counter and is advanced by nblocks on return.
+ * AES-NI and VAES build the counter blocks in registers, the bitsliced backend writes them out.
+ */
+void aes128_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+void aes192_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+void aes256_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+
 #endif
\ No newline at end of file
@@ -22,35 +22,17 @@
  * THE SOFTWARE.
  */
 
-#include "aes.h"
+#include "aes.ni.h"
+#include "util.inc"
 #include <wmmintrin.h>
+#include <string.h>
 
 /******************************************************************************
  * AES common functions
  *****************************************************************************/
-static __m128i aes_keyexp1(__m128i k0, __m128i k1){
-    k1 = _mm_shuffle_epi32(k1, _MM_SHUFFLE(3, 3, 3, 3));
-
-    k0 = _mm_xor_si128(k0, _mm_slli_si128(k0, 4));
-    k0 = _mm_xor_si128(k0, _mm_slli_si128(k0, 4));
-    k0 = _mm_xor_si128(k0, _mm_slli_si128(k0, 4));
-
-    return _mm_xor_si128(k0, k1);
-}
-
-static __m128i aes_keyexp2(__m128i k0, __m128i k1){
-    k1 = _mm_shuffle_epi32(k1, _MM_SHUFFLE(2, 2, 2, 2));
-
-    k0 = _mm_xor_si128(k0, _mm_slli_si128(k0, 4));
-    k0 = _mm_xor_si128(k0, _mm_slli_si128(k0, 4));
-    k0 = _mm_xor_si128(k0, _mm_slli_si128(k0, 4));
-
-    return _mm_xor_si128(k0, k1);
-}
-
 static inline void aesni_encrypt(uint8_t *dst, const uint8_t *src, const __m128i *rks, size_t numRounds)
 {
-    int round = 0;
+    size_t round = 0;
     __m128i blk = _mm_loadu_si128((__m128i *) src);
 
     blk = _mm_xor_si128(blk, rks[round]);
@@ -66,7 +48,7 @@ static inline void aesni_encrypt(uint8_t *dst, const uint8_t *src, const __m128i
 
 static inline void aesni_decrypt(uint8_t *dst, const uint8_t *src, const __m128i *rks, size_t numRounds)
 {
-    int round = numRounds;
+    size_t round = numRounds;
     __m128i blk = _mm_loadu_si128((__m128i *) src);
 
     blk = _mm_xor_si128(blk, rks[round]);
@@ -80,99 +62,483 @@ static inline void aesni_decrypt(uint8_t *dst, const uint8_t *src, const __m128i
     _mm_storeu_si128((__m128i *) dst, blk);
 }
 
-/******************************************************************************
- * AES 128 bit key
- *****************************************************************************/
-void aes128_keygen(uint8_t* rk, const uint8_t* mk)
+static inline void aesni_decrypt_eqinv(uint8_t *dst, const uint8_t *src, const __m128i *drks, size_t numRounds)
 {
-    __m128i* rks = (__m128i*) rk;
+    size_t round = 0;
+    __m128i blk = _mm_loadu_si128((__m128i *) src);
+
+    blk = _mm_xor_si128(blk, drks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        blk = _mm_aesdec_si128(blk, drks[round]);
+    }
 
-    rks[0]  = _mm_loadu_si128((const __m128i*) mk);
-    rks[1]  = aes_keyexp1(rks[0], _mm_aeskeygenassist_si128(rks[0], 0x01));
-    rks[2]  = aes_keyexp1(rks[1], _mm_aeskeygenassist_si128(rks[1], 0x02));
-    rks[3]  = aes_keyexp1(rks[2], _mm_aeskeygenassist_si128(rks[2], 0x04));
-    rks[4]  = aes_keyexp1(rks[3], _mm_aeskeygenassist_si128(rks[3], 0x08));
-    rks[5]  = aes_keyexp1(rks[4], _mm_aeskeygenassist_si128(rks[4], 0x10));
-    rks[6]  = aes_keyexp1(rks[5], _mm_aeskeygenassist_si128(rks[5], 0x20));
-    rks[7]  = aes_keyexp1(rks[6], _mm_aeskeygenassist_si128(rks[6], 0x40));
-    rks[8]  = aes_keyexp1(rks[7], _mm_aeskeygenassist_si128(rks[7], 0x80));
-    rks[9]  = aes_keyexp1(rks[8], _mm_aeskeygenassist_si128(rks[8], 0x1b));
-    rks[10]  = aes_keyexp1(rks[9], _mm_aeskeygenassist_si128(rks[9], 0x36));
+    blk = _mm_aesdeclast_si128(blk, drks[round]);
+
+    _mm_storeu_si128((__m128i *) dst, blk);
 }
 
-void aes128_encrypt(uint8_t *dst, const uint8_t *src, const uint8_t *rks)
+static inline void aesni_encrypt_2blk(uint8_t *dst, const uint8_t *src, const __m128i *rks, size_t numRounds)
 {
-    aesni_encrypt(dst, src, (__m128i*) rks, AES128_ROUNDS);
+    size_t round = 0;
+    __m128i b0 = _mm_loadu_si128((__m128i *) src);
+    __m128i b1 = _mm_loadu_si128((__m128i *) src + 1);
+
+    b0 = _mm_xor_si128(b0, rks[round]);
+    b1 = _mm_xor_si128(b1, rks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm_aesenc_si128(b0, rks[round]);
+        b1 = _mm_aesenc_si128(b1, rks[round]);
+    }
+
+    b0 = _mm_aesenclast_si128(b0, rks[round]);
+    b1 = _mm_aesenclast_si128(b1, rks[round]);
+
+    _mm_storeu_si128((__m128i *) dst, b0);
+    _mm_storeu_si128((__m128i *) dst + 1, b1);
 }
 
-void aes128_decrypt(uint8_t *dst, const uint8_t *src, const uint8_t *rks)
+static inline void aesni_encrypt_4blk(uint8_t *dst, const uint8_t *src, const __m128i *rks, size_t numRounds)
 {
-    aesni_decrypt(dst, src, (__m128i*) rks, AES128_ROUNDS);
+    size_t round = 0;
+    __m128i b0 = _mm_loadu_si128((__m128i *) src);
+    __m128i b1 = _mm_loadu_si128((__m128i *) src + 1);
+    __m128i b2 = _mm_loadu_si128((__m128i *) src + 2);
+    __m128i b3 = _mm_loadu_si128((__m128i *) src + 3);
+
+    b0 = _mm_xor_si128(b0, rks[round]);
+    b1 = _mm_xor_si128(b1, rks[round]);
+    b2 = _mm_xor_si128(b2, rks[round]);
+    b3 = _mm_xor_si128(b3, rks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm_aesenc_si128(b0, rks[round]);
+        b1 = _mm_aesenc_si128(b1, rks[round]);
+        b2 = _mm_aesenc_si128(b2, rks[round]);
+        b3 = _mm_aesenc_si128(b3, rks[round]);
+    }
+
+    b0 = _mm_aesenclast_si128(b0, rks[round]);
+    b1 = _mm_aesenclast_si128(b1, rks[round]);
+    b2 = _mm_aesenclast_si128(b2, rks[round]);
+    b3 = _mm_aesenclast_si128(b3, rks[round]);
+
+    _mm_storeu_si128((__m128i *) dst, b0);
+    _mm_storeu_si128((__m128i *) dst + 1, b1);
+    _mm_storeu_si128((__m128i *) dst + 2, b2);
+    _mm_storeu_si128((__m128i *) dst + 3, b3);
+}
+
+static inline void aesni_encrypt_8blk(uint8_t *dst, const uint8_t *src, const __m128i *rks, size_t numRounds)
+{
+    size_t round = 0;
+    __m128i b0 = _mm_loadu_si128((__m128i *) src);
+    __m128i b1 = _mm_loadu_si128((__m128i *) src + 1);
+    __m128i b2 = _mm_loadu_si128((__m128i *) src + 2);
+    __m128i b3 = _mm_loadu_si128((__m128i *) src + 3);
+    __m128i b4 = _mm_loadu_si128((__m128i *) src + 4);
+    __m128i b5 = _mm_loadu_si128((__m128i *) src + 5);
+    __m128i b6 = _mm_loadu_si128((__m128i *) src + 6);
+    __m128i b7 = _mm_loadu_si128((__m128i *) src + 7);
+
+    b0 = _mm_xor_si128(b0, rks[round]);
+    b1 = _mm_xor_si128(b1, rks[round]);
+    b2 = _mm_xor_si128(b2, rks[round]);
+    b3 = _mm_xor_si128(b3, rks[round]);
+    b4 = _mm_xor_si128(b4, rks[round]);
+    b5 = _mm_xor_si128(b5, rks[round]);
+    b6 = _mm_xor_si128(b6, rks[round]);
+    b7 = _mm_xor_si128(b7, rks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm_aesenc_si128(b0, rks[round]);
+        b1 = _mm_aesenc_si128(b1, rks[round]);
+        b2 = _mm_aesenc_si128(b2, rks[round]);
+        b3 = _mm_aesenc_si128(b3, rks[round]);
+        b4 = _mm_aesenc_si128(b4, rks[round]);
+        b5 = _mm_aesenc_si128(b5, rks[round]);
+        b6 = _mm_aesenc_si128(b6, rks[round]);
+        b7 = _mm_aesenc_si128(b7, rks[round]);
+    }
+
+    b0 = _mm_aesenclast_si128(b0, rks[round]);
+    b1 = _mm_aesenclast_si128(b1, rks[round]);
+    b2 = _mm_aesenclast_si128(b2, rks[round]);
+    b3 = _mm_aesenclast_si128(b3, rks[round]);
+    b4 = _mm_aesenclast_si128(b4, rks[round]);
+    b5 = _mm_aesenclast_si128(b5, rks[round]);
+    b6 = _mm_aesenclast_si128(b6, rks[round]);
+    b7 = _mm_aesenclast_si128(b7, rks[round]);
+
+    _mm_storeu_si128((__m128i *) dst, b0);
+    _mm_storeu_si128((__m128i *) dst + 1, b1);
+    _mm_storeu_si128((__m128i *) dst + 2, b2);
+    _mm_storeu_si128((__m128i *) dst + 3, b3);
+    _mm_storeu_si128((__m128i *) dst + 4, b4);
+    _mm_storeu_si128((__m128i *) dst + 5, b5);
+    _mm_storeu_si128((__m128i *) dst + 6, b6);
+    _mm_storeu_si128((__m128i *) dst + 7, b7);
+}
+
+static inline void aesni_decrypt_eqinv_4blk(uint8_t *dst, const uint8_t *src, const __m128i *drks, size_t numRounds)
+{
+    size_t round = 0;
+    __m128i b0 = _mm_loadu_si128((__m128i *) src);
+    __m128i b1 = _mm_loadu_si128((__m128i *) src + 1);
+    __m128i b2 = _mm_loadu_si128((__m128i *) src + 2);
+    __m128i b3 = _mm_loadu_si128((__m128i *) src + 3);
+
+    b0 = _mm_xor_si128(b0, drks[round]);
+    b1 = _mm_xor_si128(b1, drks[round]);
+    b2 = _mm_xor_si128(b2, drks[round]);
+    b3 = _mm_xor_si128(b3, drks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm_aesdec_si128(b0, drks[round]);
+        b1 = _mm_aesdec_si128(b1, drks[round]);
+        b2 = _mm_aesdec_si128(b2, drks[round]);
+        b3 = _mm_aesdec_si128(b3, drks[round]);
+    }
+
+    b0 = _mm_aesdeclast_si128(b0, drks[round]);
+    b1 = _mm_aesdeclast_si128(b1, drks[round]);
+    b2 = _mm_aesdeclast_si128(b2, drks[round]);
+    b3 = _mm_aesdeclast_si128(b3, drks[round]);
+
+    _mm_storeu_si128((__m128i *) dst, b0);
+    _mm_storeu_si128((__m128i *) dst + 1, b1);
+    _mm_storeu_si128((__m128i *) dst + 2, b2);
+    _mm_storeu_si128((__m128i *) dst + 3, b3);
+}
+
+static inline void aesni_decrypt_eqinv_8blk(uint8_t *dst, const uint8_t *src, const __m128i *drks, size_t numRounds)
+{
+    size_t round = 0;
+    __m128i b0 = _mm_loadu_si128((__m128i *) src);
+    __m128i b1 = _mm_loadu_si128((__m128i *) src + 1);
+    __m128i b2 = _mm_loadu_si128((__m128i *) src + 2);
+    __m128i b3 = _mm_loadu_si128((__m128i *) src + 3);
+    __m128i b4 = _mm_loadu_si128((__m128i *) src + 4);
+    __m128i b5 = _mm_loadu_si128((__m128i *) src + 5);
+    __m128i b6 = _mm_loadu_si128((__m128i *) src + 6);
+    __m128i b7 = _mm_loadu_si128((__m128i *) src + 7);
+
+    b0 = _mm_xor_si128(b0, drks[round]);
+    b1 = _mm_xor_si128(b1, drks[round]);
+    b2 = _mm_xor_si128(b2, drks[round]);
+    b3 = _mm_xor_si128(b3, drks[round]);
+    b4 = _mm_xor_si128(b4, drks[round]);
+    b5 = _mm_xor_si128(b5, drks[round]);
+    b6 = _mm_xor_si128(b6, drks[round]);
+    b7 = _mm_xor_si128(b7, drks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm_aesdec_si128(b0, drks[round]);
+        b1 = _mm_aesdec_si128(b1, drks[round]);
+        b2 = _mm_aesdec_si128(b2, drks[round]);
+        b3 = _mm_aesdec_si128(b3, drks[round]);
+        b4 = _mm_aesdec_si128(b4, drks[round]);
+        b5 = _mm_aesdec_si128(b5, drks[round]);
+        b6 = _mm_aesdec_si128(b6, drks[round]);
+        b7 = _mm_aesdec_si128(b7, drks[round]);
+    }
+
+    b0 = _mm_aesdeclast_si128(b0, drks[round]);
+    b1 = _mm_aesdeclast_si128(b1, drks[round]);
+    b2 = _mm_aesdeclast_si128(b2, drks[round]);
+    b3 = _mm_aesdeclast_si128(b3, drks[round]);
+    b4 = _mm_aesdeclast_si128(b4, drks[round]);
+    b5 = _mm_aesdeclast_si128(b5, drks[round]);
+    b6 = _mm_aesdeclast_si128(b6, drks[round]);
+    b7 = _mm_aesdeclast_si128(b7, drks[round]);
+
+    _mm_storeu_si128((__m128i *) dst, b0);
+    _mm_storeu_si128((__m128i *) dst + 1, b1);
+    _mm_storeu_si128((__m128i *) dst + 2, b2);
+    _mm_storeu_si128((__m128i *) dst + 3, b3);
+    _mm_storeu_si128((__m128i *) dst + 4, b4);
+    _mm_storeu_si128((__m128i *) dst + 5, b5);
+    _mm_storeu_si128((__m128i *) dst + 6, b6);
+    _mm_storeu_si128((__m128i *) dst + 7, b7);
+}
+
+/* 8 blocks at a time while possible, then 4, then 2, then one */
+static inline void aesni_encrypt_blocks(uint8_t *dst, const uint8_t *src, size_t nblocks, const __m128i *rks, size_t numRounds)
+{
+    while (nblocks >= 8) {
+        aesni_encrypt_8blk(dst, src, rks, numRounds);
+        src += 8 * 16;
+        dst += 8 * 16;
+        nblocks -= 8;
+    }
+
+    if (nblocks >= 4) {
+        aesni_encrypt_4blk(dst, src, rks, numRounds);
+        src += 4 * 16;
+        dst += 4 * 16;
+        nblocks -= 4;
+    }
+
+    if (nblocks >= 2) {
+        aesni_encrypt_2blk(dst, src, rks, numRounds);
+        src += 2 * 16;
+        dst += 2 * 16;
+        nblocks -= 2;
+    }
+
+    while (nblocks > 0) {
+        aesni_encrypt(dst, src, rks, numRounds);
+        src += 16;
+        dst += 16;
+        nblocks -= 1;
+    }
+}
+
+static inline void aesni_decrypt_blocks_eqinv(uint8_t *dst, const uint8_t *src, size_t nblocks, const __m128i *drks, size_t numRounds)
+{
+    while (nblocks >= 8) {
+        aesni_decrypt_eqinv_8blk(dst, src, drks, numRounds);
+        src += 8 * 16;
+        dst += 8 * 16;
+        nblocks -= 8;
+    }
+
+    if (nblocks >= 4) {
+        aesni_decrypt_eqinv_4blk(dst, src, drks, numRounds);
+        src += 4 * 16;
+        dst += 4 * 16;
+        nblocks -= 4;
+    }
+
+    while (nblocks > 0) {
+        aesni_decrypt_eqinv(dst, src, drks, numRounds);
+        src += 16;
+        dst += 16;
+        nblocks -= 1;
+    }
+}
+
+/* expands the decryption schedule once per call so that no block pays for AESIMC */
+static inline void aesni_decrypt_blocks(uint8_t *dst, const uint8_t *src, size_t nblocks, const __m128i *rks, size_t numRounds)
+{
+    __m128i drks[AES256_ROUNDS + 1];
+
+    aesni_keygen_dec((uint8_t*) drks, (const uint8_t*) rks, numRounds);
+    aesni_decrypt_blocks_eqinv(dst, src, nblocks, drks, numRounds);
+    wipe(drks, sizeof(drks));
+}
+
+/* the counter is a 128-bit big-endian integer, carried as two native words while iterating */
+static inline __m128i counter_block(uint64_t hi, uint64_t lo, uint64_t inc)
+{
+    uint64_t l = lo + inc;
+    uint64_t h = hi + (l < lo);
+
+    return _mm_set_epi64x(__builtin_bswap64(l), __builtin_bswap64(h));
+}
+
+static inline void aesni_ctr_8blk(uint8_t *dst, const uint8_t *src, uint64_t hi, uint64_t lo, const __m128i *rks, size_t numRounds)
+{
+    size_t round = 0;
+    __m128i b0, b1, b2, b3, b4, b5, b6, b7;
+
+    if ((lo & 0xff) <= 0xff - 7) {
+        // no carry out of the last byte, so the counters only differ there
+        b0 = counter_block(hi, lo, 0);
+        b1 = _mm_add_epi32(b0, _mm_set_epi32(1 << 24, 0, 0, 0));
+        b2 = _mm_add_epi32(b0, _mm_set_epi32(2 << 24, 0, 0, 0));
+        b3 = _mm_add_epi32(b0, _mm_set_epi32(3 << 24, 0, 0, 0));
+        b4 = _mm_add_epi32(b0, _mm_set_epi32(4 << 24, 0, 0, 0));
+        b5 = _mm_add_epi32(b0, _mm_set_epi32(5 << 24, 0, 0, 0));
+        b6 = _mm_add_epi32(b0, _mm_set_epi32(6 << 24, 0, 0, 0));
+        b7 = _mm_add_epi32(b0, _mm_set_epi32(7 << 24, 0, 0, 0));
+    } else {
+        b0 = counter_block(hi, lo, 0);
+        b1 = counter_block(hi, lo, 1);
+        b2 = counter_block(hi, lo, 2);
+        b3 = counter_block(hi, lo, 3);
+        b4 = counter_block(hi, lo, 4);
+        b5 = counter_block(hi, lo, 5);
+        b6 = counter_block(hi, lo, 6);
+        b7 = counter_block(hi, lo, 7);
+    }
+
+    b0 = _mm_xor_si128(b0, rks[round]);
+    b1 = _mm_xor_si128(b1, rks[round]);
+    b2 = _mm_xor_si128(b2, rks[round]);
+    b3 = _mm_xor_si128(b3, rks[round]);
+    b4 = _mm_xor_si128(b4, rks[round]);
+    b5 = _mm_xor_si128(b5, rks[round]);
+    b6 = _mm_xor_si128(b6, rks[round]);
+    b7 = _mm_xor_si128(b7, rks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm_aesenc_si128(b0, rks[round]);
+        b1 = _mm_aesenc_si128(b1, rks[round]);
+        b2 = _mm_aesenc_si128(b2, rks[round]);
+        b3 = _mm_aesenc_si128(b3, rks[round]);
+        b4 = _mm_aesenc_si128(b4, rks[round]);
+        b5 = _mm_aesenc_si128(b5, rks[round]);
+        b6 = _mm_aesenc_si128(b6, rks[round]);
+        b7 = _mm_aesenc_si128(b7, rks[round]);
+    }
+
+    b0 = _mm_aesenclast_si128(b0, rks[round]);
+    b1 = _mm_aesenclast_si128(b1, rks[round]);
+    b2 = _mm_aesenclast_si128(b2, rks[round]);
+    b3 = _mm_aesenclast_si128(b3, rks[round]);
+    b4 = _mm_aesenclast_si128(b4, rks[round]);
+    b5 = _mm_aesenclast_si128(b5, rks[round]);
+    b6 = _mm_aesenclast_si128(b6, rks[round]);
+    b7 = _mm_aesenclast_si128(b7, rks[round]);
+
+    _mm_storeu_si128((__m128i *) dst, _mm_xor_si128(b0, _mm_loadu_si128((__m128i *) src)));
+    _mm_storeu_si128((__m128i *) dst + 1, _mm_xor_si128(b1, _mm_loadu_si128((__m128i *) src + 1)));
+    _mm_storeu_si128((__m128i *) dst + 2, _mm_xor_si128(b2, _mm_loadu_si128((__m128i *) src + 2)));
+    _mm_storeu_si128((__m128i *) dst + 3, _mm_xor_si128(b3, _mm_loadu_si128((__m128i *) src + 3)));
+    _mm_storeu_si128((__m128i *) dst + 4, _mm_xor_si128(b4, _mm_loadu_si128((__m128i *) src + 4)));
+    _mm_storeu_si128((__m128i *) dst + 5, _mm_xor_si128(b5, _mm_loadu_si128((__m128i *) src + 5)));
+    _mm_storeu_si128((__m128i *) dst + 6, _mm_xor_si128(b6, _mm_loadu_si128((__m128i *) src + 6)));
+    _mm_storeu_si128((__m128i *) dst + 7, _mm_xor_si128(b7, _mm_loadu_si128((__m128i *) src + 7)));
+}
+
+static inline void aesni_ctr_blocks(uint8_t *dst, const uint8_t *src, size_t nblocks, uint8_t *ctr, const __m128i *rks, size_t numRounds)
+{
+    __m128i ks[8];
+    uint64_t hi, lo;
+
+    memcpy(&hi, ctr, 8);
+    memcpy(&lo, ctr + 8, 8);
+    hi = __builtin_bswap64(hi);
+    lo = __builtin_bswap64(lo);
+
+    while (nblocks >= 8) {
+        aesni_ctr_8blk(dst, src, hi, lo, rks, numRounds);
+        lo += 8;
+        hi += (lo < 8);
+        src += 8 * 16;
+        dst += 8 * 16;
+        nblocks -= 8;
+    }
+
+    if (nblocks > 0) {
+        for (size_t i = 0; i < nblocks; ++i) {
+            ks[i] = counter_block(hi, lo, i);
+        }
+        aesni_encrypt_blocks((uint8_t*) ks, (uint8_t*) ks, nblocks, rks, numRounds);
+
+        for (size_t i = 0; i < nblocks; ++i) {
+            _mm_storeu_si128((__m128i *) dst + i, _mm_xor_si128(ks[i], _mm_loadu_si128((__m128i *) src + i)));
+        }
+        lo += nblocks;
+        hi += (lo < nblocks);
+    }
+
+    hi = __builtin_bswap64(hi);
+    lo = __builtin_bswap64(lo);
+    memcpy(ctr, &hi, 8);
+    memcpy(ctr + 8, &lo, 8);
+}
+
+/* one block for each of the AES_LANES lanes, every lane with its own round keys */
+static inline void aesni_encrypt_lanes(uint8_t *dst, const uint8_t *src, const uint8_t * const *rks, size_t numRounds)
+{
+    const __m128i *k0 = (const __m128i *) rks[0];
+    const __m128i *k1 = (const __m128i *) rks[1];
+    const __m128i *k2 = (const __m128i *) rks[2];
+    const __m128i *k3 = (const __m128i *) rks[3];
+    const __m128i *k4 = (const __m128i *) rks[4];
+    const __m128i *k5 = (const __m128i *) rks[5];
+    const __m128i *k6 = (const __m128i *) rks[6];
+    const __m128i *k7 = (const __m128i *) rks[7];
+    size_t round = 0;
+
+    __m128i b0 = _mm_xor_si128(_mm_loadu_si128((__m128i *) src), _mm_loadu_si128(k0));
+    __m128i b1 = _mm_xor_si128(_mm_loadu_si128((__m128i *) src + 1), _mm_loadu_si128(k1));
+    __m128i b2 = _mm_xor_si128(_mm_loadu_si128((__m128i *) src + 2), _mm_loadu_si128(k2));
+    __m128i b3 = _mm_xor_si128(_mm_loadu_si128((__m128i *) src + 3), _mm_loadu_si128(k3));
+    __m128i b4 = _mm_xor_si128(_mm_loadu_si128((__m128i *) src + 4), _mm_loadu_si128(k4));
+    __m128i b5 = _mm_xor_si128(_mm_loadu_si128((__m128i *) src + 5), _mm_loadu_si128(k5));
+    __m128i b6 = _mm_xor_si128(_mm_loadu_si128((__m128i *) src + 6), _mm_loadu_si128(k6));
+    __m128i b7 = _mm_xor_si128(_mm_loadu_si128((__m128i *) src + 7), _mm_loadu_si128(k7));
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm_aesenc_si128(b0, _mm_loadu_si128(k0 + round));
+        b1 = _mm_aesenc_si128(b1, _mm_loadu_si128(k1 + round));
+        b2 = _mm_aesenc_si128(b2, _mm_loadu_si128(k2 + round));
+        b3 = _mm_aesenc_si128(b3, _mm_loadu_si128(k3 + round));
+        b4 = _mm_aesenc_si128(b4, _mm_loadu_si128(k4 + round));
+        b5 = _mm_aesenc_si128(b5, _mm_loadu_si128(k5 + round));
+        b6 = _mm_aesenc_si128(b6, _mm_loadu_si128(k6 + round));
+        b7 = _mm_aesenc_si128(b7, _mm_loadu_si128(k7 + round));
+    }
+
+    b0 = _mm_aesenclast_si128(b0, _mm_loadu_si128(k0 + round));
+    b1 = _mm_aesenclast_si128(b1, _mm_loadu_si128(k1 + round));
+    b2 = _mm_aesenclast_si128(b2, _mm_loadu_si128(k2 + round));
+    b3 = _mm_aesenclast_si128(b3, _mm_loadu_si128(k3 + round));
+    b4 = _mm_aesenclast_si128(b4, _mm_loadu_si128(k4 + round));
+    b5 = _mm_aesenclast_si128(b5, _mm_loadu_si128(k5 + round));
+    b6 = _mm_aesenclast_si128(b6, _mm_loadu_si128(k6 + round));
+    b7 = _mm_aesenclast_si128(b7, _mm_loadu_si128(k7 + round));
+
+    _mm_storeu_si128((__m128i *) dst, b0);
+    _mm_storeu_si128((__m128i *) dst + 1, b1);
+    _mm_storeu_si128((__m128i *) dst + 2, b2);
+    _mm_storeu_si128((__m128i *) dst + 3, b3);
+    _mm_storeu_si128((__m128i *) dst + 4, b4);
+    _mm_storeu_si128((__m128i *) dst + 5, b5);
+    _mm_storeu_si128((__m128i *) dst + 6, b6);
+    _mm_storeu_si128((__m128i *) dst + 7, b7);
 }
 
 /******************************************************************************
- * AES 192 bit key
+ * AES 128 bit key
  *****************************************************************************/
-static void aes192_keyexp(__m128i* pk1, __m128i* pk2, __m128i k2_rcon, uint32_t* out)
-{
-    __m128i k1 = *pk1;
-    __m128i k2 = *pk2;
-    k2_rcon = _mm_shuffle_epi32(k2_rcon, _MM_SHUFFLE(1, 1, 1, 1));
-    k1 = _mm_xor_si128(k1, _mm_slli_si128(k1, 4));
-    k1 = _mm_xor_si128(k1, _mm_slli_si128(k1, 4));
-    k1 = _mm_xor_si128(k1, _mm_slli_si128(k1, 4));
-    k1 = _mm_xor_si128(k1, k2_rcon);
-    
-    *pk1 = k1;
-    _mm_storeu_si128((__m128i*)out, k1);
-    
-    k2 = _mm_xor_si128(k2, _mm_slli_si128(k2, 4));
-    k2 = _mm_xor_si128(k2, _mm_shuffle_epi32(k1, _MM_SHUFFLE(3, 3, 3, 3)));
+void aes128_encrypt(uint8_t *dst, const uint8_t *src, const uint8_t *rks)
+{
+    aesni_encrypt(dst, src, (__m128i*) rks, AES128_ROUNDS);
+}
 
-    *pk2 = k2;
-    out[4] = _mm_cvtsi128_si32(k2);
-    out[5] = _mm_cvtsi128_si32(_mm_srli_si128(k2, 4));
+void aes128_decrypt(uint8_t *dst, const uint8_t *src, const uint8_t *rks)
+{
+    aesni_decrypt(dst, src, (__m128i*) rks, AES128_ROUNDS);
 }
 
-static void aes192_keyexp_final(__m128i* pk1, __m128i* pk2, __m128i k2_rcon, uint32_t* out)
+void aes128_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
 {
-    __m128i k1 = *pk1;
-    __m128i k2 = *pk2;
-    k2_rcon = _mm_shuffle_epi32(k2_rcon, _MM_SHUFFLE(1, 1, 1, 1));
-    
-    k1 = _mm_xor_si128(k1, _mm_slli_si128(k1, 4));
-    k1 = _mm_xor_si128(k1, _mm_slli_si128(k1, 4));
-    k1 = _mm_xor_si128(k1, _mm_slli_si128(k1, 4));
-    k1 = _mm_xor_si128(k1, k2_rcon);
-    
-    *pk1 = k1;
-    _mm_storeu_si128((__m128i*)out, k1);
+    aesni_encrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES128_ROUNDS);
 }
 
-void aes192_keygen(uint8_t* rk, const uint8_t* mk)
+void aes128_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
 {
-    __m128i k1, k2;
-    uint32_t* rks = (uint32_t*) rk;
-    int i = 0;
+    aesni_decrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES128_ROUNDS);
+}
 
-    for (i = 0; i < 24; ++i) {
-        rk[i] = mk[i];
-    }
+void aes128_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_decrypt_eqinv(dst, src, (__m128i*) rks, AES128_ROUNDS);
+}
 
-    k1 = _mm_loadu_si128((const __m128i*) mk);
-    k2 = _mm_loadu_si128((const __m128i*) (mk + 16));
+void aes128_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aesni_decrypt_blocks_eqinv(dst, src, nblocks, (__m128i*) rks, AES128_ROUNDS);
+}
 
-    aes192_keyexp(&k1, &k2, _mm_aeskeygenassist_si128(k2, 0x01), rks += 6);
-    aes192_keyexp(&k1, &k2, _mm_aeskeygenassist_si128(k2, 0x02), rks += 6);
-    aes192_keyexp(&k1, &k2, _mm_aeskeygenassist_si128(k2, 0x04), rks += 6);
-    aes192_keyexp(&k1, &k2, _mm_aeskeygenassist_si128(k2, 0x08), rks += 6);
-    aes192_keyexp(&k1, &k2, _mm_aeskeygenassist_si128(k2, 0x10), rks += 6);
-    aes192_keyexp(&k1, &k2, _mm_aeskeygenassist_si128(k2, 0x20), rks += 6);
-    aes192_keyexp(&k1, &k2, _mm_aeskeygenassist_si128(k2, 0x40), rks += 6);
-    aes192_keyexp_final(&k1, &k2, _mm_aeskeygenassist_si128(k2, 0x80), rks += 6);
+void aes128_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    aesni_ctr_blocks(dst, src, nblocks, ctr, (__m128i*) rks, AES128_ROUNDS);
+}
 
+void aes128_encrypt_lanes(uint8_t* dst, const uint8_t* src, const uint8_t* const* rks)
+{
+    aesni_encrypt_lanes(dst, src, rks, AES128_ROUNDS);
 }
 
+/******************************************************************************
+ * AES 192 bit key
+ *****************************************************************************/
 void aes192_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
 {
     aesni_encrypt(dst, src, (__m128i*) rks, AES192_ROUNDS);
@@ -183,37 +549,39 @@ void aes192_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
     aesni_decrypt(dst, src, (__m128i*) rks, AES192_ROUNDS);
 }
 
-/******************************************************************************
- * AES 256 bit key
- *****************************************************************************/
-void aes256_keygen(uint8_t* rk, const uint8_t* mk)
+void aes192_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
 {
-    __m128i* rks = (__m128i*) rk;
-
-    rks[0] = _mm_loadu_si128((const __m128i*) mk);
-    rks[1] = _mm_loadu_si128((const __m128i*) (mk+16));
-    
-    rks[2] = aes_keyexp1(rks[0], _mm_aeskeygenassist_si128(rks[1], 0x1));
-    rks[3] = aes_keyexp2(rks[1], _mm_aeskeygenassist_si128(rks[2], 0x0));
+    aesni_encrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES192_ROUNDS);
+}
 
-    rks[4] = aes_keyexp1(rks[2], _mm_aeskeygenassist_si128(rks[3], 0x2));
-    rks[5] = aes_keyexp2(rks[3], _mm_aeskeygenassist_si128(rks[4], 0x0));
+void aes192_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aesni_decrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES192_ROUNDS);
+}
 
-    rks[6] = aes_keyexp1(rks[4], _mm_aeskeygenassist_si128(rks[5], 0x4));
-    rks[7] = aes_keyexp2(rks[5], _mm_aeskeygenassist_si128(rks[6], 0x0));
+void aes192_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_decrypt_eqinv(dst, src, (__m128i*) rks, AES192_ROUNDS);
+}
 
-    rks[8] = aes_keyexp1(rks[6], _mm_aeskeygenassist_si128(rks[7], 0x8));
-    rks[9] = aes_keyexp2(rks[7], _mm_aeskeygenassist_si128(rks[8], 0x0));
+void aes192_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aesni_decrypt_blocks_eqinv(dst, src, nblocks, (__m128i*) rks, AES192_ROUNDS);
+}
 
-    rks[10] = aes_keyexp1(rks[8], _mm_aeskeygenassist_si128(rks[9], 0x10));
-    rks[11] = aes_keyexp2(rks[9], _mm_aeskeygenassist_si128(rks[10], 0x0));
+void aes192_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    aesni_ctr_blocks(dst, src, nblocks, ctr, (__m128i*) rks, AES192_ROUNDS);
+}
 
-    rks[12] = aes_keyexp1(rks[10], _mm_aeskeygenassist_si128(rks[11], 0x20));
-    rks[13] = aes_keyexp2(rks[11], _mm_aeskeygenassist_si128(rks[12], 0x0));
-    
-    rks[14] = aes_keyexp1(rks[12], _mm_aeskeygenassist_si128(rks[13], 0x40));
+void aes192_encrypt_lanes(uint8_t* dst, const uint8_t* src, const uint8_t* const* rks)
+{
+    aesni_encrypt_lanes(dst, src, rks, AES192_ROUNDS);
 }
 
+/******************************************************************************
+ * AES 256 bit key
+ *****************************************************************************/
 void aes256_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
 {
     aesni_encrypt(dst, src, (__m128i*) rks, AES256_ROUNDS);
@@ -223,3 +591,33 @@ void aes256_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
 {
     aesni_decrypt(dst, src, (__m128i*) rks, AES256_ROUNDS);
 }
+
+void aes256_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aesni_encrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aesni_decrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_decrypt_eqinv(dst, src, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    aesni_decrypt_blocks_eqinv(dst, src, nblocks, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    aesni_ctr_blocks(dst, src, nblocks, ctr, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_encrypt_lanes(uint8_t* dst, const uint8_t* src, const uint8_t* const* rks)
+{
+    aesni_encrypt_lanes(dst, src, rks, AES256_ROUNDS);
+}
@@ -0,0 +1,52 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2019-2020 Ilwoong Jeong (https://github.com/ilwoong)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __CRYPTO_PRIMITIVES_AES_NI_H__
+#define __CRYPTO_PRIMITIVES_AES_NI_H__
+
+#include "aes.h"
+
+#ifdef AES_NAMESPACE
+#define aes128_encrypt_lanes AES_NAMESPACE_NAME(AES_NAMESPACE, aes128_encrypt_lanes)
+#define aes192_encrypt_lanes AES_NAMESPACE_NAME(AES_NAMESPACE, aes192_encrypt_lanes)
+#define aes256_encrypt_lanes AES_NAMESPACE_NAME(AES_NAMESPACE, aes256_encrypt_lanes)
+#endif
+
+/**
+ * The equivalent inverse cipher schedule of aes*_keygen_dec, derived from encryption round keys of numRounds rounds.
+ * The key schedule is shared by the AES-NI and VAES backends, so this keeps its name under AES_NAMESPACE.
+ */
+void aesni_keygen_dec(uint8_t* drks, const uint8_t* rks, size_t numRounds);
+
+/**
+ * Multi-buffer encryption of one block in each of AES_LANES independent lanes,
+ * where lane i encrypts block i of src with its own round keys rks[i]. Only in the AES-NI backend.
+ */
+#define AES_LANES 8
+
+void aes128_encrypt_lanes(uint8_t* dst, const uint8_t* src, const uint8_t* const* rks);
+void aes192_encrypt_lanes(uint8_t* dst, const uint8_t* src, const uint8_t* const* rks);
+void aes256_encrypt_lanes(uint8_t* dst, const uint8_t* src, const uint8_t* const* rks);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,472 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2019-2020 Ilwoong Jeong (https://github.com/ilwoong)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "aes.ni.h"
+#include "util.inc"
+#include <immintrin.h>
+#include <string.h>
+
+/******************************************************************************
+ * AES common functions
+ *****************************************************************************/
+static inline void aesni_encrypt(uint8_t *dst, const uint8_t *src, const __m128i *rks, size_t numRounds)
+{
+    size_t round = 0;
+    __m128i blk = _mm_loadu_si128((__m128i *) src);
+
+    blk = _mm_xor_si128(blk, rks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        blk = _mm_aesenc_si128(blk, rks[round]);
+    }
+        
+    blk = _mm_aesenclast_si128(blk, rks[round]);
+
+    _mm_storeu_si128((__m128i *) dst, blk);
+}
+
+static inline void aesni_decrypt(uint8_t *dst, const uint8_t *src, const __m128i *rks, size_t numRounds)
+{
+    size_t round = numRounds;
+    __m128i blk = _mm_loadu_si128((__m128i *) src);
+
+    blk = _mm_xor_si128(blk, rks[round]);
+    
+    for (round = numRounds - 1; round > 0; --round) {
+        blk = _mm_aesdec_si128(blk, _mm_aesimc_si128(rks[round]));
+    }
+
+    blk = _mm_aesdeclast_si128(blk, rks[round]);
+
+    _mm_storeu_si128((__m128i *) dst, blk);
+}
+
+static inline void aesni_decrypt_eqinv(uint8_t *dst, const uint8_t *src, const __m128i *drks, size_t numRounds)
+{
+    size_t round = 0;
+    __m128i blk = _mm_loadu_si128((__m128i *) src);
+
+    blk = _mm_xor_si128(blk, drks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        blk = _mm_aesdec_si128(blk, drks[round]);
+    }
+
+    blk = _mm_aesdeclast_si128(blk, drks[round]);
+
+    _mm_storeu_si128((__m128i *) dst, blk);
+}
+
+/******************************************************************************
+ * VAES functions, four blocks per 512-bit register
+ *****************************************************************************/
+static inline void vaes_broadcast_keys(__m512i *wrks, const __m128i *rks, size_t numRounds)
+{
+    for (size_t round = 0; round <= numRounds; ++round) {
+        wrks[round] = _mm512_broadcast_i32x4(rks[round]);
+    }
+}
+
+/* mask covering the first nblocks (at most 4) blocks of a register */
+static inline __mmask8 vaes_mask(size_t nblocks)
+{
+    return (__mmask8) ((1u << (2 * nblocks)) - 1);
+}
+
+static inline __m512i vaes_encrypt_x1(__m512i b0, const __m512i *wrks, size_t numRounds)
+{
+    size_t round = 0;
+
+    b0 = _mm512_xor_si512(b0, wrks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm512_aesenc_epi128(b0, wrks[round]);
+    }
+
+    return _mm512_aesenclast_epi128(b0, wrks[round]);
+}
+
+static inline __m512i vaes_decrypt_x1(__m512i b0, const __m512i *wdrks, size_t numRounds)
+{
+    size_t round = 0;
+
+    b0 = _mm512_xor_si512(b0, wdrks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm512_aesdec_epi128(b0, wdrks[round]);
+    }
+
+    return _mm512_aesdeclast_epi128(b0, wdrks[round]);
+}
+
+static inline void vaes_encrypt_16blk(uint8_t *dst, const uint8_t *src, const __m512i *wrks, size_t numRounds)
+{
+    size_t round = 0;
+    __m512i b0 = _mm512_loadu_si512((__m512i *) src);
+    __m512i b1 = _mm512_loadu_si512((__m512i *) src + 1);
+    __m512i b2 = _mm512_loadu_si512((__m512i *) src + 2);
+    __m512i b3 = _mm512_loadu_si512((__m512i *) src + 3);
+
+    b0 = _mm512_xor_si512(b0, wrks[round]);
+    b1 = _mm512_xor_si512(b1, wrks[round]);
+    b2 = _mm512_xor_si512(b2, wrks[round]);
+    b3 = _mm512_xor_si512(b3, wrks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm512_aesenc_epi128(b0, wrks[round]);
+        b1 = _mm512_aesenc_epi128(b1, wrks[round]);
+        b2 = _mm512_aesenc_epi128(b2, wrks[round]);
+        b3 = _mm512_aesenc_epi128(b3, wrks[round]);
+    }
+
+    b0 = _mm512_aesenclast_epi128(b0, wrks[round]);
+    b1 = _mm512_aesenclast_epi128(b1, wrks[round]);
+    b2 = _mm512_aesenclast_epi128(b2, wrks[round]);
+    b3 = _mm512_aesenclast_epi128(b3, wrks[round]);
+
+    _mm512_storeu_si512((__m512i *) dst, b0);
+    _mm512_storeu_si512((__m512i *) dst + 1, b1);
+    _mm512_storeu_si512((__m512i *) dst + 2, b2);
+    _mm512_storeu_si512((__m512i *) dst + 3, b3);
+}
+
+static inline void vaes_decrypt_16blk(uint8_t *dst, const uint8_t *src, const __m512i *wdrks, size_t numRounds)
+{
+    size_t round = 0;
+    __m512i b0 = _mm512_loadu_si512((__m512i *) src);
+    __m512i b1 = _mm512_loadu_si512((__m512i *) src + 1);
+    __m512i b2 = _mm512_loadu_si512((__m512i *) src + 2);
+    __m512i b3 = _mm512_loadu_si512((__m512i *) src + 3);
+
+    b0 = _mm512_xor_si512(b0, wdrks[round]);
+    b1 = _mm512_xor_si512(b1, wdrks[round]);
+    b2 = _mm512_xor_si512(b2, wdrks[round]);
+    b3 = _mm512_xor_si512(b3, wdrks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm512_aesdec_epi128(b0, wdrks[round]);
+        b1 = _mm512_aesdec_epi128(b1, wdrks[round]);
+        b2 = _mm512_aesdec_epi128(b2, wdrks[round]);
+        b3 = _mm512_aesdec_epi128(b3, wdrks[round]);
+    }
+
+    b0 = _mm512_aesdeclast_epi128(b0, wdrks[round]);
+    b1 = _mm512_aesdeclast_epi128(b1, wdrks[round]);
+    b2 = _mm512_aesdeclast_epi128(b2, wdrks[round]);
+    b3 = _mm512_aesdeclast_epi128(b3, wdrks[round]);
+
+    _mm512_storeu_si512((__m512i *) dst, b0);
+    _mm512_storeu_si512((__m512i *) dst + 1, b1);
+    _mm512_storeu_si512((__m512i *) dst + 2, b2);
+    _mm512_storeu_si512((__m512i *) dst + 3, b3);
+}
+
+/* 16 blocks at a time while possible, then 4, and the last 1 to 3 through a masked register */
+static inline void vaes_encrypt_blocks(uint8_t *dst, const uint8_t *src, size_t nblocks, const __m128i *rks, size_t numRounds)
+{
+    __m512i wrks[AES256_ROUNDS + 1];
+    __m512i blk;
+
+    vaes_broadcast_keys(wrks, rks, numRounds);
+
+    while (nblocks >= 16) {
+        vaes_encrypt_16blk(dst, src, wrks, numRounds);
+        src += 16 * 16;
+        dst += 16 * 16;
+        nblocks -= 16;
+    }
+
+    while (nblocks >= 4) {
+        blk = vaes_encrypt_x1(_mm512_loadu_si512((__m512i *) src), wrks, numRounds);
+        _mm512_storeu_si512((__m512i *) dst, blk);
+        src += 4 * 16;
+        dst += 4 * 16;
+        nblocks -= 4;
+    }
+
+    if (nblocks > 0) {
+        blk = vaes_encrypt_x1(_mm512_maskz_loadu_epi64(vaes_mask(nblocks), src), wrks, numRounds);
+        _mm512_mask_storeu_epi64(dst, vaes_mask(nblocks), blk);
+    }
+
+    wipe(wrks, sizeof(wrks));
+}
+
+static inline void vaes_decrypt_blocks_eqinv(uint8_t *dst, const uint8_t *src, size_t nblocks, const __m128i *drks, size_t numRounds)
+{
+    __m512i wdrks[AES256_ROUNDS + 1];
+    __m512i blk;
+
+    vaes_broadcast_keys(wdrks, drks, numRounds);
+
+    while (nblocks >= 16) {
+        vaes_decrypt_16blk(dst, src, wdrks, numRounds);
+        src += 16 * 16;
+        dst += 16 * 16;
+        nblocks -= 16;
+    }
+
+    while (nblocks >= 4) {
+        blk = vaes_decrypt_x1(_mm512_loadu_si512((__m512i *) src), wdrks, numRounds);
+        _mm512_storeu_si512((__m512i *) dst, blk);
+        src += 4 * 16;
+        dst += 4 * 16;
+        nblocks -= 4;
+    }
+
+    if (nblocks > 0) {
+        blk = vaes_decrypt_x1(_mm512_maskz_loadu_epi64(vaes_mask(nblocks), src), wdrks, numRounds);
+        _mm512_mask_storeu_epi64(dst, vaes_mask(nblocks), blk);
+    }
+
+    wipe(wdrks, sizeof(wdrks));
+}
+
+static inline void vaes_decrypt_blocks(uint8_t *dst, const uint8_t *src, size_t nblocks, const __m128i *rks, size_t numRounds)
+{
+    __m128i drks[AES256_ROUNDS + 1];
+
+    aesni_keygen_dec((uint8_t*) drks, (const uint8_t*) rks, numRounds);
+    vaes_decrypt_blocks_eqinv(dst, src, nblocks, drks, numRounds);
+    wipe(drks, sizeof(drks));
+}
+
+/* the counter is a 128-bit big-endian integer, carried as two native words while iterating */
+static inline __m128i counter_block(uint64_t hi, uint64_t lo, uint64_t inc)
+{
+    uint64_t l = lo + inc;
+    uint64_t h = hi + (l < lo);
+
+    return _mm_set_epi64x(__builtin_bswap64(l), __builtin_bswap64(h));
+}
+
+static inline __m512i counter_blocks_x4(uint64_t hi, uint64_t lo, uint64_t inc)
+{
+    __m512i ctr;
+
+    if ((lo & 0xff) <= 0xff - (inc + 3)) {
+        // no carry out of the last byte, so the counters only differ there
+        ctr = _mm512_broadcast_i32x4(counter_block(hi, lo, inc));
+        return _mm512_add_epi32(ctr, _mm512_set_epi32(3 << 24, 0, 0, 0, 2 << 24, 0, 0, 0, 1 << 24, 0, 0, 0, 0, 0, 0, 0));
+    }
+
+    ctr = _mm512_castsi128_si512(counter_block(hi, lo, inc));
+
+    ctr = _mm512_inserti32x4(ctr, counter_block(hi, lo, inc + 1), 1);
+    ctr = _mm512_inserti32x4(ctr, counter_block(hi, lo, inc + 2), 2);
+    ctr = _mm512_inserti32x4(ctr, counter_block(hi, lo, inc + 3), 3);
+
+    return ctr;
+}
+
+static inline void vaes_ctr_16blk(uint8_t *dst, const uint8_t *src, uint64_t hi, uint64_t lo, const __m512i *wrks, size_t numRounds)
+{
+    size_t round = 0;
+    __m512i b0 = counter_blocks_x4(hi, lo, 0);
+    __m512i b1 = counter_blocks_x4(hi, lo, 4);
+    __m512i b2 = counter_blocks_x4(hi, lo, 8);
+    __m512i b3 = counter_blocks_x4(hi, lo, 12);
+
+    b0 = _mm512_xor_si512(b0, wrks[round]);
+    b1 = _mm512_xor_si512(b1, wrks[round]);
+    b2 = _mm512_xor_si512(b2, wrks[round]);
+    b3 = _mm512_xor_si512(b3, wrks[round]);
+
+    for (round = 1; round < numRounds; ++round) {
+        b0 = _mm512_aesenc_epi128(b0, wrks[round]);
+        b1 = _mm512_aesenc_epi128(b1, wrks[round]);
+        b2 = _mm512_aesenc_epi128(b2, wrks[round]);
+        b3 = _mm512_aesenc_epi128(b3, wrks[round]);
+    }
+
+    b0 = _mm512_aesenclast_epi128(b0, wrks[round]);
+    b1 = _mm512_aesenclast_epi128(b1, wrks[round]);
+    b2 = _mm512_aesenclast_epi128(b2, wrks[round]);
+    b3 = _mm512_aesenclast_epi128(b3, wrks[round]);
+
+    _mm512_storeu_si512((__m512i *) dst, _mm512_xor_si512(b0, _mm512_loadu_si512((__m512i *) src)));
+    _mm512_storeu_si512((__m512i *) dst + 1, _mm512_xor_si512(b1, _mm512_loadu_si512((__m512i *) src + 1)));
+    _mm512_storeu_si512((__m512i *) dst + 2, _mm512_xor_si512(b2, _mm512_loadu_si512((__m512i *) src + 2)));
+    _mm512_storeu_si512((__m512i *) dst + 3, _mm512_xor_si512(b3, _mm512_loadu_si512((__m512i *) src + 3)));
+}
+
+static inline void vaes_ctr_blocks(uint8_t *dst, const uint8_t *src, size_t nblocks, uint8_t *ctr, const __m128i *rks, size_t numRounds)
+{
+    __m512i wrks[AES256_ROUNDS + 1];
+    __m512i blk;
+    __mmask8 mask;
+    uint64_t hi, lo;
+
+    vaes_broadcast_keys(wrks, rks, numRounds);
+
+    memcpy(&hi, ctr, 8);
+    memcpy(&lo, ctr + 8, 8);
+    hi = __builtin_bswap64(hi);
+    lo = __builtin_bswap64(lo);
+
+    while (nblocks >= 16) {
+        vaes_ctr_16blk(dst, src, hi, lo, wrks, numRounds);
+        lo += 16;
+        hi += (lo < 16);
+        src += 16 * 16;
+        dst += 16 * 16;
+        nblocks -= 16;
+    }
+
+    while (nblocks > 0) {
+        size_t count = nblocks < 4 ? nblocks : 4;
+
+        mask = vaes_mask(count);
+        blk = vaes_encrypt_x1(counter_blocks_x4(hi, lo, 0), wrks, numRounds);
+        blk = _mm512_xor_si512(blk, _mm512_maskz_loadu_epi64(mask, src));
+        _mm512_mask_storeu_epi64(dst, mask, blk);
+
+        lo += count;
+        hi += (lo < count);
+        src += count * 16;
+        dst += count * 16;
+        nblocks -= count;
+    }
+
+    hi = __builtin_bswap64(hi);
+    lo = __builtin_bswap64(lo);
+    memcpy(ctr, &hi, 8);
+    memcpy(ctr + 8, &lo, 8);
+
+    wipe(wrks, sizeof(wrks));
+}
+
+/******************************************************************************
+ * AES 128 bit key
+ *****************************************************************************/
+void aes128_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_encrypt(dst, src, (__m128i*) rks, AES128_ROUNDS);
+}
+
+void aes128_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_decrypt(dst, src, (__m128i*) rks, AES128_ROUNDS);
+}
+
+void aes128_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    vaes_encrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES128_ROUNDS);
+}
+
+void aes128_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    vaes_decrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES128_ROUNDS);
+}
+
+void aes128_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_decrypt_eqinv(dst, src, (__m128i*) rks, AES128_ROUNDS);
+}
+
+void aes128_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    vaes_decrypt_blocks_eqinv(dst, src, nblocks, (__m128i*) rks, AES128_ROUNDS);
+}
+
+void aes128_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    vaes_ctr_blocks(dst, src, nblocks, ctr, (__m128i*) rks, AES128_ROUNDS);
+}
+
+/******************************************************************************
+ * AES 192 bit key
+ *****************************************************************************/
+void aes192_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_encrypt(dst, src, (__m128i*) rks, AES192_ROUNDS);
+}
+
+void aes192_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_decrypt(dst, src, (__m128i*) rks, AES192_ROUNDS);
+}
+
+void aes192_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    vaes_encrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES192_ROUNDS);
+}
+
+void aes192_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    vaes_decrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES192_ROUNDS);
+}
+
+void aes192_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_decrypt_eqinv(dst, src, (__m128i*) rks, AES192_ROUNDS);
+}
+
+void aes192_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    vaes_decrypt_blocks_eqinv(dst, src, nblocks, (__m128i*) rks, AES192_ROUNDS);
+}
+
+void aes192_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    vaes_ctr_blocks(dst, src, nblocks, ctr, (__m128i*) rks, AES192_ROUNDS);
+}
+
+/******************************************************************************
+ * AES 256 bit key
+ *****************************************************************************/
+void aes256_encrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_encrypt(dst, src, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_decrypt(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_decrypt(dst, src, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    vaes_encrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    vaes_decrypt_blocks(dst, src, nblocks, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_decrypt_eqinv(uint8_t* dst, const uint8_t* src, const uint8_t* rks)
+{
+    aesni_decrypt_eqinv(dst, src, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_decrypt_blocks_eqinv(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    vaes_decrypt_blocks_eqinv(dst, src, nblocks, (__m128i*) rks, AES256_ROUNDS);
+}
+
+void aes256_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    vaes_ctr_blocks(dst, src, nblocks, ctr, (__m128i*) rks, AES256_ROUNDS);
+}
@@ -28,6 +28,7 @@
 #include "lea.avx2.h"
 
 #include <x86intrin.h>
+#include <string.h>
 
 #include "inline.inc"
 
@@ -59,21 +60,40 @@ static FORCE_INLINE __m256i addKey(__m256i value, uint32_t rk)
     return _mm256_xor_si256(value, _mm256_set1_epi32(rk));
 }
 
-static FORCE_INLINE __m256i load32x8(const uint32_t* in)
+/**
+ * loads 8 contiguous blocks with 4 vector loads and transposes the 4x4 words within each 128-bit lane,
+ * so that x0..x3 hold word 0..3 of the blocks in the order 0, 2, 4, 6, 1, 3, 5, 7.
+ */
+static FORCE_INLINE void load_transpose8(__m256i* x0, __m256i* x1, __m256i* x2, __m256i* x3, const uint8_t* in)
 {
-    return _mm256_setr_epi32(*in, *(in + 4), *(in + 8), *(in + 12), *(in + 16), *(in + 20), *(in + 24), *(in + 28));
+    __m256i v0 = _mm256_loadu_si256((const __m256i*) in);
+    __m256i v1 = _mm256_loadu_si256((const __m256i*) in + 1);
+    __m256i v2 = _mm256_loadu_si256((const __m256i*) in + 2);
+    __m256i v3 = _mm256_loadu_si256((const __m256i*) in + 3);
+
+    __m256i t0 = _mm256_unpacklo_epi32(v0, v1);
+    __m256i t1 = _mm256_unpackhi_epi32(v0, v1);
+    __m256i t2 = _mm256_unpacklo_epi32(v2, v3);
+    __m256i t3 = _mm256_unpackhi_epi32(v2, v3);
+
+    *x0 = _mm256_unpacklo_epi64(t0, t2);
+    *x1 = _mm256_unpackhi_epi64(t0, t2);
+    *x2 = _mm256_unpacklo_epi64(t1, t3);
+    *x3 = _mm256_unpackhi_epi64(t1, t3);
 }
 
-static FORCE_INLINE void unload32x8(uint32_t* out, const __m256i value)
+// the inverse of load_transpose8, the same unpacks put the blocks back in order
+static FORCE_INLINE void store_transpose8(uint8_t* out, __m256i x0, __m256i x1, __m256i x2, __m256i x3)
 {
-    out[ 0] = _mm256_extract_epi32(value, 0);
-    out[ 4] = _mm256_extract_epi32(value, 1);
-    out[ 8] = _mm256_extract_epi32(value, 2);
-    out[12] = _mm256_extract_epi32(value, 3);
-    out[16] = _mm256_extract_epi32(value, 4);
-    out[20] = _mm256_extract_epi32(value, 5);
-    out[24] = _mm256_extract_epi32(value, 6);
-    out[28] = _mm256_extract_epi32(value, 7);
+    __m256i t0 = _mm256_unpacklo_epi32(x0, x1);
+    __m256i t1 = _mm256_unpackhi_epi32(x0, x1);
+    __m256i t2 = _mm256_unpacklo_epi32(x2, x3);
+    __m256i t3 = _mm256_unpackhi_epi32(x2, x3);
+
+    _mm256_storeu_si256((__m256i*) out, _mm256_unpacklo_epi64(t0, t2));
+    _mm256_storeu_si256((__m256i*) out + 1, _mm256_unpackhi_epi64(t0, t2));
+    _mm256_storeu_si256((__m256i*) out + 2, _mm256_unpacklo_epi64(t1, t3));
+    _mm256_storeu_si256((__m256i*) out + 3, _mm256_unpackhi_epi64(t1, t3));
 }
 
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -100,10 +120,9 @@ static FORCE_INLINE void lea_encrypt_8blk(uint8_t* out, const uint8_t* in, const
 {
     const uint32_t* rk = (const uint32_t*) rks;
 
-    __m256i x0 = load32x8((const uint32_t*) in);
-    __m256i x1 = load32x8((const uint32_t*) in + 1);
-    __m256i x2 = load32x8((const uint32_t*) in + 2);
-    __m256i x3 = load32x8((const uint32_t*) in + 3);
+    __m256i x0, x1, x2, x3;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
     
     for (size_t round = 0; round < rounds; round += 4)
     {
@@ -120,24 +139,17 @@ static FORCE_INLINE void lea_encrypt_8blk(uint8_t* out, const uint8_t* in, const
         rk += 6;
     }
 
-    unload32x8((uint32_t*)out    , x0);
-    unload32x8((uint32_t*)out + 1, x1);
-    unload32x8((uint32_t*)out + 2, x2);
-    unload32x8((uint32_t*)out + 3, x3);
+    store_transpose8(out, x0, x1, x2, x3);
 }
 
 static FORCE_INLINE void lea_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
 {
     const uint32_t* rk = (const uint32_t*) rks;
 
-    __m256i x0 = load32x8((const uint32_t*) in);
-    __m256i x1 = load32x8((const uint32_t*) in + 1);
-    __m256i x2 = load32x8((const uint32_t*) in + 2);
-    __m256i x3 = load32x8((const uint32_t*) in + 3);
-    __m256i x4 = load32x8((const uint32_t*) in + 32);
-    __m256i x5 = load32x8((const uint32_t*) in + 33);
-    __m256i x6 = load32x8((const uint32_t*) in + 34);
-    __m256i x7 = load32x8((const uint32_t*) in + 35);
+    __m256i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
+    load_transpose8(&x4, &x5, &x6, &x7, in + 128);
     
     for (size_t round = 0; round < rounds; round += 4)
     {
@@ -158,14 +170,8 @@ static FORCE_INLINE void lea_encrypt_16blk(uint8_t* out, const uint8_t* in, cons
         rk += 6;
     }
 
-    unload32x8((uint32_t*)out     , x0);
-    unload32x8((uint32_t*)out +  1, x1);
-    unload32x8((uint32_t*)out +  2, x2);
-    unload32x8((uint32_t*)out +  3, x3);
-    unload32x8((uint32_t*)out + 32, x4);
-    unload32x8((uint32_t*)out + 33, x5);
-    unload32x8((uint32_t*)out + 34, x6);
-    unload32x8((uint32_t*)out + 35, x7);
+    store_transpose8(out, x0, x1, x2, x3);
+    store_transpose8(out + 128, x4, x5, x6, x7);
 }
 
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -175,10 +181,9 @@ static FORCE_INLINE void lea_decrypt_8blk(uint8_t* out, const uint8_t* in, const
 {
     const uint32_t* rk = (const uint32_t*) rks;
 
-    __m256i x0 = load32x8((const uint32_t*) in);
-    __m256i x1 = load32x8((const uint32_t*) in + 1);
-    __m256i x2 = load32x8((const uint32_t*) in + 2);
-    __m256i x3 = load32x8((const uint32_t*) in + 3);
+    __m256i x0, x1, x2, x3;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
     
     rk += 6 * (rounds - 1);
     for (size_t round = 0; round < rounds; round += 4)
@@ -196,24 +201,17 @@ static FORCE_INLINE void lea_decrypt_8blk(uint8_t* out, const uint8_t* in, const
         rk -= 6;
     }
 
-    unload32x8((uint32_t*)out    , x0);
-    unload32x8((uint32_t*)out + 1, x1);
-    unload32x8((uint32_t*)out + 2, x2);
-    unload32x8((uint32_t*)out + 3, x3);
+    store_transpose8(out, x0, x1, x2, x3);
 }
 
 static FORCE_INLINE void lea_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
 {
     const uint32_t* rk = (const uint32_t*) rks;
 
-    __m256i x0 = load32x8((const uint32_t*) in);
-    __m256i x1 = load32x8((const uint32_t*) in + 1);
-    __m256i x2 = load32x8((const uint32_t*) in + 2);
-    __m256i x3 = load32x8((const uint32_t*) in + 3);
-    __m256i x4 = load32x8((const uint32_t*) in + 32);
-    __m256i x5 = load32x8((const uint32_t*) in + 33);
-    __m256i x6 = load32x8((const uint32_t*) in + 34);
-    __m256i x7 = load32x8((const uint32_t*) in + 35);
+    __m256i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
+    load_transpose8(&x4, &x5, &x6, &x7, in + 128);
     
     rk += 6 * (rounds - 1);
     for (size_t round = 0; round < rounds; round += 4)
@@ -235,14 +233,491 @@ static FORCE_INLINE void lea_decrypt_16blk(uint8_t* out, const uint8_t* in, cons
         rk -= 6;
     }
 
-    unload32x8((uint32_t*)out    , x0);
-    unload32x8((uint32_t*)out + 1, x1);
-    unload32x8((uint32_t*)out + 2, x2);
-    unload32x8((uint32_t*)out + 3, x3);
-    unload32x8((uint32_t*)out + 32, x4);
-    unload32x8((uint32_t*)out + 33, x5);
-    unload32x8((uint32_t*)out + 34, x6);
-    unload32x8((uint32_t*)out + 35, x7);
+    store_transpose8(out, x0, x1, x2, x3);
+    store_transpose8(out + 128, x4, x5, x6, x7);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! multi-buffer encryption, every lane with its own key
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE __m256i addKeyx8(__m256i value, const uint32_t* rk) 
+{
+    return _mm256_xor_si256(value, _mm256_loadu_si256((const __m256i*) rk));
+}
+
+// rkx holds round key word k of lane i at rkx[k * lanes + lane_slot(i)]
+static FORCE_INLINE void enc_round_lanes(__m256i* x0, __m256i* x1, __m256i* x2, __m256i* x3, const uint32_t* rkx, size_t lanes)
+{
+    *x3 = ror32x8(add32x8(addKeyx8(*x2, rkx + 4 * lanes), addKeyx8(*x3, rkx + 5 * lanes)), 3);
+    *x2 = ror32x8(add32x8(addKeyx8(*x1, rkx + 2 * lanes), addKeyx8(*x2, rkx + 3 * lanes)), 5);
+    *x1 = rol32x8(add32x8(addKeyx8(*x0, rkx), addKeyx8(*x1, rkx + lanes)), 9);
+}
+
+static FORCE_INLINE void lea_encrypt_lanes_x8(uint8_t* out, const uint8_t* in, const uint32_t* rkx, size_t rounds)
+{
+    __m256i x0, x1, x2, x3;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_lanes(&x0, &x1, &x2, &x3, rkx, 8);
+        rkx += 6 * 8;
+
+        enc_round_lanes(&x1, &x2, &x3, &x0, rkx, 8);
+        rkx += 6 * 8;
+
+        enc_round_lanes(&x2, &x3, &x0, &x1, rkx, 8);
+        rkx += 6 * 8;
+
+        enc_round_lanes(&x3, &x0, &x1, &x2, rkx, 8);
+        rkx += 6 * 8;
+    }
+
+    store_transpose8(out, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_encrypt_lanes_x16(uint8_t* out, const uint8_t* in, const uint32_t* rkx, size_t rounds)
+{
+    __m256i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
+    load_transpose8(&x4, &x5, &x6, &x7, in + 128);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_lanes(&x0, &x1, &x2, &x3, rkx, 16);
+        enc_round_lanes(&x4, &x5, &x6, &x7, rkx + 8, 16);
+        rkx += 6 * 16;
+
+        enc_round_lanes(&x1, &x2, &x3, &x0, rkx, 16);
+        enc_round_lanes(&x5, &x6, &x7, &x4, rkx + 8, 16);
+        rkx += 6 * 16;
+
+        enc_round_lanes(&x2, &x3, &x0, &x1, rkx, 16);
+        enc_round_lanes(&x6, &x7, &x4, &x5, rkx + 8, 16);
+        rkx += 6 * 16;
+
+        enc_round_lanes(&x3, &x0, &x1, &x2, rkx, 16);
+        enc_round_lanes(&x7, &x4, &x5, &x6, rkx + 8, 16);
+        rkx += 6 * 16;
+    }
+
+    store_transpose8(out, x0, x1, x2, x3);
+    store_transpose8(out + 128, x4, x5, x6, x7);
+}
+
+// position of a lane in its group of 8, following the block order of load_transpose8
+static FORCE_INLINE size_t lane_slot(size_t lane)
+{
+    return (lane & ~(size_t) 7) + (lane & 1) * 4 + ((lane & 7) >> 1);
+}
+
+static FORCE_INLINE void lea_set_lane_key(uint32_t* rkx, size_t lanes, size_t lane, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+    size_t slot = lane_slot(lane);
+
+    for (size_t k = 0; k < 6 * rounds; ++k) {
+        rkx[k * lanes + slot] = rk[k];
+    }
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! CTR mode with the counter blocks built in registers
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// out = in ^ the blocks of x0..x3, put back in order by the unpacks of store_transpose8
+static FORCE_INLINE void xor_store_transpose8(uint8_t* out, const uint8_t* in, __m256i x0, __m256i x1, __m256i x2, __m256i x3)
+{
+    __m256i t0 = _mm256_unpacklo_epi32(x0, x1);
+    __m256i t1 = _mm256_unpackhi_epi32(x0, x1);
+    __m256i t2 = _mm256_unpacklo_epi32(x2, x3);
+    __m256i t3 = _mm256_unpackhi_epi32(x2, x3);
+
+    _mm256_storeu_si256((__m256i*) out, _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) in), _mm256_unpacklo_epi64(t0, t2)));
+    _mm256_storeu_si256((__m256i*) out + 1, _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) in + 1), _mm256_unpackhi_epi64(t0, t2)));
+    _mm256_storeu_si256((__m256i*) out + 2, _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) in + 2), _mm256_unpacklo_epi64(t1, t3)));
+    _mm256_storeu_si256((__m256i*) out + 3, _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) in + 3), _mm256_unpackhi_epi64(t1, t3)));
+}
+
+static FORCE_INLINE uint32_t load32_be(const uint8_t* p)
+{
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+// ctr += n, 128-bit big-endian
+static FORCE_INLINE void ctr_add(uint8_t* ctr, size_t n)
+{
+    for (size_t i = 16; i-- > 0 && n != 0; ) {
+        n += ctr[i];
+        ctr[i] = (uint8_t) n;
+        n >>= 8;
+    }
+}
+
+/**
+ * words of the counter blocks ctr + base .. ctr + base + 7 in the lane order of load_transpose8,
+ * for a low counter word c that does not wrap, so only x3 differs between the lanes.
+ */
+static FORCE_INLINE void ctr_words8(__m256i* x0, __m256i* x1, __m256i* x2, __m256i* x3, const uint8_t* ctr, uint32_t c, uint32_t base)
+{
+    const __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256i bswap = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const uint32_t* w = (const uint32_t*) ctr;
+
+    *x0 = _mm256_set1_epi32(w[0]);
+    *x1 = _mm256_set1_epi32(w[1]);
+    *x2 = _mm256_set1_epi32(w[2]);
+    *x3 = _mm256_shuffle_epi8(add32x8(_mm256_set1_epi32(c + base), order), bswap);
+}
+
+static FORCE_INLINE void lea_ctr_8blk(uint8_t* out, const uint8_t* in, const uint8_t* ctr, uint32_t c, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m256i x0, x1, x2, x3;
+
+    ctr_words8(&x0, &x1, &x2, &x3, ctr, c, 0);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_8blk(&x0, &x1, &x2, &x3, rk);
+        rk += 6;
+
+        enc_round_8blk(&x1, &x2, &x3, &x0, rk);        
+        rk += 6;
+
+        enc_round_8blk(&x2, &x3, &x0, &x1, rk);
+        rk += 6;
+
+        enc_round_8blk(&x3, &x0, &x1, &x2, rk);
+        rk += 6;
+    }
+
+    xor_store_transpose8(out, in, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_ctr_16blk(uint8_t* out, const uint8_t* in, const uint8_t* ctr, uint32_t c, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m256i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    ctr_words8(&x0, &x1, &x2, &x3, ctr, c, 0);
+    ctr_words8(&x4, &x5, &x6, &x7, ctr, c, 8);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_8blk(&x0, &x1, &x2, &x3, rk);
+        enc_round_8blk(&x4, &x5, &x6, &x7, rk);
+        rk += 6;
+
+        enc_round_8blk(&x1, &x2, &x3, &x0, rk);
+        enc_round_8blk(&x5, &x6, &x7, &x4, rk);
+        rk += 6;
+
+        enc_round_8blk(&x2, &x3, &x0, &x1, rk);
+        enc_round_8blk(&x6, &x7, &x4, &x5, rk);
+        rk += 6;
+
+        enc_round_8blk(&x3, &x0, &x1, &x2, rk);
+        enc_round_8blk(&x7, &x4, &x5, &x6, rk);
+        rk += 6;
+    }
+
+    xor_store_transpose8(out, in, x0, x1, x2, x3);
+    xor_store_transpose8(out + 128, in + 128, x4, x5, x6, x7);
+}
+
+/**
+ * up to 8 blocks through memory, for the tail and for the batches in which the low
+ * counter word wraps and the carry has to reach the upper words.
+ */
+static FORCE_INLINE void lea_ctr_partial(uint8_t* out, const uint8_t* in, size_t nblocks, const uint8_t* ctr, size_t base, const uint8_t* rks, size_t rounds)
+{
+    uint8_t ks[16 * 8];
+
+    for (size_t i = 0; i < 8; ++i) {
+        memcpy(ks + 16 * i, ctr, 16);
+        ctr_add(ks + 16 * i, base + i);
+    }
+    lea_encrypt_8blk(ks, ks, rks, rounds);
+
+    for (size_t i = 0; i < 16 * nblocks; ++i) {
+        out[i] = in[i] ^ ks[i];
+    }
+}
+
+static FORCE_INLINE void lea_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks, size_t rounds)
+{
+    for (; nblocks >= 16; nblocks -= 16) {
+        uint32_t c = load32_be(ctr + 12);
+
+        if (c <= UINT32_MAX - 15) {
+            lea_ctr_16blk(dst, src, ctr, c, rks, rounds);
+        } else {
+            lea_ctr_partial(dst, src, 8, ctr, 0, rks, rounds);
+            lea_ctr_partial(dst + 128, src + 128, 8, ctr, 8, rks, rounds);
+        }
+
+        ctr_add(ctr, 16);
+        dst += 256;
+        src += 256;
+    }
+
+    if (nblocks >= 8) {
+        uint32_t c = load32_be(ctr + 12);
+
+        if (c <= UINT32_MAX - 7) {
+            lea_ctr_8blk(dst, src, ctr, c, rks, rounds);
+        } else {
+            lea_ctr_partial(dst, src, 8, ctr, 0, rks, rounds);
+        }
+
+        ctr_add(ctr, 8);
+        dst += 128;
+        src += 128;
+        nblocks -= 8;
+    }
+
+    if (nblocks > 0) {
+        lea_ctr_partial(dst, src, nblocks, ctr, 0, rks, rounds);
+        ctr_add(ctr, nblocks);
+    }
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! compact schedule, round key t0, t1, t2, t3 stands for t0, t1, t2, t1, t3, t1
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE void enc_round_compact(__m256i* x0, __m256i* x1, __m256i* x2, __m256i* x3, const uint32_t* rk)
+{
+    __m256i t1 = _mm256_set1_epi32(rk[1]);
+
+    *x3 = ror32x8(add32x8(addKey(*x2, rk[3]), _mm256_xor_si256(*x3, t1)), 3);
+    *x2 = ror32x8(add32x8(addKey(*x1, rk[2]), _mm256_xor_si256(*x2, t1)), 5);
+    *x1 = rol32x8(add32x8(addKey(*x0, rk[0]), _mm256_xor_si256(*x1, t1)), 9);
+}
+
+static FORCE_INLINE void dec_round_compact(__m256i* x0, __m256i* x1, __m256i* x2, __m256i* x3, const uint32_t* rk)
+{
+    __m256i t1 = _mm256_set1_epi32(rk[1]);
+
+    *x0 = _mm256_xor_si256(sub32x8(ror32x8(*x0, 9), addKey(*x3, rk[0])), t1);
+    *x1 = _mm256_xor_si256(sub32x8(rol32x8(*x1, 5), addKey(*x0, rk[2])), t1);
+    *x2 = _mm256_xor_si256(sub32x8(rol32x8(*x2, 3), addKey(*x1, rk[3])), t1);
+}
+
+static FORCE_INLINE void lea_encrypt_compact_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m256i x0, x1, x2, x3;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_compact(&x0, &x1, &x2, &x3, rk);
+        rk += 4;
+
+        enc_round_compact(&x1, &x2, &x3, &x0, rk);        
+        rk += 4;
+
+        enc_round_compact(&x2, &x3, &x0, &x1, rk);
+        rk += 4;
+
+        enc_round_compact(&x3, &x0, &x1, &x2, rk);
+        rk += 4;
+    }
+
+    store_transpose8(out, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_encrypt_compact_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m256i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
+    load_transpose8(&x4, &x5, &x6, &x7, in + 128);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_compact(&x0, &x1, &x2, &x3, rk);
+        enc_round_compact(&x4, &x5, &x6, &x7, rk);
+        rk += 4;
+
+        enc_round_compact(&x1, &x2, &x3, &x0, rk);
+        enc_round_compact(&x5, &x6, &x7, &x4, rk);
+        rk += 4;
+
+        enc_round_compact(&x2, &x3, &x0, &x1, rk);
+        enc_round_compact(&x6, &x7, &x4, &x5, rk);
+        rk += 4;
+
+        enc_round_compact(&x3, &x0, &x1, &x2, rk);
+        enc_round_compact(&x7, &x4, &x5, &x6, rk);
+        rk += 4;
+    }
+
+    store_transpose8(out, x0, x1, x2, x3);
+    store_transpose8(out + 128, x4, x5, x6, x7);
+}
+
+static FORCE_INLINE void lea_decrypt_compact_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m256i x0, x1, x2, x3;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
+    
+    rk += 4 * (rounds - 1);
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        dec_round_compact(&x0, &x1, &x2, &x3, rk);
+        rk -= 4;
+
+        dec_round_compact(&x3, &x0, &x1, &x2, rk);
+        rk -= 4;
+
+        dec_round_compact(&x2, &x3, &x0, &x1, rk);
+        rk -= 4;
+
+        dec_round_compact(&x1, &x2, &x3, &x0, rk);
+        rk -= 4;
+    }
+
+    store_transpose8(out, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_decrypt_compact_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m256i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
+    load_transpose8(&x4, &x5, &x6, &x7, in + 128);
+    
+    rk += 4 * (rounds - 1);
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        dec_round_compact(&x0, &x1, &x2, &x3, rk);
+        dec_round_compact(&x4, &x5, &x6, &x7, rk);
+        rk -= 4;
+
+        dec_round_compact(&x3, &x0, &x1, &x2, rk);
+        dec_round_compact(&x7, &x4, &x5, &x6, rk);
+        rk -= 4;
+
+        dec_round_compact(&x2, &x3, &x0, &x1, rk);
+        dec_round_compact(&x6, &x7, &x4, &x5, rk);
+        rk -= 4;
+
+        dec_round_compact(&x1, &x2, &x3, &x0, rk);
+        dec_round_compact(&x5, &x6, &x7, &x4, rk);
+        rk -= 4;
+    }
+
+    store_transpose8(out, x0, x1, x2, x3);
+    store_transpose8(out + 128, x4, x5, x6, x7);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! key schedule for 8 keys at once, one key per 32-bit lane
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// the same constants as lea.keyschedule.c
+const static uint32_t DELTA[8]= {
+    0xc3efe9db, 0x44626b02, 0x79e27c8a, 0x78df30ec, 0x715ea49e, 0xc785da0a, 0xe04ef22a, 0xe5c40957,
+};
+
+static FORCE_INLINE uint32_t rol32(uint32_t value, size_t rot)
+{
+    rot &= 31;
+    return (value << rot) | (value >> ((32 - rot) & 31));
+}
+
+// word i of every key, lane k from mk[k]
+static FORCE_INLINE __m256i load_key_words8(const uint8_t* const mk[8], size_t i)
+{
+    return _mm256_setr_epi32(
+        ((const uint32_t*) mk[0])[i], ((const uint32_t*) mk[1])[i], ((const uint32_t*) mk[2])[i], ((const uint32_t*) mk[3])[i],
+        ((const uint32_t*) mk[4])[i], ((const uint32_t*) mk[5])[i], ((const uint32_t*) mk[6])[i], ((const uint32_t*) mk[7])[i]);
+}
+
+// t = rol32(t + rol32(delta, rot), shift) in every lane
+static FORCE_INLINE __m256i key_update8(__m256i t, uint32_t delta, size_t rot, size_t shift)
+{
+    return rol32x8(add32x8(t, _mm256_set1_epi32(rol32(delta, rot))), shift);
+}
+
+/**
+ * transposes k0..k3 so that key i gets the words k0[i], k1[i], k2[i], k3[i] at out[i] + offset,
+ * w[j] holds the keys j and 4 + j in its two 128-bit lanes.
+ */
+static FORCE_INLINE void store_round_keys4(uint8_t* const out[8], size_t offset, __m256i k0, __m256i k1, __m256i k2, __m256i k3)
+{
+    __m256i t0 = _mm256_unpacklo_epi32(k0, k1);
+    __m256i t1 = _mm256_unpackhi_epi32(k0, k1);
+    __m256i t2 = _mm256_unpacklo_epi32(k2, k3);
+    __m256i t3 = _mm256_unpackhi_epi32(k2, k3);
+
+    __m256i w[4] = {
+        _mm256_unpacklo_epi64(t0, t2), _mm256_unpackhi_epi64(t0, t2), 
+        _mm256_unpacklo_epi64(t1, t3), _mm256_unpackhi_epi64(t1, t3),
+    };
+
+    for (size_t j = 0; j < 4; ++j) {
+        _mm_storeu_si128((__m128i*) (out[j] + offset), _mm256_castsi256_si128(w[j]));
+        _mm_storeu_si128((__m128i*) (out[j + 4] + offset), _mm256_extracti128_si256(w[j], 1));
+    }
+}
+
+// the same for 6 words per round, k4 and k5 as one 64-bit pair per key
+static FORCE_INLINE void store_round_keys6(uint8_t* const out[8], size_t offset, __m256i k0, __m256i k1, __m256i k2, __m256i k3, __m256i k4, __m256i k5)
+{
+    store_round_keys4(out, offset, k0, k1, k2, k3);
+
+    __m256i p0 = _mm256_unpacklo_epi32(k4, k5);
+    __m256i p1 = _mm256_unpackhi_epi32(k4, k5);
+
+    // the keys 0 and 1, 2 and 3, 4 and 5, 6 and 7
+    __m128i q[4] = {
+        _mm256_castsi256_si128(p0), _mm256_castsi256_si128(p1),
+        _mm256_extracti128_si256(p0, 1), _mm256_extracti128_si256(p1, 1),
+    };
+
+    for (size_t j = 0; j < 4; ++j) {
+        _mm_storel_epi64((__m128i*) (out[2 * j] + offset + 16), q[j]);
+        _mm_storel_epi64((__m128i*) (out[2 * j + 1] + offset + 16), _mm_unpackhi_epi64(q[j], q[j]));
+    }
+}
+
+static FORCE_INLINE void lea128_keygen_x8_internal(uint8_t* const out[8], const uint8_t* const mk[8], int compact)
+{
+    __m256i t0 = load_key_words8(mk, 0);
+    __m256i t1 = load_key_words8(mk, 1);
+    __m256i t2 = load_key_words8(mk, 2);
+    __m256i t3 = load_key_words8(mk, 3);
+
+    for (size_t round = 0; round < LEA128_ROUNDS; ++round) {
+        uint32_t delta = DELTA[round & 3];
+
+        t0 = key_update8(t0, delta, round, 1);
+        t1 = key_update8(t1, delta, round + 1, 3);
+        t2 = key_update8(t2, delta, round + 2, 6);
+        t3 = key_update8(t3, delta, round + 3, 11);
+
+        if (compact) {
+            store_round_keys4(out, 16 * round, t0, t1, t2, t3);
+        } else {
+            store_round_keys6(out, 24 * round, t0, t1, t2, t1, t3, t1);
+        }
+    }
 }
 
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -268,6 +743,56 @@ FORCE_INLINE void lea128_decrypt_16blk(uint8_t* out, const uint8_t* in, const ui
     lea_decrypt_16blk(out, in, rks, LEA128_ROUNDS);
 }
 
+FORCE_INLINE void lea128_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    lea_ctr_blocks(dst, src, nblocks, ctr, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_set_lane_key(uint32_t* rkx, size_t lanes, size_t lane, const uint8_t* rks)
+{
+    lea_set_lane_key(rkx, lanes, lane, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_encrypt_lanes_x8(uint8_t* out, const uint8_t* in, const uint32_t* rkx)
+{
+    lea_encrypt_lanes_x8(out, in, rkx, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_encrypt_lanes_x16(uint8_t* out, const uint8_t* in, const uint32_t* rkx)
+{
+    lea_encrypt_lanes_x16(out, in, rkx, LEA128_ROUNDS);
+}
+
+void lea128_keygen_x8(uint8_t* const out[8], const uint8_t* const mk[8])
+{
+    lea128_keygen_x8_internal(out, mk, 0);
+}
+
+void lea128_keygen_compact_x8(uint8_t* const out[8], const uint8_t* const mk[8])
+{
+    lea128_keygen_x8_internal(out, mk, 1);
+}
+
+FORCE_INLINE void lea128_encrypt_compact_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_compact_8blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_decrypt_compact_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_compact_8blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_encrypt_compact_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_compact_16blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_decrypt_compact_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_compact_16blk(out, in, rks, LEA128_ROUNDS);
+}
+
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 //! encryption / decryption for 192-bit key
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -291,6 +816,49 @@ FORCE_INLINE void lea192_decrypt_16blk(uint8_t* out, const uint8_t* in, const ui
     lea_decrypt_16blk(out, in, rks, LEA192_ROUNDS);
 }
 
+FORCE_INLINE void lea192_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    lea_ctr_blocks(dst, src, nblocks, ctr, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_set_lane_key(uint32_t* rkx, size_t lanes, size_t lane, const uint8_t* rks)
+{
+    lea_set_lane_key(rkx, lanes, lane, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_encrypt_lanes_x8(uint8_t* out, const uint8_t* in, const uint32_t* rkx)
+{
+    lea_encrypt_lanes_x8(out, in, rkx, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_encrypt_lanes_x16(uint8_t* out, const uint8_t* in, const uint32_t* rkx)
+{
+    lea_encrypt_lanes_x16(out, in, rkx, LEA192_ROUNDS);
+}
+
+void lea192_keygen_x8(uint8_t* const out[8], const uint8_t* const mk[8])
+{
+    __m256i t0 = load_key_words8(mk, 0);
+    __m256i t1 = load_key_words8(mk, 1);
+    __m256i t2 = load_key_words8(mk, 2);
+    __m256i t3 = load_key_words8(mk, 3);
+    __m256i t4 = load_key_words8(mk, 4);
+    __m256i t5 = load_key_words8(mk, 5);
+
+    for (size_t round = 0; round < LEA192_ROUNDS; ++round) {
+        uint32_t delta = DELTA[round % 6];
+
+        t0 = key_update8(t0, delta, round, 1);
+        t1 = key_update8(t1, delta, round + 1, 3);
+        t2 = key_update8(t2, delta, round + 2, 6);
+        t3 = key_update8(t3, delta, round + 3, 11);
+        t4 = key_update8(t4, delta, round + 4, 13);
+        t5 = key_update8(t5, delta, round + 5, 17);
+
+        store_round_keys6(out, 24 * round, t0, t1, t2, t3, t4, t5);
+    }
+}
+
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 //! encryption / decryption for 256-bit key
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -313,3 +881,47 @@ FORCE_INLINE void lea256_decrypt_16blk(uint8_t* out, const uint8_t* in, const ui
 {
     lea_decrypt_16blk(out, in, rks, LEA256_ROUNDS);
 }
+
+FORCE_INLINE void lea256_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    lea_ctr_blocks(dst, src, nblocks, ctr, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_set_lane_key(uint32_t* rkx, size_t lanes, size_t lane, const uint8_t* rks)
+{
+    lea_set_lane_key(rkx, lanes, lane, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_encrypt_lanes_x8(uint8_t* out, const uint8_t* in, const uint32_t* rkx)
+{
+    lea_encrypt_lanes_x8(out, in, rkx, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_encrypt_lanes_x16(uint8_t* out, const uint8_t* in, const uint32_t* rkx)
+{
+    lea_encrypt_lanes_x16(out, in, rkx, LEA256_ROUNDS);
+}
+
+void lea256_keygen_x8(uint8_t* const out[8], const uint8_t* const mk[8])
+{
+    __m256i t[8];
+
+    for (size_t i = 0; i < 8; ++i) {
+        t[i] = load_key_words8(mk, i);
+    }
+
+    for (size_t round = 0; round < LEA256_ROUNDS; ++round) {
+        uint32_t delta = DELTA[round & 0x7];
+
+        t[(6 * round) & 0x7] = key_update8(t[(6 * round) & 0x7], delta, round, 1);
+        t[(6 * round + 1) & 0x7] = key_update8(t[(6 * round + 1) & 0x7], delta, round + 1, 3);
+        t[(6 * round + 2) & 0x7] = key_update8(t[(6 * round + 2) & 0x7], delta, round + 2, 6);
+        t[(6 * round + 3) & 0x7] = key_update8(t[(6 * round + 3) & 0x7], delta, round + 3, 11);
+        t[(6 * round + 4) & 0x7] = key_update8(t[(6 * round + 4) & 0x7], delta, round + 4, 13);
+        t[(6 * round + 5) & 0x7] = key_update8(t[(6 * round + 5) & 0x7], delta, round + 5, 17);
+
+        store_round_keys6(out, 24 * round, 
+            t[(6 * round) & 0x7], t[(6 * round + 1) & 0x7], t[(6 * round + 2) & 0x7], 
+            t[(6 * round + 3) & 0x7], t[(6 * round + 4) & 0x7], t[(6 * round + 5) & 0x7]);
+    }
+}
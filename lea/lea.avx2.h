@@ -34,6 +34,41 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#ifdef LEA_NAMESPACE
+#define lea128_encrypt_8blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_encrypt_8blk)
+#define lea128_decrypt_8blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_decrypt_8blk)
+#define lea192_encrypt_8blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_encrypt_8blk)
+#define lea192_decrypt_8blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_decrypt_8blk)
+#define lea256_encrypt_8blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_encrypt_8blk)
+#define lea256_decrypt_8blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_decrypt_8blk)
+#define lea128_encrypt_16blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_encrypt_16blk)
+#define lea128_decrypt_16blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_decrypt_16blk)
+#define lea192_encrypt_16blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_encrypt_16blk)
+#define lea192_decrypt_16blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_decrypt_16blk)
+#define lea256_encrypt_16blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_encrypt_16blk)
+#define lea256_decrypt_16blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_decrypt_16blk)
+#define lea128_ctr_blocks LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_ctr_blocks)
+#define lea192_ctr_blocks LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_ctr_blocks)
+#define lea256_ctr_blocks LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_ctr_blocks)
+#define lea128_set_lane_key LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_set_lane_key)
+#define lea128_encrypt_lanes_x8 LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_encrypt_lanes_x8)
+#define lea128_encrypt_lanes_x16 LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_encrypt_lanes_x16)
+#define lea192_set_lane_key LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_set_lane_key)
+#define lea192_encrypt_lanes_x8 LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_encrypt_lanes_x8)
+#define lea192_encrypt_lanes_x16 LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_encrypt_lanes_x16)
+#define lea256_set_lane_key LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_set_lane_key)
+#define lea256_encrypt_lanes_x8 LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_encrypt_lanes_x8)
+#define lea256_encrypt_lanes_x16 LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_encrypt_lanes_x16)
+#define lea128_keygen_x8 LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_keygen_x8)
+#define lea192_keygen_x8 LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_keygen_x8)
+#define lea256_keygen_x8 LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_keygen_x8)
+#define lea128_keygen_compact_x8 LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_keygen_compact_x8)
+#define lea128_encrypt_compact_8blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_encrypt_compact_8blk)
+#define lea128_decrypt_compact_8blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_decrypt_compact_8blk)
+#define lea128_encrypt_compact_16blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_encrypt_compact_16blk)
+#define lea128_decrypt_compact_16blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_decrypt_compact_16blk)
+#endif
+
 void lea128_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
 void lea128_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
 void lea192_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
@@ -48,4 +83,44 @@ void lea192_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
 void lea256_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
 void lea256_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
 
+/**
+ * CTR keystream applied to nblocks whole blocks: dst = src ^ E(ctr), E(ctr + 1), ...
+ * ctr is a 128-bit big-endian counter and is advanced by nblocks on return.
+ * The counter blocks are built in registers, only src and dst go through memory.
+ * lea.dispatch.c writes the counter blocks out and encrypts them on backends without this kernel.
+ */
+void lea128_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+void lea192_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+void lea256_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+
+/**
+ * Multi-buffer encryption of one block in each of 8 or 16 independent lanes, every lane with its own key.
+ * lea*_set_lane_key copies the round keys of one lane into the interleaved schedule rkx,
+ * which holds 6 * LEA*_ROUNDS * lanes words. Only in the AVX2 backend, not behind lea.dispatch.c.
+ */
+void lea128_set_lane_key(uint32_t* rkx, size_t lanes, size_t lane, const uint8_t* rks);
+void lea128_encrypt_lanes_x8(uint8_t* out, const uint8_t* in, const uint32_t* rkx);
+void lea128_encrypt_lanes_x16(uint8_t* out, const uint8_t* in, const uint32_t* rkx);
+void lea192_set_lane_key(uint32_t* rkx, size_t lanes, size_t lane, const uint8_t* rks);
+void lea192_encrypt_lanes_x8(uint8_t* out, const uint8_t* in, const uint32_t* rkx);
+void lea192_encrypt_lanes_x16(uint8_t* out, const uint8_t* in, const uint32_t* rkx);
+void lea256_set_lane_key(uint32_t* rkx, size_t lanes, size_t lane, const uint8_t* rks);
+void lea256_encrypt_lanes_x8(uint8_t* out, const uint8_t* in, const uint32_t* rkx);
+void lea256_encrypt_lanes_x16(uint8_t* out, const uint8_t* in, const uint32_t* rkx);
+
+/**
+ * Expands 8 independent keys at once, out[i] receives the same schedule as lea*_keygen(out[i], mk[i]).
+ * Only in the AVX2 backend, not behind lea.dispatch.c.
+ */
+void lea128_keygen_x8(uint8_t* const out[8], const uint8_t* const mk[8]);
+void lea192_keygen_x8(uint8_t* const out[8], const uint8_t* const mk[8]);
+void lea256_keygen_x8(uint8_t* const out[8], const uint8_t* const mk[8]);
+void lea128_keygen_compact_x8(uint8_t* const out[8], const uint8_t* const mk[8]);
+
+// LEA-128 with the schedule of lea128_keygen_compact, only in the AVX2 backend
+void lea128_encrypt_compact_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea128_decrypt_compact_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea128_encrypt_compact_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea128_decrypt_compact_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+
 #endif
\ No newline at end of file
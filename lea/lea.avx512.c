@@ -0,0 +1,617 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "lea.avx512.h"
+
+#include <x86intrin.h>
+#include <string.h>
+
+#include "inline.inc"
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! avx512 aided basic operations
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// vprold / vprord take the rotation as an immediate, so the round functions below pass literals
+#define rol32x8(value, rot) _mm256_rol_epi32(value, rot)
+#define ror32x8(value, rot) _mm256_ror_epi32(value, rot)
+#define rol32x16(value, rot) _mm512_rol_epi32(value, rot)
+#define ror32x16(value, rot) _mm512_ror_epi32(value, rot)
+
+static FORCE_INLINE __m256i addKey8(__m256i value, uint32_t rk) 
+{
+    return _mm256_xor_si256(value, _mm256_set1_epi32(rk));
+}
+
+static FORCE_INLINE __m512i addKey16(__m512i value, uint32_t rk) 
+{
+    return _mm512_xor_si512(value, _mm512_set1_epi32(rk));
+}
+
+/**
+ * loads 8 contiguous blocks with 4 vector loads and transposes the 4x4 words within each 128-bit lane,
+ * so that x0..x3 hold word 0..3 of the blocks in the order 0, 2, 4, 6, 1, 3, 5, 7.
+ */
+static FORCE_INLINE void load_transpose8(__m256i* x0, __m256i* x1, __m256i* x2, __m256i* x3, const uint8_t* in)
+{
+    __m256i v0 = _mm256_loadu_si256((const __m256i*) in);
+    __m256i v1 = _mm256_loadu_si256((const __m256i*) in + 1);
+    __m256i v2 = _mm256_loadu_si256((const __m256i*) in + 2);
+    __m256i v3 = _mm256_loadu_si256((const __m256i*) in + 3);
+
+    __m256i t0 = _mm256_unpacklo_epi32(v0, v1);
+    __m256i t1 = _mm256_unpackhi_epi32(v0, v1);
+    __m256i t2 = _mm256_unpacklo_epi32(v2, v3);
+    __m256i t3 = _mm256_unpackhi_epi32(v2, v3);
+
+    *x0 = _mm256_unpacklo_epi64(t0, t2);
+    *x1 = _mm256_unpackhi_epi64(t0, t2);
+    *x2 = _mm256_unpacklo_epi64(t1, t3);
+    *x3 = _mm256_unpackhi_epi64(t1, t3);
+}
+
+// the inverse of load_transpose8, the same unpacks put the blocks back in order
+static FORCE_INLINE void store_transpose8(uint8_t* out, __m256i x0, __m256i x1, __m256i x2, __m256i x3)
+{
+    __m256i t0 = _mm256_unpacklo_epi32(x0, x1);
+    __m256i t1 = _mm256_unpackhi_epi32(x0, x1);
+    __m256i t2 = _mm256_unpacklo_epi32(x2, x3);
+    __m256i t3 = _mm256_unpackhi_epi32(x2, x3);
+
+    _mm256_storeu_si256((__m256i*) out, _mm256_unpacklo_epi64(t0, t2));
+    _mm256_storeu_si256((__m256i*) out + 1, _mm256_unpackhi_epi64(t0, t2));
+    _mm256_storeu_si256((__m256i*) out + 2, _mm256_unpacklo_epi64(t1, t3));
+    _mm256_storeu_si256((__m256i*) out + 3, _mm256_unpackhi_epi64(t1, t3));
+}
+
+/**
+ * the same transpose on 16 blocks, 128-bit lane j of x0..x3 holds the words of the blocks j, 4 + j, 8 + j and 12 + j.
+ */
+static FORCE_INLINE void load_transpose16(__m512i* x0, __m512i* x1, __m512i* x2, __m512i* x3, const uint8_t* in)
+{
+    __m512i v0 = _mm512_loadu_si512((const __m512i*) in);
+    __m512i v1 = _mm512_loadu_si512((const __m512i*) in + 1);
+    __m512i v2 = _mm512_loadu_si512((const __m512i*) in + 2);
+    __m512i v3 = _mm512_loadu_si512((const __m512i*) in + 3);
+
+    __m512i t0 = _mm512_unpacklo_epi32(v0, v1);
+    __m512i t1 = _mm512_unpackhi_epi32(v0, v1);
+    __m512i t2 = _mm512_unpacklo_epi32(v2, v3);
+    __m512i t3 = _mm512_unpackhi_epi32(v2, v3);
+
+    *x0 = _mm512_unpacklo_epi64(t0, t2);
+    *x1 = _mm512_unpackhi_epi64(t0, t2);
+    *x2 = _mm512_unpacklo_epi64(t1, t3);
+    *x3 = _mm512_unpackhi_epi64(t1, t3);
+}
+
+static FORCE_INLINE void store_transpose16(uint8_t* out, __m512i x0, __m512i x1, __m512i x2, __m512i x3)
+{
+    __m512i t0 = _mm512_unpacklo_epi32(x0, x1);
+    __m512i t1 = _mm512_unpackhi_epi32(x0, x1);
+    __m512i t2 = _mm512_unpacklo_epi32(x2, x3);
+    __m512i t3 = _mm512_unpackhi_epi32(x2, x3);
+
+    _mm512_storeu_si512((__m512i*) out, _mm512_unpacklo_epi64(t0, t2));
+    _mm512_storeu_si512((__m512i*) out + 1, _mm512_unpackhi_epi64(t0, t2));
+    _mm512_storeu_si512((__m512i*) out + 2, _mm512_unpacklo_epi64(t1, t3));
+    _mm512_storeu_si512((__m512i*) out + 3, _mm512_unpackhi_epi64(t1, t3));
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! common round functions
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE void enc_round_8blk(__m256i* x0, __m256i* x1, __m256i* x2, __m256i* x3, const uint32_t* rk)
+{
+    *x3 = ror32x8(_mm256_add_epi32(addKey8(*x2, rk[4]), addKey8(*x3, rk[5])), 3);
+    *x2 = ror32x8(_mm256_add_epi32(addKey8(*x1, rk[2]), addKey8(*x2, rk[3])), 5);
+    *x1 = rol32x8(_mm256_add_epi32(addKey8(*x0, rk[0]), addKey8(*x1, rk[1])), 9);
+}
+
+static FORCE_INLINE void dec_round_8blk(__m256i* x0, __m256i* x1, __m256i* x2, __m256i* x3, const uint32_t* rk)
+{
+    *x0 = addKey8(_mm256_sub_epi32(ror32x8(*x0, 9), addKey8(*x3, rk[0])), rk[1]);
+    *x1 = addKey8(_mm256_sub_epi32(rol32x8(*x1, 5), addKey8(*x0, rk[2])), rk[3]);
+    *x2 = addKey8(_mm256_sub_epi32(rol32x8(*x2, 3), addKey8(*x1, rk[4])), rk[5]);
+}
+
+static FORCE_INLINE void enc_round_16blk(__m512i* x0, __m512i* x1, __m512i* x2, __m512i* x3, const uint32_t* rk)
+{
+    *x3 = ror32x16(_mm512_add_epi32(addKey16(*x2, rk[4]), addKey16(*x3, rk[5])), 3);
+    *x2 = ror32x16(_mm512_add_epi32(addKey16(*x1, rk[2]), addKey16(*x2, rk[3])), 5);
+    *x1 = rol32x16(_mm512_add_epi32(addKey16(*x0, rk[0]), addKey16(*x1, rk[1])), 9);
+}
+
+static FORCE_INLINE void dec_round_16blk(__m512i* x0, __m512i* x1, __m512i* x2, __m512i* x3, const uint32_t* rk)
+{
+    *x0 = addKey16(_mm512_sub_epi32(ror32x16(*x0, 9), addKey16(*x3, rk[0])), rk[1]);
+    *x1 = addKey16(_mm512_sub_epi32(rol32x16(*x1, 5), addKey16(*x0, rk[2])), rk[3]);
+    *x2 = addKey16(_mm512_sub_epi32(rol32x16(*x2, 3), addKey16(*x1, rk[4])), rk[5]);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! common encryption functions
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE void lea_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m256i x0, x1, x2, x3;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_8blk(&x0, &x1, &x2, &x3, rk);
+        rk += 6;
+
+        enc_round_8blk(&x1, &x2, &x3, &x0, rk);        
+        rk += 6;
+
+        enc_round_8blk(&x2, &x3, &x0, &x1, rk);
+        rk += 6;
+
+        enc_round_8blk(&x3, &x0, &x1, &x2, rk);
+        rk += 6;
+    }
+
+    store_transpose8(out, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m512i x0, x1, x2, x3;
+
+    load_transpose16(&x0, &x1, &x2, &x3, in);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_16blk(&x0, &x1, &x2, &x3, rk);
+        rk += 6;
+
+        enc_round_16blk(&x1, &x2, &x3, &x0, rk);        
+        rk += 6;
+
+        enc_round_16blk(&x2, &x3, &x0, &x1, rk);
+        rk += 6;
+
+        enc_round_16blk(&x3, &x0, &x1, &x2, rk);
+        rk += 6;
+    }
+
+    store_transpose16(out, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_encrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m512i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    load_transpose16(&x0, &x1, &x2, &x3, in);
+    load_transpose16(&x4, &x5, &x6, &x7, in + 256);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_16blk(&x0, &x1, &x2, &x3, rk);
+        enc_round_16blk(&x4, &x5, &x6, &x7, rk);
+        rk += 6;
+
+        enc_round_16blk(&x1, &x2, &x3, &x0, rk);
+        enc_round_16blk(&x5, &x6, &x7, &x4, rk);
+        rk += 6;
+
+        enc_round_16blk(&x2, &x3, &x0, &x1, rk);
+        enc_round_16blk(&x6, &x7, &x4, &x5, rk);
+        rk += 6;
+
+        enc_round_16blk(&x3, &x0, &x1, &x2, rk);
+        enc_round_16blk(&x7, &x4, &x5, &x6, rk);
+        rk += 6;
+    }
+
+    store_transpose16(out, x0, x1, x2, x3);
+    store_transpose16(out + 256, x4, x5, x6, x7);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! common decryption functions
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE void lea_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m256i x0, x1, x2, x3;
+
+    load_transpose8(&x0, &x1, &x2, &x3, in);
+    
+    rk += 6 * (rounds - 1);
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        dec_round_8blk(&x0, &x1, &x2, &x3, rk);
+        rk -= 6;
+
+        dec_round_8blk(&x3, &x0, &x1, &x2, rk);
+        rk -= 6;
+
+        dec_round_8blk(&x2, &x3, &x0, &x1, rk);
+        rk -= 6;
+
+        dec_round_8blk(&x1, &x2, &x3, &x0, rk);
+        rk -= 6;
+    }
+
+    store_transpose8(out, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m512i x0, x1, x2, x3;
+
+    load_transpose16(&x0, &x1, &x2, &x3, in);
+    
+    rk += 6 * (rounds - 1);
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        dec_round_16blk(&x0, &x1, &x2, &x3, rk);
+        rk -= 6;
+
+        dec_round_16blk(&x3, &x0, &x1, &x2, rk);
+        rk -= 6;
+
+        dec_round_16blk(&x2, &x3, &x0, &x1, rk);
+        rk -= 6;
+
+        dec_round_16blk(&x1, &x2, &x3, &x0, rk);
+        rk -= 6;
+    }
+
+    store_transpose16(out, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_decrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m512i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    load_transpose16(&x0, &x1, &x2, &x3, in);
+    load_transpose16(&x4, &x5, &x6, &x7, in + 256);
+    
+    rk += 6 * (rounds - 1);
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        dec_round_16blk(&x0, &x1, &x2, &x3, rk);
+        dec_round_16blk(&x4, &x5, &x6, &x7, rk);
+        rk -= 6;
+
+        dec_round_16blk(&x3, &x0, &x1, &x2, rk);
+        dec_round_16blk(&x7, &x4, &x5, &x6, rk);
+        rk -= 6;
+
+        dec_round_16blk(&x2, &x3, &x0, &x1, rk);
+        dec_round_16blk(&x6, &x7, &x4, &x5, rk);
+        rk -= 6;
+
+        dec_round_16blk(&x1, &x2, &x3, &x0, rk);
+        dec_round_16blk(&x5, &x6, &x7, &x4, rk);
+        rk -= 6;
+    }
+
+    store_transpose16(out, x0, x1, x2, x3);
+    store_transpose16(out + 256, x4, x5, x6, x7);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! CTR mode with the counter blocks built in registers
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// out = in ^ the blocks of x0..x3, put back in order by the unpacks of store_transpose16
+static FORCE_INLINE void xor_store_transpose16(uint8_t* out, const uint8_t* in, __m512i x0, __m512i x1, __m512i x2, __m512i x3)
+{
+    __m512i t0 = _mm512_unpacklo_epi32(x0, x1);
+    __m512i t1 = _mm512_unpackhi_epi32(x0, x1);
+    __m512i t2 = _mm512_unpacklo_epi32(x2, x3);
+    __m512i t3 = _mm512_unpackhi_epi32(x2, x3);
+
+    _mm512_storeu_si512((__m512i*) out, _mm512_xor_si512(_mm512_loadu_si512((const __m512i*) in), _mm512_unpacklo_epi64(t0, t2)));
+    _mm512_storeu_si512((__m512i*) out + 1, _mm512_xor_si512(_mm512_loadu_si512((const __m512i*) in + 1), _mm512_unpackhi_epi64(t0, t2)));
+    _mm512_storeu_si512((__m512i*) out + 2, _mm512_xor_si512(_mm512_loadu_si512((const __m512i*) in + 2), _mm512_unpacklo_epi64(t1, t3)));
+    _mm512_storeu_si512((__m512i*) out + 3, _mm512_xor_si512(_mm512_loadu_si512((const __m512i*) in + 3), _mm512_unpackhi_epi64(t1, t3)));
+}
+
+static FORCE_INLINE uint32_t load32_be(const uint8_t* p)
+{
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+// ctr += n, 128-bit big-endian
+static FORCE_INLINE void ctr_add(uint8_t* ctr, size_t n)
+{
+    for (size_t i = 16; i-- > 0 && n != 0; ) {
+        n += ctr[i];
+        ctr[i] = (uint8_t) n;
+        n >>= 8;
+    }
+}
+
+/**
+ * words of the counter blocks ctr + base .. ctr + base + 15 in the lane order of load_transpose16,
+ * for a low counter word c that does not wrap, so only x3 differs between the lanes.
+ */
+static FORCE_INLINE void ctr_words16(__m512i* x0, __m512i* x1, __m512i* x2, __m512i* x3, const uint8_t* ctr, uint32_t c, uint32_t base)
+{
+    const __m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    const __m512i mask = _mm512_set1_epi32(0x00ff00ff);
+    const uint32_t* w = (const uint32_t*) ctr;
+    __m512i t = _mm512_add_epi32(_mm512_set1_epi32(c + base), order);
+
+    *x0 = _mm512_set1_epi32(w[0]);
+    *x1 = _mm512_set1_epi32(w[1]);
+    *x2 = _mm512_set1_epi32(w[2]);
+
+    // byte swap without AVX-512BW: bytes 0 and 2 rotate left by 8, bytes 1 and 3 right by 8
+    *x3 = _mm512_ternarylogic_epi32(mask, rol32x16(t, 8), ror32x16(t, 8), 0xca);
+}
+
+static FORCE_INLINE void lea_ctr_16blk(uint8_t* out, const uint8_t* in, const uint8_t* ctr, uint32_t c, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m512i x0, x1, x2, x3;
+
+    ctr_words16(&x0, &x1, &x2, &x3, ctr, c, 0);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_16blk(&x0, &x1, &x2, &x3, rk);
+        rk += 6;
+
+        enc_round_16blk(&x1, &x2, &x3, &x0, rk);        
+        rk += 6;
+
+        enc_round_16blk(&x2, &x3, &x0, &x1, rk);
+        rk += 6;
+
+        enc_round_16blk(&x3, &x0, &x1, &x2, rk);
+        rk += 6;
+    }
+
+    xor_store_transpose16(out, in, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_ctr_32blk(uint8_t* out, const uint8_t* in, const uint8_t* ctr, uint32_t c, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m512i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    ctr_words16(&x0, &x1, &x2, &x3, ctr, c, 0);
+    ctr_words16(&x4, &x5, &x6, &x7, ctr, c, 16);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_16blk(&x0, &x1, &x2, &x3, rk);
+        enc_round_16blk(&x4, &x5, &x6, &x7, rk);
+        rk += 6;
+
+        enc_round_16blk(&x1, &x2, &x3, &x0, rk);
+        enc_round_16blk(&x5, &x6, &x7, &x4, rk);
+        rk += 6;
+
+        enc_round_16blk(&x2, &x3, &x0, &x1, rk);
+        enc_round_16blk(&x6, &x7, &x4, &x5, rk);
+        rk += 6;
+
+        enc_round_16blk(&x3, &x0, &x1, &x2, rk);
+        enc_round_16blk(&x7, &x4, &x5, &x6, rk);
+        rk += 6;
+    }
+
+    xor_store_transpose16(out, in, x0, x1, x2, x3);
+    xor_store_transpose16(out + 256, in + 256, x4, x5, x6, x7);
+}
+
+/**
+ * up to 8 blocks through memory, for the tail and for the batches in which the low
+ * counter word wraps and the carry has to reach the upper words.
+ */
+static FORCE_INLINE void lea_ctr_partial(uint8_t* out, const uint8_t* in, size_t nblocks, const uint8_t* ctr, size_t base, const uint8_t* rks, size_t rounds)
+{
+    uint8_t ks[16 * 8];
+
+    for (size_t i = 0; i < 8; ++i) {
+        memcpy(ks + 16 * i, ctr, 16);
+        ctr_add(ks + 16 * i, base + i);
+    }
+    lea_encrypt_8blk(ks, ks, rks, rounds);
+
+    for (size_t i = 0; i < 16 * nblocks; ++i) {
+        out[i] = in[i] ^ ks[i];
+    }
+}
+
+static FORCE_INLINE void lea_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks, size_t rounds)
+{
+    for (; nblocks >= 32; nblocks -= 32) {
+        uint32_t c = load32_be(ctr + 12);
+
+        if (c <= UINT32_MAX - 31) {
+            lea_ctr_32blk(dst, src, ctr, c, rks, rounds);
+        } else {
+            for (size_t i = 0; i < 4; ++i) {
+                lea_ctr_partial(dst + 128 * i, src + 128 * i, 8, ctr, 8 * i, rks, rounds);
+            }
+        }
+
+        ctr_add(ctr, 32);
+        dst += 512;
+        src += 512;
+    }
+
+    if (nblocks >= 16) {
+        uint32_t c = load32_be(ctr + 12);
+
+        if (c <= UINT32_MAX - 15) {
+            lea_ctr_16blk(dst, src, ctr, c, rks, rounds);
+        } else {
+            lea_ctr_partial(dst, src, 8, ctr, 0, rks, rounds);
+            lea_ctr_partial(dst + 128, src + 128, 8, ctr, 8, rks, rounds);
+        }
+
+        ctr_add(ctr, 16);
+        dst += 256;
+        src += 256;
+        nblocks -= 16;
+    }
+
+    while (nblocks > 0) {
+        size_t n = nblocks < 8 ? nblocks : 8;
+
+        lea_ctr_partial(dst, src, n, ctr, 0, rks, rounds);
+        ctr_add(ctr, n);
+        dst += 16 * n;
+        src += 16 * n;
+        nblocks -= n;
+    }
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! encryption / decryption for 128-bit key
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+FORCE_INLINE void lea128_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_8blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_8blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_16blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_16blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_encrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_32blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_decrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_32blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    lea_ctr_blocks(dst, src, nblocks, ctr, rks, LEA128_ROUNDS);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! encryption / decryption for 192-bit key
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+FORCE_INLINE void lea192_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_8blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_8blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_16blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_16blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_encrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_32blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_decrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_32blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    lea_ctr_blocks(dst, src, nblocks, ctr, rks, LEA192_ROUNDS);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! encryption / decryption for 256-bit key
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+FORCE_INLINE void lea256_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_8blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_8blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_16blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_16blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_encrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_32blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_decrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_32blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    lea_ctr_blocks(dst, src, nblocks, ctr, rks, LEA256_ROUNDS);
+}
@@ -0,0 +1,56 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CRYPTO_PRIMITIVES_LEA_AVX512_H__
+#define __CRYPTO_PRIMITIVES_LEA_AVX512_H__
+
+/**
+ * lea.avx512.c implements the 8 and 16 block functions and the CTR mode of lea.avx2.h with the native
+ * rotates of AVX-512, 8 blocks in ymm registers (AVX-512VL) and 16 blocks in one zmm register per word,
+ * and adds 32 blocks.
+ */
+#include "lea.avx2.h"
+
+#ifdef LEA_NAMESPACE
+#define lea128_encrypt_32blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_encrypt_32blk)
+#define lea128_decrypt_32blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_decrypt_32blk)
+#define lea192_encrypt_32blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_encrypt_32blk)
+#define lea192_decrypt_32blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_decrypt_32blk)
+#define lea256_encrypt_32blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_encrypt_32blk)
+#define lea256_decrypt_32blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_decrypt_32blk)
+#endif
+
+void lea128_encrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea128_decrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea192_encrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea192_decrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea256_encrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea256_decrypt_32blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+
+#endif
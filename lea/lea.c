@@ -128,6 +128,141 @@ static FORCE_INLINE void lea_decrypt(uint8_t* out, const uint8_t* in, const uint
     outblk[3] = b3;
 }
 
+static FORCE_INLINE void dec_round_2blk(uint32_t* a0, uint32_t* a1, uint32_t* a2, uint32_t* a3, uint32_t* c0, uint32_t* c1, uint32_t* c2, uint32_t* c3, const uint32_t* rk)
+{
+    *a0 = (ror32(*a0, 9) - (*a3 ^ rk[0])) ^ rk[1];
+    *c0 = (ror32(*c0, 9) - (*c3 ^ rk[0])) ^ rk[1];
+    *a1 = (rol32(*a1, 5) - (*a0 ^ rk[2])) ^ rk[3];
+    *c1 = (rol32(*c1, 5) - (*c0 ^ rk[2])) ^ rk[3];
+    *a2 = (rol32(*a2, 3) - (*a1 ^ rk[4])) ^ rk[5];
+    *c2 = (rol32(*c2, 3) - (*c1 ^ rk[4])) ^ rk[5];
+}
+
+static FORCE_INLINE void lea_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+    const uint32_t* block = (const uint32_t*) in;
+    uint32_t* outblk = (uint32_t*) out;
+
+    uint32_t a0 = block[0];
+    uint32_t a1 = block[1];
+    uint32_t a2 = block[2];
+    uint32_t a3 = block[3];
+    uint32_t c0 = block[4];
+    uint32_t c1 = block[5];
+    uint32_t c2 = block[6];
+    uint32_t c3 = block[7];
+
+    rk += 6 * (rounds - 1);
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        dec_round_2blk(&a0, &a1, &a2, &a3, &c0, &c1, &c2, &c3, rk);
+        rk -= 6;
+
+        dec_round_2blk(&a3, &a0, &a1, &a2, &c3, &c0, &c1, &c2, rk);
+        rk -= 6;
+
+        dec_round_2blk(&a2, &a3, &a0, &a1, &c2, &c3, &c0, &c1, rk);
+        rk -= 6;
+
+        dec_round_2blk(&a1, &a2, &a3, &a0, &c1, &c2, &c3, &c0, rk);
+        rk -= 6;
+    }
+
+    outblk[0] = a0;
+    outblk[1] = a1;
+    outblk[2] = a2;
+    outblk[3] = a3;
+    outblk[4] = c0;
+    outblk[5] = c1;
+    outblk[6] = c2;
+    outblk[7] = c3;
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! compact schedule, round key t0, t1, t2, t3 stands for t0, t1, t2, t1, t3, t1
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE void lea_encrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+    const uint32_t* block = (const uint32_t*) in;
+    uint32_t* outblk = (uint32_t*) out;
+
+    uint32_t b0 = block[0];
+    uint32_t b1 = block[1];
+    uint32_t b2 = block[2];
+    uint32_t b3 = block[3];
+
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        b3 = ror32((b2 ^ rk[3]) + (b3 ^ rk[1]), 3);
+        b2 = ror32((b1 ^ rk[2]) + (b2 ^ rk[1]), 5);
+        b1 = rol32((b0 ^ rk[0]) + (b1 ^ rk[1]), 9);
+        rk += 4;
+
+        b0 = ror32((b3 ^ rk[3]) + (b0 ^ rk[1]), 3);
+        b3 = ror32((b2 ^ rk[2]) + (b3 ^ rk[1]), 5);
+        b2 = rol32((b1 ^ rk[0]) + (b2 ^ rk[1]), 9);
+        rk += 4;
+
+        b1 = ror32((b0 ^ rk[3]) + (b1 ^ rk[1]), 3);
+        b0 = ror32((b3 ^ rk[2]) + (b0 ^ rk[1]), 5);
+        b3 = rol32((b2 ^ rk[0]) + (b3 ^ rk[1]), 9);
+        rk += 4;
+
+        b2 = ror32((b1 ^ rk[3]) + (b2 ^ rk[1]), 3);
+        b1 = ror32((b0 ^ rk[2]) + (b1 ^ rk[1]), 5);
+        b0 = rol32((b3 ^ rk[0]) + (b0 ^ rk[1]), 9);
+        rk += 4;
+    }
+
+    outblk[0] = b0;
+    outblk[1] = b1;
+    outblk[2] = b2;
+    outblk[3] = b3;
+}
+
+static FORCE_INLINE void lea_decrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+    const uint32_t* block = (const uint32_t*) in;
+    uint32_t* outblk = (uint32_t*) out;
+
+    uint32_t b0 = block[0];
+    uint32_t b1 = block[1];
+    uint32_t b2 = block[2];
+    uint32_t b3 = block[3];
+
+    rk += 4 * (rounds - 1);
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        b0 = (ror32(b0, 9) - (b3 ^ rk[0])) ^ rk[1];
+        b1 = (rol32(b1, 5) - (b0 ^ rk[2])) ^ rk[1];
+        b2 = (rol32(b2, 3) - (b1 ^ rk[3])) ^ rk[1];
+        rk -= 4;
+
+        b3 = (ror32(b3, 9) - (b2 ^ rk[0])) ^ rk[1];
+        b0 = (rol32(b0, 5) - (b3 ^ rk[2])) ^ rk[1];
+        b1 = (rol32(b1, 3) - (b0 ^ rk[3])) ^ rk[1];
+        rk -= 4;
+
+        b2 = (ror32(b2, 9) - (b1 ^ rk[0])) ^ rk[1];
+        b3 = (rol32(b3, 5) - (b2 ^ rk[2])) ^ rk[1];
+        b0 = (rol32(b0, 3) - (b3 ^ rk[3])) ^ rk[1];
+        rk -= 4;
+
+        b1 = (ror32(b1, 9) - (b0 ^ rk[0])) ^ rk[1];
+        b2 = (rol32(b2, 5) - (b1 ^ rk[2])) ^ rk[1];
+        b3 = (rol32(b3, 3) - (b2 ^ rk[3])) ^ rk[1];
+        rk -= 4;
+    }
+
+    outblk[0] = b0;
+    outblk[1] = b1;
+    outblk[2] = b2;
+    outblk[3] = b3;
+}
+
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 //! encryption / decryption for 128-bit key
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -141,6 +276,21 @@ FORCE_INLINE void lea128_decrypt(uint8_t* out, const uint8_t* in, const uint8_t*
     lea_decrypt(out, in, rks, LEA128_ROUNDS);
 }
 
+FORCE_INLINE void lea128_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_2blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_encrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_compact(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_decrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_compact(out, in, rks, LEA128_ROUNDS);
+}
+
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 //! encryption / decryption for 192-bit key
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -154,6 +304,11 @@ FORCE_INLINE void lea192_decrypt(uint8_t* out, const uint8_t* in, const uint8_t*
     lea_decrypt(out, in, rks, LEA192_ROUNDS);
 }
 
+FORCE_INLINE void lea192_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_2blk(out, in, rks, LEA192_ROUNDS);
+}
+
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 //! encryption / decryption for 256-bit key
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -166,3 +321,8 @@ FORCE_INLINE void lea256_decrypt(uint8_t* out, const uint8_t* in, const uint8_t*
 {
     lea_decrypt(out, in, rks, LEA256_ROUNDS);
 }
+
+FORCE_INLINE void lea256_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_2blk(out, in, rks, LEA256_ROUNDS);
+}
@@ -0,0 +1,389 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "lea.dispatch.h"
+#include "../tools/cpu.h"
+#include "inline.inc"
+
+#include <string.h>
+
+typedef void (*lea_block_func)(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+typedef void (*lea_ctr_func)(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+
+typedef struct st_lea_funcs {
+    lea_block_func encrypt;
+    lea_block_func decrypt;
+    lea_block_func encrypt_8blk;
+    lea_block_func decrypt_8blk;
+    lea_block_func encrypt_16blk;
+    lea_block_func decrypt_16blk;
+    lea_ctr_func ctr_blocks;
+} lea_funcs;
+
+typedef struct st_lea_backend {
+    const char* name;
+    int (*supported)(const cpu_features* cpu);
+    lea_funcs lea128;
+    lea_funcs lea192;
+    lea_funcs lea256;
+} lea_backend;
+
+#define DECLARE_LEA_FUNCS(ns, bits) \
+    void ns##_lea##bits##_encrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks); \
+    void ns##_lea##bits##_decrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks); \
+    void ns##_lea##bits##_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+
+#define DECLARE_LEA_MULTI_FUNCS(ns, bits) \
+    void ns##_lea##bits##_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks); \
+    void ns##_lea##bits##_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks); \
+    void ns##_lea##bits##_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks); \
+    void ns##_lea##bits##_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+
+#define DECLARE_LEA_CTR_FUNCS(ns, bits) \
+    void ns##_lea##bits##_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+
+// backends without multi block kernels leave them NULL
+#define LEA_FUNCS(ns, bits) { \
+    ns##_lea##bits##_encrypt, \
+    ns##_lea##bits##_decrypt, \
+    NULL, NULL, NULL, NULL, NULL, \
+}
+
+// the simd backends only have the multi block kernels, single blocks go to the portable code
+#define LEA_MULTI_FUNCS(singlens, ns, bits) { \
+    singlens##_lea##bits##_encrypt, \
+    singlens##_lea##bits##_decrypt, \
+    ns##_lea##bits##_encrypt_8blk, \
+    ns##_lea##bits##_decrypt_8blk, \
+    ns##_lea##bits##_encrypt_16blk, \
+    ns##_lea##bits##_decrypt_16blk, \
+    NULL, \
+}
+
+// AVX2 and AVX-512 also build the CTR counter blocks in registers
+#define LEA_MULTI_CTR_FUNCS(singlens, ns, bits) { \
+    singlens##_lea##bits##_encrypt, \
+    singlens##_lea##bits##_decrypt, \
+    ns##_lea##bits##_encrypt_8blk, \
+    ns##_lea##bits##_decrypt_8blk, \
+    ns##_lea##bits##_encrypt_16blk, \
+    ns##_lea##bits##_decrypt_16blk, \
+    ns##_lea##bits##_ctr_blocks, \
+}
+
+DECLARE_LEA_FUNCS(generic, 128)
+DECLARE_LEA_FUNCS(generic, 192)
+DECLARE_LEA_FUNCS(generic, 256)
+
+void generic_lea128_encrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void generic_lea128_decrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+
+DECLARE_LEA_MULTI_FUNCS(sse2, 128)
+DECLARE_LEA_MULTI_FUNCS(sse2, 192)
+DECLARE_LEA_MULTI_FUNCS(sse2, 256)
+
+DECLARE_LEA_MULTI_FUNCS(avx2, 128)
+DECLARE_LEA_MULTI_FUNCS(avx2, 192)
+DECLARE_LEA_MULTI_FUNCS(avx2, 256)
+DECLARE_LEA_CTR_FUNCS(avx2, 128)
+DECLARE_LEA_CTR_FUNCS(avx2, 192)
+DECLARE_LEA_CTR_FUNCS(avx2, 256)
+
+DECLARE_LEA_MULTI_FUNCS(avx512, 128)
+DECLARE_LEA_MULTI_FUNCS(avx512, 192)
+DECLARE_LEA_MULTI_FUNCS(avx512, 256)
+DECLARE_LEA_CTR_FUNCS(avx512, 128)
+DECLARE_LEA_CTR_FUNCS(avx512, 192)
+DECLARE_LEA_CTR_FUNCS(avx512, 256)
+
+static int generic_supported(const cpu_features* cpu)
+{
+    (void) cpu;
+    return 1;
+}
+
+static int sse2_supported(const cpu_features* cpu)
+{
+    return cpu->sse2;
+}
+
+static int avx2_supported(const cpu_features* cpu)
+{
+    return cpu->avx2;
+}
+
+static int avx512_supported(const cpu_features* cpu)
+{
+    return cpu->avx512f && cpu->avx512vl;
+}
+
+// ordered from the fastest
+static const lea_backend backends[] = {
+    {"avx512", avx512_supported, LEA_MULTI_CTR_FUNCS(generic, avx512, 128), LEA_MULTI_CTR_FUNCS(generic, avx512, 192), LEA_MULTI_CTR_FUNCS(generic, avx512, 256)},
+    {"avx2", avx2_supported, LEA_MULTI_CTR_FUNCS(generic, avx2, 128), LEA_MULTI_CTR_FUNCS(generic, avx2, 192), LEA_MULTI_CTR_FUNCS(generic, avx2, 256)},
+    {"sse2", sse2_supported, LEA_MULTI_FUNCS(generic, sse2, 128), LEA_MULTI_FUNCS(generic, sse2, 192), LEA_MULTI_FUNCS(generic, sse2, 256)},
+    {"generic", generic_supported, LEA_FUNCS(generic, 128), LEA_FUNCS(generic, 192), LEA_FUNCS(generic, 256)},
+};
+
+static const size_t NUM_BACKENDS = sizeof(backends) / sizeof(backends[0]);
+
+static const lea_backend* backend = &backends[sizeof(backends) / sizeof(backends[0]) - 1];
+
+static void __attribute__ ((constructor)) lea_dispatch_init(void)
+{
+    const cpu_features* cpu = cpu_get_features();
+
+    for (size_t i = 0; i < NUM_BACKENDS; ++i) {
+        if (backends[i].supported(cpu)) {
+            backend = &backends[i];
+            return;
+        }
+    }
+}
+
+const char* lea_backend_name(void)
+{
+    return backend->name;
+}
+
+int lea_select_backend(const char* name)
+{
+    const cpu_features* cpu = cpu_get_features();
+
+    for (size_t i = 0; i < NUM_BACKENDS; ++i) {
+        if (strcmp(backends[i].name, name) == 0 && backends[i].supported(cpu)) {
+            backend = &backends[i];
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+static FORCE_INLINE void lea_blocks(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t nblocks, lea_block_func multi, lea_block_func single)
+{
+    if (multi != NULL) {
+        multi(out, in, rks);
+        return;
+    }
+
+    for (size_t i = 0; i < nblocks; ++i) {
+        single(out + 16 * i, in + 16 * i, rks);
+    }
+}
+
+// without a multi block kernel decryption goes 2 blocks at a time, which overlaps their serial rounds
+static FORCE_INLINE void lea_decrypt_blocks(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t nblocks, lea_block_func multi, lea_block_func pair)
+{
+    if (multi != NULL) {
+        multi(out, in, rks);
+        return;
+    }
+
+    for (size_t i = 0; i < nblocks; i += 2) {
+        pair(out + 16 * i, in + 16 * i, rks);
+    }
+}
+
+static FORCE_INLINE void ctr_increment(uint8_t* ctr)
+{
+    for (size_t i = 16; i-- > 0 && ++ctr[i] == 0; ) {
+    }
+}
+
+// without a fused kernel the counter blocks are written out and encrypted 16 at a time
+static FORCE_INLINE void lea_ctr(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks, lea_ctr_func fused, lea_block_func encrypt_16blk)
+{
+    uint8_t ks[16 * 16];
+
+    if (fused != NULL) {
+        fused(dst, src, nblocks, ctr, rks);
+        return;
+    }
+
+    while (nblocks > 0) {
+        size_t n = nblocks < 16 ? nblocks : 16;
+
+        for (size_t i = 0; i < 16; ++i) {
+            memcpy(ks + 16 * i, ctr, 16);
+            if (i < n) {
+                ctr_increment(ctr);
+            }
+        }
+        encrypt_16blk(ks, ks, rks);
+
+        for (size_t i = 0; i < 16 * n; ++i) {
+            dst[i] = src[i] ^ ks[i];
+        }
+
+        dst += 16 * n;
+        src += 16 * n;
+        nblocks -= n;
+    }
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! LEA-128
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+void lea128_encrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    backend->lea128.encrypt(out, in, rks);
+}
+
+void lea128_decrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    backend->lea128.decrypt(out, in, rks);
+}
+
+void lea128_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_blocks(out, in, rks, 8, backend->lea128.encrypt_8blk, backend->lea128.encrypt);
+}
+
+void lea128_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_blocks(out, in, rks, 8, backend->lea128.decrypt_8blk, generic_lea128_decrypt_2blk);
+}
+
+void lea128_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_blocks(out, in, rks, 16, backend->lea128.encrypt_16blk, backend->lea128.encrypt);
+}
+
+void lea128_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_blocks(out, in, rks, 16, backend->lea128.decrypt_16blk, generic_lea128_decrypt_2blk);
+}
+
+void lea128_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    lea_ctr(dst, src, nblocks, ctr, rks, backend->lea128.ctr_blocks, lea128_encrypt_16blk);
+}
+
+// only the portable backend has single block functions, for every cpu
+void lea128_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    generic_lea128_decrypt_2blk(out, in, rks);
+}
+
+void lea128_encrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    generic_lea128_encrypt_compact(out, in, rks);
+}
+
+void lea128_decrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    generic_lea128_decrypt_compact(out, in, rks);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! LEA-192
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+void lea192_encrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    backend->lea192.encrypt(out, in, rks);
+}
+
+void lea192_decrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    backend->lea192.decrypt(out, in, rks);
+}
+
+void lea192_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_blocks(out, in, rks, 8, backend->lea192.encrypt_8blk, backend->lea192.encrypt);
+}
+
+void lea192_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_blocks(out, in, rks, 8, backend->lea192.decrypt_8blk, generic_lea192_decrypt_2blk);
+}
+
+void lea192_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_blocks(out, in, rks, 16, backend->lea192.encrypt_16blk, backend->lea192.encrypt);
+}
+
+void lea192_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_blocks(out, in, rks, 16, backend->lea192.decrypt_16blk, generic_lea192_decrypt_2blk);
+}
+
+void lea192_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    lea_ctr(dst, src, nblocks, ctr, rks, backend->lea192.ctr_blocks, lea192_encrypt_16blk);
+}
+
+// only the portable backend has single block functions, for every cpu
+void lea192_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    generic_lea192_decrypt_2blk(out, in, rks);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! LEA-256
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+void lea256_encrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    backend->lea256.encrypt(out, in, rks);
+}
+
+void lea256_decrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    backend->lea256.decrypt(out, in, rks);
+}
+
+void lea256_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_blocks(out, in, rks, 8, backend->lea256.encrypt_8blk, backend->lea256.encrypt);
+}
+
+void lea256_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_blocks(out, in, rks, 8, backend->lea256.decrypt_8blk, generic_lea256_decrypt_2blk);
+}
+
+void lea256_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_blocks(out, in, rks, 16, backend->lea256.encrypt_16blk, backend->lea256.encrypt);
+}
+
+void lea256_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_blocks(out, in, rks, 16, backend->lea256.decrypt_16blk, generic_lea256_decrypt_2blk);
+}
+
+void lea256_ctr_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks)
+{
+    lea_ctr(dst, src, nblocks, ctr, rks, backend->lea256.ctr_blocks, lea256_encrypt_16blk);
+}
+
+// only the portable backend has single block functions, for every cpu
+void lea256_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    generic_lea256_decrypt_2blk(out, in, rks);
+}
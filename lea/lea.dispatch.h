@@ -0,0 +1,49 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CRYPTO_PRIMITIVES_LEA_DISPATCH_H__
+#define __CRYPTO_PRIMITIVES_LEA_DISPATCH_H__
+
+#include "lea.avx2.h"
+
+/**
+ * The lea.h and lea.avx2.h block functions are bound at startup to the fastest backend
+ * the CPU supports: AVX-512, AVX2, SSE2, then the portable one, whose 8/16 block functions loop over single blocks.
+ */
+const char* lea_backend_name(void);
+
+/**
+ * Forces the backend "avx512", "avx2", "sse2" or "generic".
+ * Returns 0 on success and -1 if it is unknown or not supported by this CPU, keeping the current one.
+ * Every backend shares the key schedule of lea.keyschedule.c, so round keys stay valid across a switch.
+ * The backend is a plain global, so it is not thread-safe and must not race with any LEA call.
+ */
+int lea_select_backend(const char* name);
+
+#endif
@@ -37,10 +37,39 @@ const static size_t LEA128_ROUNDS = 24;
 const static size_t LEA192_ROUNDS = 28;
 const static size_t LEA256_ROUNDS = 32;
 
+/**
+ * The backends linked together behind the runtime dispatch (lea.dispatch.c) are built
+ * with -DLEA_NAMESPACE=<prefix>, which renames their block functions to <prefix>_lea128_encrypt and so on.
+ * The key schedule is shared by every backend and keeps its name.
+ */
+#ifdef LEA_NAMESPACE
+#define LEA_NAMESPACE_CONCAT(ns, name) ns##_##name
+#define LEA_NAMESPACE_NAME(ns, name) LEA_NAMESPACE_CONCAT(ns, name)
+
+#define lea128_encrypt LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_encrypt)
+#define lea128_decrypt LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_decrypt)
+#define lea192_encrypt LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_encrypt)
+#define lea192_decrypt LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_decrypt)
+#define lea256_encrypt LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_encrypt)
+#define lea256_decrypt LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_decrypt)
+#define lea128_decrypt_2blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_decrypt_2blk)
+#define lea192_decrypt_2blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_decrypt_2blk)
+#define lea256_decrypt_2blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_decrypt_2blk)
+#define lea128_encrypt_compact LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_encrypt_compact)
+#define lea128_decrypt_compact LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_decrypt_compact)
+#endif
+
 void lea128_keygen(uint8_t* out, const uint8_t* mk);
 void lea192_keygen(uint8_t* out, const uint8_t* mk);
 void lea256_keygen(uint8_t* out, const uint8_t* mk);
 
+/**
+ * The 6 words of a LEA-128 round key are t0, t1, t2, t1, t3, t1, so the compact schedule
+ * keeps only t0, t1, t2, t3: 4 * 4 * LEA128_ROUNDS bytes instead of 4 * 6 * LEA128_ROUNDS.
+ * LEA-192 and LEA-256 use 6 distinct words per round and have no compact form.
+ */
+void lea128_keygen_compact(uint8_t* out, const uint8_t* mk);
+
 void lea128_encrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks);
 void lea128_decrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks);
 
@@ -50,4 +79,16 @@ void lea192_decrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks);
 void lea256_encrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks);
 void lea256_decrypt(uint8_t* out, const uint8_t* in, const uint8_t* rks);
 
+/**
+ * Decryption of 2 blocks with interleaved rounds. The three steps of a decryption round depend
+ * on each other, the second block fills the latency of that chain.
+ */
+void lea128_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea192_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea256_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+
+// LEA-128 with the schedule of lea128_keygen_compact
+void lea128_encrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea128_decrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+
 #endif
\ No newline at end of file
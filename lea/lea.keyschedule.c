@@ -75,6 +75,35 @@ void lea128_keygen(uint8_t* out, const uint8_t* mk)
     }
 }
 
+/**
+ * LEA 128-bit block, 128-bit key, 4 words per round
+ */
+void lea128_keygen_compact(uint8_t* out, const uint8_t* mk)
+{
+    const uint32_t* t = (const uint32_t*) mk;
+    uint32_t* rk = (uint32_t*) out;
+    
+    uint32_t t0 = t[0];
+    uint32_t t1 = t[1];
+    uint32_t t2 = t[2];
+    uint32_t t3 = t[3];
+
+    for(size_t round = 0; round < LEA128_ROUNDS; ++round) {
+        uint32_t delta = DELTA[round & 3];
+        
+        t0 = rol32(t0 + rol32(delta, round), 1);
+        t1 = rol32(t1 + rol32(delta, round + 1), 3);
+        t2 = rol32(t2 + rol32(delta, round + 2), 6);
+        t3 = rol32(t3 + rol32(delta, round + 3), 11);
+
+        rk[0] = t0;
+        rk[1] = t1;
+        rk[2] = t2;
+        rk[3] = t3;
+        rk += 4;
+    }
+}
+
 /**
  * LEA 128-bit block, 192-bit key 
  */
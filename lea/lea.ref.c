@@ -114,6 +114,72 @@ static FORCE_INLINE void lea_decrypt(uint8_t* out, const uint8_t* in, const uint
     outblk[3] = b3;
 }
 
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! compact schedule, round key t0, t1, t2, t3 stands for t0, t1, t2, t1, t3, t1
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE void lea_encrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+    const uint32_t* block = (const uint32_t*) in;
+    uint32_t* outblk = (uint32_t*) out;
+
+    uint32_t b0 = block[0];
+    uint32_t b1 = block[1];
+    uint32_t b2 = block[2];
+    uint32_t b3 = block[3];
+
+    for (size_t round = 0; round < rounds; round += 1)
+    {
+        b3 = ror32((b2 ^ rk[3]) + (b3 ^ rk[1]), 3);
+        b2 = ror32((b1 ^ rk[2]) + (b2 ^ rk[1]), 5);
+        b1 = rol32((b0 ^ rk[0]) + (b1 ^ rk[1]), 9);
+        rk += 4;
+
+        uint32_t tmp = b0;
+        b0 = b1;
+        b1 = b2;
+        b2 = b3;
+        b3 = tmp;
+    }
+
+    outblk[0] = b0;
+    outblk[1] = b1;
+    outblk[2] = b2;
+    outblk[3] = b3;
+}
+
+static FORCE_INLINE void lea_decrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+    const uint32_t* block = (const uint32_t*) in;
+    uint32_t* outblk = (uint32_t*) out;
+
+    uint32_t b0 = block[0];
+    uint32_t b1 = block[1];
+    uint32_t b2 = block[2];
+    uint32_t b3 = block[3];
+
+    rk += 4 * (rounds - 1);
+    for (size_t round = 0; round < rounds; round += 1)
+    {
+        b0 = (ror32(b0, 9) - (b3 ^ rk[0])) ^ rk[1];
+        b1 = (rol32(b1, 5) - (b0 ^ rk[2])) ^ rk[1];
+        b2 = (rol32(b2, 3) - (b1 ^ rk[3])) ^ rk[1];
+        rk -= 4;
+
+        uint32_t tmp = b3;
+        b3 = b2;
+        b2 = b1;
+        b1 = b0;
+        b0 = tmp;
+    }
+
+    outblk[0] = b0;
+    outblk[1] = b1;
+    outblk[2] = b2;
+    outblk[3] = b3;
+}
+
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 //! encryption / decryption for 128-bit key
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -127,6 +193,22 @@ FORCE_INLINE void lea128_decrypt(uint8_t* out, const uint8_t* in, const uint8_t*
     lea_decrypt(out, in, rks, LEA128_ROUNDS);
 }
 
+FORCE_INLINE void lea128_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt(out, in, rks, LEA128_ROUNDS);
+    lea_decrypt(out + 16, in + 16, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_encrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_compact(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_decrypt_compact(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_compact(out, in, rks, LEA128_ROUNDS);
+}
+
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 //! encryption / decryption for 192-bit key
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -140,6 +222,12 @@ FORCE_INLINE void lea192_decrypt(uint8_t* out, const uint8_t* in, const uint8_t*
     lea_decrypt(out, in, rks, LEA192_ROUNDS);
 }
 
+FORCE_INLINE void lea192_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt(out, in, rks, LEA192_ROUNDS);
+    lea_decrypt(out + 16, in + 16, rks, LEA192_ROUNDS);
+}
+
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 //! encryption / decryption for 256-bit key
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -152,3 +240,9 @@ FORCE_INLINE void lea256_decrypt(uint8_t* out, const uint8_t* in, const uint8_t*
 {
     lea_decrypt(out, in, rks, LEA256_ROUNDS);
 }
+
+FORCE_INLINE void lea256_decrypt_2blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt(out, in, rks, LEA256_ROUNDS);
+    lea_decrypt(out + 16, in + 16, rks, LEA256_ROUNDS);
+}
@@ -0,0 +1,346 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "lea.sse2.h"
+
+#include <emmintrin.h>
+
+#include "inline.inc"
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! sse2 aided basic operations
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE __m128i rol32x4(__m128i value, size_t rot)
+{
+    return _mm_xor_si128(_mm_srli_epi32(value, 32 - rot), _mm_slli_epi32(value, rot));
+}
+
+static FORCE_INLINE __m128i ror32x4(__m128i value, size_t rot)
+{
+    return _mm_xor_si128(_mm_srli_epi32(value, rot), _mm_slli_epi32(value, 32 - rot));
+}
+
+static FORCE_INLINE __m128i add32x4(__m128i lhs, __m128i rhs)
+{
+    return _mm_add_epi32(lhs, rhs);
+}
+
+static FORCE_INLINE __m128i sub32x4(__m128i lhs, __m128i rhs)
+{
+    return _mm_sub_epi32(lhs, rhs);
+}
+
+static FORCE_INLINE __m128i addKey(__m128i value, uint32_t rk) 
+{
+    return _mm_xor_si128(value, _mm_set1_epi32(rk));
+}
+
+// loads 4 contiguous blocks and transposes them, so that x0..x3 hold word 0..3 of the blocks 0..3
+static FORCE_INLINE void load_transpose4(__m128i* x0, __m128i* x1, __m128i* x2, __m128i* x3, const uint8_t* in)
+{
+    __m128i v0 = _mm_loadu_si128((const __m128i*) in);
+    __m128i v1 = _mm_loadu_si128((const __m128i*) in + 1);
+    __m128i v2 = _mm_loadu_si128((const __m128i*) in + 2);
+    __m128i v3 = _mm_loadu_si128((const __m128i*) in + 3);
+
+    __m128i t0 = _mm_unpacklo_epi32(v0, v1);
+    __m128i t1 = _mm_unpackhi_epi32(v0, v1);
+    __m128i t2 = _mm_unpacklo_epi32(v2, v3);
+    __m128i t3 = _mm_unpackhi_epi32(v2, v3);
+
+    *x0 = _mm_unpacklo_epi64(t0, t2);
+    *x1 = _mm_unpackhi_epi64(t0, t2);
+    *x2 = _mm_unpacklo_epi64(t1, t3);
+    *x3 = _mm_unpackhi_epi64(t1, t3);
+}
+
+// the inverse of load_transpose4, the same unpacks put the blocks back in order
+static FORCE_INLINE void store_transpose4(uint8_t* out, __m128i x0, __m128i x1, __m128i x2, __m128i x3)
+{
+    __m128i t0 = _mm_unpacklo_epi32(x0, x1);
+    __m128i t1 = _mm_unpackhi_epi32(x0, x1);
+    __m128i t2 = _mm_unpacklo_epi32(x2, x3);
+    __m128i t3 = _mm_unpackhi_epi32(x2, x3);
+
+    _mm_storeu_si128((__m128i*) out, _mm_unpacklo_epi64(t0, t2));
+    _mm_storeu_si128((__m128i*) out + 1, _mm_unpackhi_epi64(t0, t2));
+    _mm_storeu_si128((__m128i*) out + 2, _mm_unpacklo_epi64(t1, t3));
+    _mm_storeu_si128((__m128i*) out + 3, _mm_unpackhi_epi64(t1, t3));
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! common round functions
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE void enc_round_4blk(__m128i* x0, __m128i* x1, __m128i* x2, __m128i* x3, const uint32_t* rk)
+{
+    *x3 = ror32x4(add32x4(addKey(*x2, rk[4]), addKey(*x3, rk[5])), 3);
+    *x2 = ror32x4(add32x4(addKey(*x1, rk[2]), addKey(*x2, rk[3])), 5);
+    *x1 = rol32x4(add32x4(addKey(*x0, rk[0]), addKey(*x1, rk[1])), 9);
+}
+
+static FORCE_INLINE void dec_round_4blk(__m128i* x0, __m128i* x1, __m128i* x2, __m128i* x3, const uint32_t* rk)
+{
+    *x0 = addKey(sub32x4(ror32x4(*x0, 9), addKey(*x3, rk[0])), rk[1]);
+    *x1 = addKey(sub32x4(rol32x4(*x1, 5), addKey(*x0, rk[2])), rk[3]);
+    *x2 = addKey(sub32x4(rol32x4(*x2, 3), addKey(*x1, rk[4])), rk[5]);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! common encryption functions
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE void lea_encrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m128i x0, x1, x2, x3;
+
+    load_transpose4(&x0, &x1, &x2, &x3, in);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_4blk(&x0, &x1, &x2, &x3, rk);
+        rk += 6;
+
+        enc_round_4blk(&x1, &x2, &x3, &x0, rk);        
+        rk += 6;
+
+        enc_round_4blk(&x2, &x3, &x0, &x1, rk);
+        rk += 6;
+
+        enc_round_4blk(&x3, &x0, &x1, &x2, rk);
+        rk += 6;
+    }
+
+    store_transpose4(out, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    load_transpose4(&x0, &x1, &x2, &x3, in);
+    load_transpose4(&x4, &x5, &x6, &x7, in + 64);
+    
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        enc_round_4blk(&x0, &x1, &x2, &x3, rk);
+        enc_round_4blk(&x4, &x5, &x6, &x7, rk);
+        rk += 6;
+
+        enc_round_4blk(&x1, &x2, &x3, &x0, rk);
+        enc_round_4blk(&x5, &x6, &x7, &x4, rk);
+        rk += 6;
+
+        enc_round_4blk(&x2, &x3, &x0, &x1, rk);
+        enc_round_4blk(&x6, &x7, &x4, &x5, rk);
+        rk += 6;
+
+        enc_round_4blk(&x3, &x0, &x1, &x2, rk);
+        enc_round_4blk(&x7, &x4, &x5, &x6, rk);
+        rk += 6;
+    }
+
+    store_transpose4(out, x0, x1, x2, x3);
+    store_transpose4(out + 64, x4, x5, x6, x7);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! common decryption functions
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+static FORCE_INLINE void lea_decrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m128i x0, x1, x2, x3;
+
+    load_transpose4(&x0, &x1, &x2, &x3, in);
+    
+    rk += 6 * (rounds - 1);
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        dec_round_4blk(&x0, &x1, &x2, &x3, rk);
+        rk -= 6;
+
+        dec_round_4blk(&x3, &x0, &x1, &x2, rk);
+        rk -= 6;
+
+        dec_round_4blk(&x2, &x3, &x0, &x1, rk);
+        rk -= 6;
+
+        dec_round_4blk(&x1, &x2, &x3, &x0, rk);
+        rk -= 6;
+    }
+
+    store_transpose4(out, x0, x1, x2, x3);
+}
+
+static FORCE_INLINE void lea_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    const uint32_t* rk = (const uint32_t*) rks;
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7;
+
+    load_transpose4(&x0, &x1, &x2, &x3, in);
+    load_transpose4(&x4, &x5, &x6, &x7, in + 64);
+    
+    rk += 6 * (rounds - 1);
+    for (size_t round = 0; round < rounds; round += 4)
+    {
+        dec_round_4blk(&x0, &x1, &x2, &x3, rk);
+        dec_round_4blk(&x4, &x5, &x6, &x7, rk);
+        rk -= 6;
+
+        dec_round_4blk(&x3, &x0, &x1, &x2, rk);
+        dec_round_4blk(&x7, &x4, &x5, &x6, rk);
+        rk -= 6;
+
+        dec_round_4blk(&x2, &x3, &x0, &x1, rk);
+        dec_round_4blk(&x6, &x7, &x4, &x5, rk);
+        rk -= 6;
+
+        dec_round_4blk(&x1, &x2, &x3, &x0, rk);
+        dec_round_4blk(&x5, &x6, &x7, &x4, rk);
+        rk -= 6;
+    }
+
+    store_transpose4(out, x0, x1, x2, x3);
+    store_transpose4(out + 64, x4, x5, x6, x7);
+}
+
+// 16 interleaved blocks would need all 16 xmm registers for the state alone, two runs of 8 do not spill
+static FORCE_INLINE void lea_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    lea_encrypt_8blk(out, in, rks, rounds);
+    lea_encrypt_8blk(out + 128, in + 128, rks, rounds);
+}
+
+static FORCE_INLINE void lea_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks, size_t rounds)
+{
+    lea_decrypt_8blk(out, in, rks, rounds);
+    lea_decrypt_8blk(out + 128, in + 128, rks, rounds);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! encryption / decryption for 128-bit key
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+FORCE_INLINE void lea128_encrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_4blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_decrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_4blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_8blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_8blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_16blk(out, in, rks, LEA128_ROUNDS);
+}
+
+FORCE_INLINE void lea128_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_16blk(out, in, rks, LEA128_ROUNDS);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! encryption / decryption for 192-bit key
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+FORCE_INLINE void lea192_encrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_4blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_decrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_4blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_8blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_8blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_16blk(out, in, rks, LEA192_ROUNDS);
+}
+
+FORCE_INLINE void lea192_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_16blk(out, in, rks, LEA192_ROUNDS);
+}
+
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//! encryption / decryption for 256-bit key
+//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+FORCE_INLINE void lea256_encrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_4blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_decrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_4blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_encrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_8blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_decrypt_8blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_8blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_encrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_encrypt_16blk(out, in, rks, LEA256_ROUNDS);
+}
+
+FORCE_INLINE void lea256_decrypt_16blk(uint8_t* out, const uint8_t* in, const uint8_t* rks)
+{
+    lea_decrypt_16blk(out, in, rks, LEA256_ROUNDS);
+}
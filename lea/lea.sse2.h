@@ -0,0 +1,56 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef __CRYPTO_PRIMITIVES_LEA_SSE2_H__
+#define __CRYPTO_PRIMITIVES_LEA_SSE2_H__
+
+/**
+ * lea.sse2.c implements the 8 and 16 block functions of lea.avx2.h with 128-bit SSE2 vectors,
+ * which every x86-64 has, and adds 4 blocks. 8 blocks are two interleaved groups of 4,
+ * 16 blocks two runs of 8.
+ */
+#include "lea.avx2.h"
+
+#ifdef LEA_NAMESPACE
+#define lea128_encrypt_4blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_encrypt_4blk)
+#define lea128_decrypt_4blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea128_decrypt_4blk)
+#define lea192_encrypt_4blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_encrypt_4blk)
+#define lea192_decrypt_4blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea192_decrypt_4blk)
+#define lea256_encrypt_4blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_encrypt_4blk)
+#define lea256_decrypt_4blk LEA_NAMESPACE_NAME(LEA_NAMESPACE, lea256_decrypt_4blk)
+#endif
+
+void lea128_encrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea128_decrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea192_encrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea192_decrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea256_encrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+void lea256_decrypt_4blk(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+
+#endif
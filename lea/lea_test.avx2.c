@@ -26,6 +26,11 @@
  */
 
 #include "lea.avx2.h"
+
+#ifdef LEA_TEST_DISPATCH
+#include "lea.dispatch.h"
+#endif
+
 #include <stdio.h>
 #include <string.h>
 #include <omp.h>
@@ -122,6 +127,15 @@ void test_lea128()
     lea128_decrypt_16blk(decrypted, ct, rks);
 
     print_result("LEA128", pt, encrypted, ct, decrypted, 16 * 16);
+
+    memset(encrypted, 0, sizeof(encrypted));
+    memset(decrypted, 0, sizeof(decrypted));
+    lea128_encrypt_8blk(encrypted, pt, rks);
+    lea128_encrypt_8blk(encrypted + 16 * 8, pt + 16 * 8, rks);
+    lea128_decrypt_8blk(decrypted, ct, rks);
+    lea128_decrypt_8blk(decrypted + 16 * 8, ct + 16 * 8, rks);
+
+    print_result("LEA128 8blk", pt, encrypted, ct, decrypted, 16 * 16);
 }
 
 void test_lea192() 
@@ -176,6 +190,15 @@ void test_lea192()
     lea192_decrypt_16blk(decrypted, ct, rks);
 
     print_result("LEA192", pt, encrypted, ct, decrypted, 16 * 16);
+
+    memset(encrypted, 0, sizeof(encrypted));
+    memset(decrypted, 0, sizeof(decrypted));
+    lea192_encrypt_8blk(encrypted, pt, rks);
+    lea192_encrypt_8blk(encrypted + 16 * 8, pt + 16 * 8, rks);
+    lea192_decrypt_8blk(decrypted, ct, rks);
+    lea192_decrypt_8blk(decrypted + 16 * 8, ct + 16 * 8, rks);
+
+    print_result("LEA192 8blk", pt, encrypted, ct, decrypted, 16 * 16);
 }
 
 void test_lea256() 
@@ -230,6 +253,105 @@ void test_lea256()
     lea256_decrypt_16blk(decrypted, ct, rks);
 
     print_result("LEA256", pt, encrypted, ct, decrypted, 16 * 16);
+
+    memset(encrypted, 0, sizeof(encrypted));
+    memset(decrypted, 0, sizeof(decrypted));
+    lea256_encrypt_8blk(encrypted, pt, rks);
+    lea256_encrypt_8blk(encrypted + 16 * 8, pt + 16 * 8, rks);
+    lea256_decrypt_8blk(decrypted, ct, rks);
+    lea256_decrypt_8blk(decrypted + 16 * 8, ct + 16 * 8, rks);
+
+    print_result("LEA256 8blk", pt, encrypted, ct, decrypted, 16 * 16);
+}
+
+#define MAX_CTR_BLOCKS 40
+
+typedef void (*lea_ctr_func)(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+
+static void increase_counter(uint8_t* ctr)
+{
+    int idx = 15;
+    while ( (++ctr[idx]) == 0 && idx != 0) {
+        --idx;
+    }
+}
+
+// compares lea*_ctr_blocks against the 16 block kernel on counter blocks written to memory, starting from counters
+// whose increments carry out of the low word in the middle of a batch, across the 64-bit halves and wrap around
+static void compare_ctr(const char* title, const uint8_t* rks, void (*encrypt_16blk)(uint8_t*, const uint8_t*, const uint8_t*), lea_ctr_func ctr_blocks)
+{
+    const uint8_t ivs[4][16] = {
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f},
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xff, 0xff, 0xff, 0xe9},
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8},
+        {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd},
+    };
+    uint8_t pts[16 * MAX_CTR_BLOCKS] = {0};
+    uint8_t expected[16 * (MAX_CTR_BLOCKS + 16)] = {0};
+    uint8_t enc[16 * MAX_CTR_BLOCKS] = {0};
+    uint8_t ctr[16] = {0};
+    uint8_t ref[16] = {0};
+    int out = 0;
+
+    for (size_t i = 0; i < sizeof(pts); ++i) {
+        pts[i] = (uint8_t) (i * 7 + 1);
+    }
+
+    for (size_t v = 0; v < 4; ++v) {
+        for (size_t nblocks = 1; nblocks <= MAX_CTR_BLOCKS; ++nblocks) {
+            memcpy(ref, ivs[v], 16);
+            for (size_t i = 0; i < nblocks; ++i) {
+                memcpy(expected + 16 * i, ref, 16);
+                increase_counter(ref);
+            }
+            for (size_t i = 0; i < nblocks; i += 16) {
+                encrypt_16blk(expected + 16 * i, expected + 16 * i, rks);
+            }
+
+            for (size_t i = 0; i < 16 * nblocks; ++i) {
+                expected[i] ^= pts[i];
+            }
+
+            memcpy(ctr, ivs[v], 16);
+            ctr_blocks(enc, pts, nblocks, ctr, rks);
+
+            if (memcmp(expected, enc, 16 * nblocks)) out |= 1;
+            if (memcmp(ref, ctr, 16)) out |= 2;
+        }
+    }
+
+    printf("%s (1 to %d blocks)\n", title, MAX_CTR_BLOCKS);
+
+    if (out == 0) {
+        printf("passed\n");
+    }
+
+    if (out & 0x1) {
+        printf("keystream failed\n");
+    }
+
+    if (out & 0x2) {
+        printf("counter update failed\n");
+    }
+    printf("\n");
+}
+
+void test_lea_ctr()
+{
+    uint8_t key[32] = {
+        0x0f, 0x1e, 0x2d, 0x3c, 0x4b, 0x5a, 0x69, 0x78, 0x87, 0x96, 0xa5, 0xb4, 0xc3, 0xd2, 0xe1, 0xf0,
+        0xf0, 0xe1, 0xd2, 0xc3, 0xb4, 0xa5, 0x96, 0x87, 0x78, 0x69, 0x5a, 0x4b, 0x3c, 0x2d, 0x1e, 0x0f,
+    };
+    uint8_t rks[4 * 6 * 32] = {0};
+
+    lea128_keygen(rks, key);
+    compare_ctr("LEA128 ctr", rks, lea128_encrypt_16blk, lea128_ctr_blocks);
+
+    lea192_keygen(rks, key);
+    compare_ctr("LEA192 ctr", rks, lea192_encrypt_16blk, lea192_ctr_blocks);
+
+    lea256_keygen(rks, key);
+    compare_ctr("LEA256 ctr", rks, lea256_encrypt_16blk, lea256_ctr_blocks);
 }
 
 static void benchmark_8blk(size_t iterations)
@@ -252,7 +374,7 @@ static void benchmark_8blk(size_t iterations)
 
     double elapsed = omp_get_wtime() - start;
 
-    printf("Elapsed for %ld block encryptions(avx2-8blk): %lf sec\n", 8 * iterations, elapsed);
+    printf("Elapsed for %ld block encryptions(8blk): %lf sec\n", 8 * iterations, elapsed);
 }
 
 static void benchmark_16blk(size_t iterations)
@@ -275,17 +397,79 @@ static void benchmark_16blk(size_t iterations)
 
     double elapsed = omp_get_wtime() - start;
 
-    printf("Elapsed for %ld block encryptions(avx2-16blk): %lf sec\n", 16 * iterations, elapsed);
+    printf("Elapsed for %ld block encryptions(16blk): %lf sec\n", 16 * iterations, elapsed);
 }
 
-int main()
+// CTR over 16 blocks: the counters written out, encrypted by the 16 block kernel and xored, against the fused kernel
+static void benchmark_ctr(size_t iterations)
+{
+    uint8_t mk[16] = {0};
+    uint8_t pt[16 * 16] = {0};
+    uint8_t ks[16 * 16] = {0};
+    uint8_t enc[16 * 16] = {0};
+    uint8_t ctr[16] = {0};
+
+    uint8_t rks[24 * 24] = {0,};
+    lea128_keygen(rks, mk);
+
+    double start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        for (size_t j = 0; j < 16; ++j) {
+            memcpy(ks + 16 * j, ctr, 16);
+            increase_counter(ctr);
+        }
+        lea128_encrypt_16blk(ks, ks, rks);
+        for (size_t j = 0; j < sizeof(enc); ++j) {
+            enc[j] = pt[j] ^ ks[j];
+        }
+    }
+
+    double elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld block encryptions(ctr-16blk): %lf sec\n", 16 * iterations, elapsed);
+
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        lea128_ctr_blocks(enc, pt, 16, ctr, rks);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld block encryptions(ctr-fused): %lf sec\n", 16 * iterations, elapsed);
+}
+
+static void run_tests(void)
 {
     test_lea128();
     test_lea192();
     test_lea256();
+    test_lea_ctr();
 
     benchmark_8blk(1500);
     benchmark_16blk(750);
-    
+    benchmark_ctr(750);
+}
+
+int main()
+{
+#ifdef LEA_TEST_DISPATCH
+    // every backend this cpu supports, not only the one bound at startup
+    const char* backends[] = {"avx512", "avx2", "sse2", "generic"};
+
+    for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); ++i) {
+        if (lea_select_backend(backends[i]) != 0) {
+            printf("backend %s not supported, skipped\n\n", backends[i]);
+            continue;
+        }
+
+        printf("backend %s\n\n", lea_backend_name());
+        run_tests();
+    }
+#else
+    run_tests();
+#endif
+
     return 0;
 }
\ No newline at end of file
@@ -82,6 +82,23 @@ void test_lea128()
     print_result("LEA128", pt, encrypted, ct, decrypted);
 }
 
+void test_lea128_compact() 
+{
+    uint8_t key[16] = {0x0f, 0x1e, 0x2d, 0x3c, 0x4b, 0x5a, 0x69, 0x78, 0x87, 0x96, 0xa5, 0xb4, 0xc3, 0xd2, 0xe1, 0xf0};
+    uint8_t pt[16] = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f};
+    uint8_t ct[16] = {0x9f, 0xc8, 0x4e, 0x35, 0x28, 0xc6, 0xc6, 0x18, 0x55, 0x32, 0xc7, 0xa7, 0x04, 0x64, 0x8b, 0xfd};
+    uint8_t encrypted[16] = {0,};
+    uint8_t decrypted[16] = {0,};
+
+    uint8_t rks[4 * 4 * 24] = {0};
+
+    lea128_keygen_compact(rks, key);
+    lea128_encrypt_compact(encrypted, pt, rks);
+    lea128_decrypt_compact(decrypted, ct, rks);
+
+    print_result("LEA128 compact", pt, encrypted, ct, decrypted);
+}
+
 void test_lea192() 
 {
     uint8_t key[24] = {
@@ -122,6 +139,45 @@ void test_lea256()
     print_result("LEA256", pt, encrypted, ct, decrypted);
 }
 
+typedef void (*lea_block_func)(uint8_t* out, const uint8_t* in, const uint8_t* rks);
+
+// two distinct blocks decrypted together must match the single block decryption
+static void test_decrypt_2blk(const char* title, const uint8_t* rks, lea_block_func dec2, lea_block_func dec)
+{
+    uint8_t ct[32] = {0,};
+    uint8_t expected[32] = {0,};
+    uint8_t decrypted[32] = {0,};
+
+    for (size_t i = 0; i < sizeof(ct); ++i) {
+        ct[i] = (uint8_t) (i * 7 + 1);
+    }
+
+    dec(expected, ct, rks);
+    dec(expected + 16, ct + 16, rks);
+    dec2(decrypted, ct, rks);
+
+    printf("%s\n", title);
+    printf("\tdec %s\n\n", memcmp(expected, decrypted, sizeof(expected)) == 0 ? "passed" : "failed");
+}
+
+void test_lea_decrypt_2blk()
+{
+    uint8_t key[32] = {
+        0x0f, 0x1e, 0x2d, 0x3c, 0x4b, 0x5a, 0x69, 0x78, 0x87, 0x96, 0xa5, 0xb4, 0xc3, 0xd2, 0xe1, 0xf0,
+        0xf0, 0xe1, 0xd2, 0xc3, 0xb4, 0xa5, 0x96, 0x87, 0x78, 0x69, 0x5a, 0x4b, 0x3c, 0x2d, 0x1e, 0x0f,
+    };
+    uint8_t rks[4 * 6 * 32] = {0};
+
+    lea128_keygen(rks, key);
+    test_decrypt_2blk("LEA128 2blk", rks, lea128_decrypt_2blk, lea128_decrypt);
+
+    lea192_keygen(rks, key);
+    test_decrypt_2blk("LEA192 2blk", rks, lea192_decrypt_2blk, lea192_decrypt);
+
+    lea256_keygen(rks, key);
+    test_decrypt_2blk("LEA256 2blk", rks, lea256_decrypt_2blk, lea256_decrypt);
+}
+
 static void benchmark(size_t iterations)
 {
     uint8_t mk[16] = {0};
@@ -145,13 +201,53 @@ static void benchmark(size_t iterations)
     printf("Elapsed for %ld encryptions: %lf sec\n", iterations, elapsed);
 }
 
+// independent blocks, as in ECB or CBC decryption, 1 and 2 at a time against encryption
+static void benchmark_decrypt(size_t iterations)
+{
+    static uint8_t in[4096] = {0};
+    static uint8_t out[4096] = {0};
+    uint8_t mk[16] = {0};
+    uint8_t rks[24 * 24] = {0,};
+    lea128_keygen(rks, mk);
+
+    double start = omp_get_wtime();
+    for (size_t r = 0; r < iterations; ++r) {
+        for (size_t i = 0; i < sizeof(in); i += 16) {
+            lea128_encrypt(out + i, in + i, rks);
+        }
+    }
+    double elapsed = omp_get_wtime() - start;
+    printf("Elapsed for %ld encryptions: %lf sec\n", iterations * sizeof(in) / 16, elapsed);
+
+    start = omp_get_wtime();
+    for (size_t r = 0; r < iterations; ++r) {
+        for (size_t i = 0; i < sizeof(in); i += 16) {
+            lea128_decrypt(out + i, in + i, rks);
+        }
+    }
+    elapsed = omp_get_wtime() - start;
+    printf("Elapsed for %ld decryptions: %lf sec\n", iterations * sizeof(in) / 16, elapsed);
+
+    start = omp_get_wtime();
+    for (size_t r = 0; r < iterations; ++r) {
+        for (size_t i = 0; i < sizeof(in); i += 32) {
+            lea128_decrypt_2blk(out + i, in + i, rks);
+        }
+    }
+    elapsed = omp_get_wtime() - start;
+    printf("Elapsed for %ld decryptions(2blk): %lf sec\n", iterations * sizeof(in) / 16, elapsed);
+}
+
 int main()
 {
     test_lea128();
+    test_lea128_compact();
     test_lea192();
     test_lea256();
+    test_lea_decrypt_2blk();
 
     benchmark(12000);
+    benchmark_decrypt(2000);
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,148 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "lea.avx2.h"
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+
+typedef void (*lea_keygen_func)(uint8_t* out, const uint8_t* mk);
+typedef void (*lea_keygen_x8_func)(uint8_t* const out[8], const uint8_t* const mk[8]);
+
+static void print_result(const char* title, int passed)
+{
+    printf("%s\n", title);
+    printf("\t%s\n\n", passed ? "passed" : "failed");
+}
+
+static void fill(uint8_t* buf, size_t length, uint8_t seed)
+{
+    for (size_t i = 0; i < length; ++i) {
+        buf[i] = (uint8_t) (seed + i * 13);
+    }
+}
+
+// 8 distinct keys expanded at once must give the schedules of the single key functions
+static void test_keygen_x8(const char* title, size_t keylen, size_t rkslen, lea_keygen_func keygen, lea_keygen_x8_func keygen_x8)
+{
+    uint8_t keys[8][32];
+    uint8_t expected[8][4 * 6 * 32];
+    uint8_t actual[8][4 * 6 * 32];
+    const uint8_t* mk[8];
+    uint8_t* out[8];
+
+    for (size_t i = 0; i < 8; ++i) {
+        fill(keys[i], keylen, (uint8_t) (17 * i + 1));
+        keygen(expected[i], keys[i]);
+        mk[i] = keys[i];
+        out[i] = actual[i];
+    }
+    keygen_x8(out, mk);
+
+    int passed = 1;
+    for (size_t i = 0; i < 8; ++i) {
+        passed &= memcmp(expected[i], actual[i], rkslen) == 0;
+    }
+
+    print_result(title, passed);
+}
+
+// the compact kernels against the 6 word kernels, on distinct blocks
+static void test_compact()
+{
+    uint8_t key[16];
+    uint8_t rks[4 * 6 * 24];
+    uint8_t crks[4 * 4 * 24];
+    uint8_t pt[16 * 16];
+    uint8_t ct[16 * 16];
+    uint8_t encrypted[16 * 16];
+    uint8_t decrypted[16 * 16];
+
+    fill(key, sizeof(key), 0x0f);
+    fill(pt, sizeof(pt), 0x10);
+    lea128_keygen(rks, key);
+    lea128_keygen_compact(crks, key);
+    lea128_encrypt_16blk(ct, pt, rks);
+
+    lea128_encrypt_compact_8blk(encrypted, pt, crks);
+    lea128_decrypt_compact_8blk(decrypted, ct, crks);
+    print_result("LEA128 compact 8blk", memcmp(encrypted, ct, 16 * 8) == 0 && memcmp(decrypted, pt, 16 * 8) == 0);
+
+    lea128_encrypt_compact_16blk(encrypted, pt, crks);
+    lea128_decrypt_compact_16blk(decrypted, ct, crks);
+    print_result("LEA128 compact 16blk", memcmp(encrypted, ct, sizeof(ct)) == 0 && memcmp(decrypted, pt, sizeof(pt)) == 0);
+}
+
+static void benchmark_keygen(size_t iterations)
+{
+    uint8_t keys[8][16] = {{0}};
+    uint8_t rks[8][4 * 6 * 24];
+    const uint8_t* mk[8];
+    uint8_t* out[8];
+
+    for (size_t i = 0; i < 8; ++i) {
+        keys[i][0] = (uint8_t) i;
+        mk[i] = keys[i];
+        out[i] = rks[i];
+    }
+
+    double start = omp_get_wtime();
+    for (size_t i = 0; i < iterations; ++i) {
+        for (size_t k = 0; k < 8; ++k) {
+            lea128_keygen(out[k], mk[k]);
+        }
+    }
+    double elapsed = omp_get_wtime() - start;
+    printf("Elapsed for %ld key schedules(scalar): %lf sec\n", 8 * iterations, elapsed);
+
+    start = omp_get_wtime();
+    for (size_t i = 0; i < iterations; ++i) {
+        lea128_keygen_x8(out, mk);
+    }
+    elapsed = omp_get_wtime() - start;
+    printf("Elapsed for %ld key schedules(avx2-x8): %lf sec\n", 8 * iterations, elapsed);
+
+    start = omp_get_wtime();
+    for (size_t i = 0; i < iterations; ++i) {
+        lea128_keygen_compact_x8(out, mk);
+    }
+    elapsed = omp_get_wtime() - start;
+    printf("Elapsed for %ld key schedules(avx2-compact-x8): %lf sec\n", 8 * iterations, elapsed);
+}
+
+int main()
+{
+    test_keygen_x8("LEA128 keygen x8", 16, 4 * 6 * 24, lea128_keygen, lea128_keygen_x8);
+    test_keygen_x8("LEA192 keygen x8", 24, 4 * 6 * 28, lea192_keygen, lea192_keygen_x8);
+    test_keygen_x8("LEA256 keygen x8", 32, 4 * 6 * 32, lea256_keygen, lea256_keygen_x8);
+    test_keygen_x8("LEA128 compact keygen x8", 16, 4 * 4 * 24, lea128_keygen_compact, lea128_keygen_compact_x8);
+    test_compact();
+
+    benchmark_keygen(100000);
+
+    return 0;
+}
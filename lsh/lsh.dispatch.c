@@ -0,0 +1,205 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "lsh.dispatch.h"
+#include "../tools/cpu.h"
+
+#include <string.h>
+
+typedef struct st_lsh_backend {
+    const char* name;
+    int (*supported)(const cpu_features* cpu);
+    void (*lsh256_init)(lsh256_context* ctx);
+    void (*lsh256_update)(lsh256_context* ctx, const uint8_t* data, size_t length);
+    void (*lsh256_final)(lsh256_context* ctx, uint8_t* digest);
+    void (*lsh512_init)(lsh512_context* ctx);
+    void (*lsh512_update)(lsh512_context* ctx, const uint8_t* data, size_t length);
+    void (*lsh512_final)(lsh512_context* ctx, uint8_t* digest);
+    void (*lsh256_init_compact)(lsh256_compact_context* ctx);
+    void (*lsh256_update_compact)(lsh256_compact_context* ctx, const uint8_t* data, size_t length);
+    void (*lsh256_final_compact)(lsh256_compact_context* ctx, uint8_t* digest);
+    void (*lsh512_init_compact)(lsh512_compact_context* ctx);
+    void (*lsh512_update_compact)(lsh512_compact_context* ctx, const uint8_t* data, size_t length);
+    void (*lsh512_final_compact)(lsh512_compact_context* ctx, uint8_t* digest);
+    void (*lsh256_hash_x8)(uint8_t* const digests[8], const uint8_t* const msgs[8], const size_t lens[8]);
+    void (*lsh512_hash_x4)(uint8_t* const digests[4], const uint8_t* const msgs[4], const size_t lens[4]);
+} lsh_backend;
+
+#define DECLARE_LSH_BACKEND(ns) \
+    void ns##_lsh256_init(lsh256_context* ctx); \
+    void ns##_lsh256_update(lsh256_context* ctx, const uint8_t* data, size_t length); \
+    void ns##_lsh256_final(lsh256_context* ctx, uint8_t* digest); \
+    void ns##_lsh512_init(lsh512_context* ctx); \
+    void ns##_lsh512_update(lsh512_context* ctx, const uint8_t* data, size_t length); \
+    void ns##_lsh512_final(lsh512_context* ctx, uint8_t* digest); \
+    void ns##_lsh256_init_compact(lsh256_compact_context* ctx); \
+    void ns##_lsh256_update_compact(lsh256_compact_context* ctx, const uint8_t* data, size_t length); \
+    void ns##_lsh256_final_compact(lsh256_compact_context* ctx, uint8_t* digest); \
+    void ns##_lsh512_init_compact(lsh512_compact_context* ctx); \
+    void ns##_lsh512_update_compact(lsh512_compact_context* ctx, const uint8_t* data, size_t length); \
+    void ns##_lsh512_final_compact(lsh512_compact_context* ctx, uint8_t* digest); \
+    void ns##_lsh256_hash_x8(uint8_t* const digests[8], const uint8_t* const msgs[8], const size_t lens[8]); \
+    void ns##_lsh512_hash_x4(uint8_t* const digests[4], const uint8_t* const msgs[4], const size_t lens[4]);
+
+#define LSH_FUNCS(ns) \
+    ns##_lsh256_init, ns##_lsh256_update, ns##_lsh256_final, \
+    ns##_lsh512_init, ns##_lsh512_update, ns##_lsh512_final, \
+    ns##_lsh256_init_compact, ns##_lsh256_update_compact, ns##_lsh256_final_compact, \
+    ns##_lsh512_init_compact, ns##_lsh512_update_compact, ns##_lsh512_final_compact, \
+    ns##_lsh256_hash_x8, ns##_lsh512_hash_x4
+
+DECLARE_LSH_BACKEND(generic)
+DECLARE_LSH_BACKEND(sse4)
+DECLARE_LSH_BACKEND(avx2)
+
+static int generic_supported(const cpu_features* cpu)
+{
+    (void) cpu;
+    return 1;
+}
+
+static int sse4_supported(const cpu_features* cpu)
+{
+    return cpu->ssse3 && cpu->sse41 && cpu->sse42;
+}
+
+static int avx2_supported(const cpu_features* cpu)
+{
+    return cpu->avx2;
+}
+
+// ordered from the fastest
+static const lsh_backend backends[] = {
+    {"avx2", avx2_supported, LSH_FUNCS(avx2)},
+    {"sse4", sse4_supported, LSH_FUNCS(sse4)},
+    {"generic", generic_supported, LSH_FUNCS(generic)},
+};
+
+static const size_t NUM_BACKENDS = sizeof(backends) / sizeof(backends[0]);
+
+static const lsh_backend* backend = &backends[sizeof(backends) / sizeof(backends[0]) - 1];
+
+static void __attribute__ ((constructor)) lsh_dispatch_init(void)
+{
+    const cpu_features* cpu = cpu_get_features();
+
+    for (size_t i = 0; i < NUM_BACKENDS; ++i) {
+        if (backends[i].supported(cpu)) {
+            backend = &backends[i];
+            return;
+        }
+    }
+}
+
+const char* lsh_backend_name(void)
+{
+    return backend->name;
+}
+
+int lsh_select_backend(const char* name)
+{
+    const cpu_features* cpu = cpu_get_features();
+
+    for (size_t i = 0; i < NUM_BACKENDS; ++i) {
+        if (strcmp(backends[i].name, name) == 0 && backends[i].supported(cpu)) {
+            backend = &backends[i];
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+void lsh256_init(lsh256_context* ctx)
+{
+    backend->lsh256_init(ctx);
+}
+
+void lsh256_update(lsh256_context* ctx, const uint8_t* data, size_t length)
+{
+    backend->lsh256_update(ctx, data, length);
+}
+
+void lsh256_final(lsh256_context* ctx, uint8_t* digest)
+{
+    backend->lsh256_final(ctx, digest);
+}
+
+void lsh512_init(lsh512_context* ctx)
+{
+    backend->lsh512_init(ctx);
+}
+
+void lsh512_update(lsh512_context* ctx, const uint8_t* data, size_t length)
+{
+    backend->lsh512_update(ctx, data, length);
+}
+
+void lsh512_final(lsh512_context* ctx, uint8_t* digest)
+{
+    backend->lsh512_final(ctx, digest);
+}
+
+void lsh256_init_compact(lsh256_compact_context* ctx)
+{
+    backend->lsh256_init_compact(ctx);
+}
+
+void lsh256_update_compact(lsh256_compact_context* ctx, const uint8_t* data, size_t length)
+{
+    backend->lsh256_update_compact(ctx, data, length);
+}
+
+void lsh256_final_compact(lsh256_compact_context* ctx, uint8_t* digest)
+{
+    backend->lsh256_final_compact(ctx, digest);
+}
+
+void lsh512_init_compact(lsh512_compact_context* ctx)
+{
+    backend->lsh512_init_compact(ctx);
+}
+
+void lsh512_update_compact(lsh512_compact_context* ctx, const uint8_t* data, size_t length)
+{
+    backend->lsh512_update_compact(ctx, data, length);
+}
+
+void lsh512_final_compact(lsh512_compact_context* ctx, uint8_t* digest)
+{
+    backend->lsh512_final_compact(ctx, digest);
+}
+
+void lsh256_hash_x8(uint8_t* const digests[8], const uint8_t* const msgs[8], const size_t lens[8])
+{
+    backend->lsh256_hash_x8(digests, msgs, lens);
+}
+
+void lsh512_hash_x4(uint8_t* const digests[4], const uint8_t* const msgs[4], const size_t lens[4])
+{
+    backend->lsh512_hash_x4(digests, msgs, lens);
+}
@@ -0,0 +1,45 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "lsh.h"
+
+/**
+ * The lsh.h functions are bound at startup to the fastest backend the CPU supports:
+ * AVX2, SSE4 and the portable one, in that order.
+ * A context must be finished by the backend which initialized it.
+ */
+const char* lsh_backend_name(void);
+
+/**
+ * Forces the backend "avx2", "sse4" or "generic".
+ * Returns 0 on success and -1 if it is unknown or not supported by this CPU, keeping the current one.
+ * It must be called before any context is initialized, since a context is only valid for its backend.
+ * The backend is a plain global, so it is not thread-safe and must not race with any lsh.h call.
+ */
+int lsh_select_backend(const char* name);
@@ -30,6 +30,31 @@
 #include <stdint.h>
 #include <stddef.h>
 
+/**
+ * The backends linked together behind the runtime dispatch (lsh.dispatch.c) are built
+ * with -DLSH_NAMESPACE=<prefix>, which renames their functions to <prefix>_lsh256_init and so on.
+ * The contexts are shared by every backend.
+ */
+#ifdef LSH_NAMESPACE
+#define LSH_NAMESPACE_CONCAT(ns, name) ns##_##name
+#define LSH_NAMESPACE_NAME(ns, name) LSH_NAMESPACE_CONCAT(ns, name)
+
+#define lsh256_init LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh256_init)
+#define lsh256_update LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh256_update)
+#define lsh256_final LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh256_final)
+#define lsh512_init LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh512_init)
+#define lsh512_update LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh512_update)
+#define lsh512_final LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh512_final)
+#define lsh256_init_compact LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh256_init_compact)
+#define lsh256_update_compact LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh256_update_compact)
+#define lsh256_final_compact LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh256_final_compact)
+#define lsh512_init_compact LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh512_init_compact)
+#define lsh512_update_compact LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh512_update_compact)
+#define lsh512_final_compact LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh512_final_compact)
+#define lsh256_hash_x8 LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh256_hash_x8)
+#define lsh512_hash_x4 LSH_NAMESPACE_NAME(LSH_NAMESPACE, lsh512_hash_x4)
+#endif
+
 typedef struct st_lsh256_context {
     size_t bidx;
     size_t length;
@@ -48,6 +73,25 @@ typedef struct st_lsh512_context {
     __attribute__ ((aligned(32))) uint64_t msg[16 * (28 + 1)];
 } lsh512_context;
 
+/**
+ * Contexts without the expanded message schedule, which the *_compact functions compute
+ * on the fly through a window of 3 blocks on the stack: 224 and 416 bytes instead of about 2 and 4 KB.
+ * They give the same digests as lsh256_context and lsh512_context.
+ */
+typedef struct st_lsh256_compact_context {
+    size_t bidx;
+    size_t length;
+    __attribute__ ((aligned(32))) uint8_t block[128];
+    __attribute__ ((aligned(32))) uint32_t cv[16];
+} lsh256_compact_context;
+
+typedef struct st_lsh512_compact_context {
+    size_t bidx;
+    size_t length;
+    __attribute__ ((aligned(32))) uint8_t block[256];
+    __attribute__ ((aligned(32))) uint64_t cv[16];
+} lsh512_compact_context;
+
 void lsh256_init(lsh256_context* ctx);
 void lsh256_update(lsh256_context* ctx, const uint8_t* data, size_t length);
 void lsh256_final(lsh256_context* ctx, uint8_t* digest);
@@ -55,3 +99,19 @@ void lsh256_final(lsh256_context* ctx, uint8_t* digest);
 void lsh512_init(lsh512_context* ctx);
 void lsh512_update(lsh512_context* ctx, const uint8_t* data, size_t length);
 void lsh512_final(lsh512_context* ctx, uint8_t* digest);
+
+void lsh256_init_compact(lsh256_compact_context* ctx);
+void lsh256_update_compact(lsh256_compact_context* ctx, const uint8_t* data, size_t length);
+void lsh256_final_compact(lsh256_compact_context* ctx, uint8_t* digest);
+
+void lsh512_init_compact(lsh512_compact_context* ctx);
+void lsh512_update_compact(lsh512_compact_context* ctx, const uint8_t* data, size_t length);
+void lsh512_final_compact(lsh512_compact_context* ctx, uint8_t* digest);
+
+/**
+ * Hashes 8 (LSH-256) or 4 (LSH-512) independent messages of any lengths, digests[i] = LSH(msgs[i], lens[i]).
+ * The AVX2 backend runs one message in each lane of the registers, for as many blocks as the longest
+ * message, so messages of similar lengths should be grouped together. The others hash them one by one.
+ */
+void lsh256_hash_x8(uint8_t* const digests[8], const uint8_t* const msgs[8], const size_t lens[8]);
+void lsh512_hash_x4(uint8_t* const digests[4], const uint8_t* const msgs[4], const size_t lens[4]);
@@ -97,6 +97,20 @@ static inline __m256i rol32(__m256i value, size_t rot)
     return _mm256_slli_epi32(value, rot) | _mm256_srli_epi32(value, (32 - rot));
 }
 
+// the next block of the expanded message from the previous two, m1 = M[i - 1] and m0 = M[i - 2]
+static inline void expand_block(__m256i* msg, const __m256i* m1, const __m256i* m0)
+{
+    __m256i ctrl = _mm256_loadu_si256((__m256i*) MSGEXP_SHUFFLE);
+
+    msg[0] = _mm256_add_epi32(
+        m1[0], _mm256_shuffle_epi8(m0[0], ctrl)
+    );
+    
+    msg[1] = _mm256_add_epi32(
+        m1[1], _mm256_shuffle_epi8(m0[1], ctrl)
+    );
+}
+
 static void expand_message(lsh256_avx2_context* ctx, const uint8_t* in)
 {
     __m256i* msg = ctx->msg;    
@@ -105,30 +119,25 @@ static void expand_message(lsh256_avx2_context* ctx, const uint8_t* in)
     msg[2] = _mm256_loadu_si256((__m256i*) in + 2);
     msg[3] = _mm256_loadu_si256((__m256i*) in + 3);
 
-    __m256i ctrl = _mm256_loadu_si256((__m256i*) MSGEXP_SHUFFLE);
-
     for (size_t i = 2; i <= NUMSTEP; ++i) {
         size_t idx = 2 * i;
-
-        msg[idx] = _mm256_add_epi32(
-            msg[idx - 2], _mm256_shuffle_epi8(msg[idx - 4], ctrl)
-        );
-        
-        msg[idx + 1] = _mm256_add_epi32(
-            msg[idx - 1], _mm256_shuffle_epi8(msg[idx - 3], ctrl)
-        );
+        expand_block(msg + idx, msg + idx - 2, msg + idx - 4);
     }
 }
 
-static inline void permute_word(lsh256_avx2_context* ctx)
+static inline void permute_word(__m256i* cv, __m256i* tcv)
 {
-    ctx->tcv[0] = _mm256_shuffle_epi32(ctx->tcv[0], _MM_SHUFFLE(3,1,0,2));
-    ctx->tcv[1] = _mm256_shuffle_epi32(ctx->tcv[1], _MM_SHUFFLE(1,2,3,0));
-    ctx->cv[0] = _mm256_permute2x128_si256(ctx->tcv[0], ctx->tcv[1], 0x31);
-    ctx->cv[1] = _mm256_permute2x128_si256(ctx->tcv[0], ctx->tcv[1], 0x20);
+    __m256i t0 = _mm256_shuffle_epi32(tcv[0], _MM_SHUFFLE(3,1,0,2));
+    __m256i t1 = _mm256_shuffle_epi32(tcv[1], _MM_SHUFFLE(1,2,3,0));
+
+    tcv[0] = t0;
+    tcv[1] = t1;
+    cv[0] = _mm256_permute2x128_si256(t0, t1, 0x31);
+    cv[1] = _mm256_permute2x128_si256(t0, t1, 0x20);
 }
 
-static void step(lsh256_avx2_context* ctx, size_t idx, uint32_t alpha, uint32_t beta)
+// msg is the block of the expanded message for step idx
+static void step(__m256i* cv, __m256i* tcv, const __m256i* msg, size_t idx, uint32_t alpha, uint32_t beta)
 {
     __m256i vl, vr;
     __m256i step_constant, gamma;
@@ -136,16 +145,16 @@ static void step(lsh256_avx2_context* ctx, size_t idx, uint32_t alpha, uint32_t
     step_constant = _mm256_loadu_si256((const __m256i*) STEP_CONSTANT + idx);
     gamma = _mm256_loadu_si256((const __m256i*) GAMMA);
 
-    vl = ctx->cv[0] ^ ctx->msg[2 * idx    ];
-    vr = ctx->cv[1] ^ ctx->msg[2 * idx + 1];
+    vl = cv[0] ^ msg[0];
+    vr = cv[1] ^ msg[1];
 
     vl = rol32(_mm256_add_epi32(vl, vr), alpha) ^ step_constant;
     vr = rol32(_mm256_add_epi32(vl, vr), beta);
     
-    ctx->tcv[0] = _mm256_add_epi32(vl, vr);
-    ctx->tcv[1] = _mm256_shuffle_epi8(vr, gamma);
+    tcv[0] = _mm256_add_epi32(vl, vr);
+    tcv[1] = _mm256_shuffle_epi8(vr, gamma);
 
-    permute_word(ctx);
+    permute_word(cv, tcv);
 }
 
 static void compress(lsh256_avx2_context* ctx, const uint8_t* data)
@@ -153,8 +162,8 @@ static void compress(lsh256_avx2_context* ctx, const uint8_t* data)
     expand_message(ctx, data);
 
     for (size_t i = 0; i < NUMSTEP; i += 2) {
-        step(ctx, i, ALPHA_EVEN, BETA_EVEN);
-        step(ctx, i + 1, ALPHA_ODD, BETA_ODD);
+        step(ctx->cv, ctx->tcv, ctx->msg + 2 * i, i, ALPHA_EVEN, BETA_EVEN);
+        step(ctx->cv, ctx->tcv, ctx->msg + 2 * (i + 1), i + 1, ALPHA_ODD, BETA_ODD);
     }
 
     for (size_t i = 0; i < 2; ++i) {
@@ -162,6 +171,36 @@ static void compress(lsh256_avx2_context* ctx, const uint8_t* data)
     }
 }
 
+/**
+ * compress with the message expanded on the fly: block i only depends on the blocks i - 1 and i - 2,
+ * so it rolls through a window of 3 blocks on the stack instead of the 27 blocks of the context.
+ */
+static void compress_rolling(__m256i* cv, const uint8_t* data)
+{
+    __m256i window[3][2];
+    __m256i tcv[2];
+
+    for (size_t i = 0; i < 4; ++i) {
+        window[i / 2][i % 2] = _mm256_loadu_si256((__m256i*) data + i);
+    }
+
+    for (size_t i = 0; i < NUMSTEP; i += 2) {
+        if (i > 0) {
+            expand_block(window[i % 3], window[(i + 2) % 3], window[(i + 1) % 3]);
+            expand_block(window[(i + 1) % 3], window[i % 3], window[(i + 2) % 3]);
+        }
+
+        step(cv, tcv, window[i % 3], i, ALPHA_EVEN, BETA_EVEN);
+        step(cv, tcv, window[(i + 1) % 3], i + 1, ALPHA_ODD, BETA_ODD);
+    }
+
+    expand_block(window[NUMSTEP % 3], window[(NUMSTEP + 2) % 3], window[(NUMSTEP + 1) % 3]);
+
+    for (size_t i = 0; i < 2; ++i) {
+        cv[i] ^= window[NUMSTEP % 3][i];
+    }
+}
+
 void lsh256_init(lsh256_context* ctx)
 {
     ctx->bidx = 0;
@@ -220,4 +259,264 @@ void lsh256_final(lsh256_context* ctx, uint8_t* digest)
     }
 
     lsh256_init(ctx);
-}
\ No newline at end of file
+}
+
+void lsh256_init_compact(lsh256_compact_context* ctx)
+{
+    ctx->bidx = 0;
+    ctx->length = 0;
+    memset(ctx->block, 0, BLOCKSIZE);
+
+    memcpy(ctx->cv, IV, 16 * sizeof(uint32_t));
+}
+
+void lsh256_update_compact(lsh256_compact_context* ctx, const uint8_t* data, size_t length)
+{
+    ctx->length += length;
+
+    if (ctx->bidx > 0) {
+        size_t gap = BLOCKSIZE - ctx->bidx;
+
+        if (length >= gap) {
+            memcpy(ctx->block + ctx->bidx, data, gap);
+            compress_rolling((__m256i*) ctx->cv, ctx->block);
+            ctx->bidx = 0;
+            data += gap;
+            length -= gap;
+
+        } else {
+            memcpy(ctx->block + ctx->bidx, data, length);
+            ctx->bidx += length;
+            data += length;
+            length = 0;
+        }
+    }
+    
+    while (length >= BLOCKSIZE) {
+        compress_rolling((__m256i*) ctx->cv, data);
+        data += BLOCKSIZE;
+        length -= BLOCKSIZE;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->block + ctx->bidx, data, length);
+        ctx->bidx += length;
+    }
+}
+
+void lsh256_final_compact(lsh256_compact_context* ctx, uint8_t* digest)
+{
+    uint32_t* result = (uint32_t*) digest;
+
+    ctx->block[(ctx->bidx)++] = (uint8_t) 0x80;
+    memset(ctx->block + ctx->bidx, 0, BLOCKSIZE - ctx->bidx);
+    compress_rolling((__m256i*) ctx->cv, ctx->block);
+
+    for (size_t i = 0; i < 8; ++i) {
+        result[i] = ctx->cv[i] ^ ctx->cv[i + 8];
+    }
+
+    lsh256_init_compact(ctx);
+}
+
+/**
+ * Multi-message hashing: 8 independent messages, one in each 32-bit lane of the registers.
+ * The state is kept transposed, cv[j] holds word j of every lane, so a step is the scalar
+ * step with each word replaced by a register, and the word permutation only decides where it stores them.
+ */
+const static size_t LANES = 8;
+
+// the rotations by gamma of each column are by whole bytes, done as byte shuffles
+const static __attribute__ ((aligned(32))) uint32_t GAMMA_X8[8][8] = {
+    {0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c, 0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c},
+    {0x02010003, 0x06050407, 0x0a09080b, 0x0e0d0c0f, 0x02010003, 0x06050407, 0x0a09080b, 0x0e0d0c0f},
+    {0x01000302, 0x05040706, 0x09080b0a, 0x0d0c0f0e, 0x01000302, 0x05040706, 0x09080b0a, 0x0d0c0f0e},
+    {0x00030201, 0x04070605, 0x080b0a09, 0x0c0f0e0d, 0x00030201, 0x04070605, 0x080b0a09, 0x0c0f0e0d},
+    {0x00030201, 0x04070605, 0x080b0a09, 0x0c0f0e0d, 0x00030201, 0x04070605, 0x080b0a09, 0x0c0f0e0d},
+    {0x01000302, 0x05040706, 0x09080b0a, 0x0d0c0f0e, 0x01000302, 0x05040706, 0x09080b0a, 0x0d0c0f0e},
+    {0x02010003, 0x06050407, 0x0a09080b, 0x0e0d0c0f, 0x02010003, 0x06050407, 0x0a09080b, 0x0e0d0c0f},
+    {0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c, 0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c},
+};
+
+// the word permutation as the position each word moves to, cv[WORD_DEST[j]] = tcv[j]
+const static size_t WORD_DEST[] = {9, 10, 8, 11, 1, 2, 0, 3, 12, 15, 14, 13, 4, 7, 6, 5};
+
+const static size_t MSGEXP_TAU[] = {3, 2, 0, 1, 7, 4, 5, 6, 11, 10, 8, 9, 15, 12, 13, 14};
+
+/**
+ * Lane scheduler: a lane reads the whole blocks of its message in place and then its
+ * padded last block, copied here. A lane whose message is done keeps hashing its last block
+ * with the chaining value update masked off until the longest message is done.
+ */
+typedef struct st_lsh256_lanes {
+    const uint8_t* data[8];
+    size_t nblocks[8];
+    __attribute__ ((aligned(32))) uint8_t last[8][128];
+} lsh256_lanes;
+
+static void schedule_lanes(lsh256_lanes* lanes, const uint8_t* const msgs[8], const size_t lens[8], size_t* total)
+{
+    *total = 0;
+
+    for (size_t l = 0; l < LANES; ++l) {
+        size_t rest = lens[l] % BLOCKSIZE;
+
+        lanes->data[l] = msgs[l];
+        lanes->nblocks[l] = lens[l] / BLOCKSIZE;
+
+        if (rest > 0) {
+            memcpy(lanes->last[l], msgs[l] + lens[l] - rest, rest);
+        }
+        lanes->last[l][rest] = (uint8_t) 0x80;
+        memset(lanes->last[l] + rest + 1, 0, BLOCKSIZE - rest - 1);
+
+        if (lanes->nblocks[l] + 1 > *total) {
+            *total = lanes->nblocks[l] + 1;
+        }
+    }
+}
+
+static inline const uint8_t* lane_block(const lsh256_lanes* lanes, size_t l, size_t t)
+{
+    return t < lanes->nblocks[l] ? lanes->data[l] + BLOCKSIZE * t : lanes->last[l];
+}
+
+// rows r[l] = words 0..7 of lane l become r[j] = word j of lanes 0..7
+static inline void transpose8(__m256i* r)
+{
+    __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// M0 into window[0] and M1 into window[1], word k of every lane in msg[k]
+static void load_message_x8(__m256i window[][16], const lsh256_lanes* lanes, size_t t)
+{
+    for (size_t c = 0; c < 4; ++c) {
+        __m256i* msg = window[c / 2] + 8 * (c % 2);
+
+        for (size_t l = 0; l < LANES; ++l) {
+            msg[l] = _mm256_loadu_si256((const __m256i*) lane_block(lanes, l, t) + c);
+        }
+        transpose8(msg);
+    }
+}
+
+// the next 16 expanded words from the previous two, m1 = M[i - 1] and m0 = M[i - 2]
+static inline void expand_message_x8(__m256i* out, const __m256i* m1, const __m256i* m0)
+{
+    for (size_t k = 0; k < 16; ++k) {
+        out[k] = _mm256_add_epi32(m1[k], m0[MSGEXP_TAU[k]]);
+    }
+}
+
+static inline void column_x8(__m256i* out, const __m256i* in, const __m256i* msg, size_t idx, size_t col, uint32_t alpha, uint32_t beta)
+{
+    __m256i vl, vr;
+
+    vl = in[col    ] ^ msg[col    ];
+    vr = in[col + 8] ^ msg[col + 8];
+
+    vl = rol32(_mm256_add_epi32(vl, vr), alpha) ^ _mm256_set1_epi32(STEP_CONSTANT[8 * idx + col]);
+    vr = rol32(_mm256_add_epi32(vl, vr), beta);
+
+    out[WORD_DEST[col]] = _mm256_add_epi32(vl, vr);
+    out[WORD_DEST[col + 8]] = _mm256_shuffle_epi8(vr, _mm256_load_si256((const __m256i*) GAMMA_X8[col]));
+}
+
+// out is the permuted state after the step on in, the two alternate instead of copying the permutation
+static inline void step_x8(__m256i* out, const __m256i* in, const __m256i* msg, size_t idx, uint32_t alpha, uint32_t beta)
+{
+    column_x8(out, in, msg, idx, 0, alpha, beta);
+    column_x8(out, in, msg, idx, 1, alpha, beta);
+    column_x8(out, in, msg, idx, 2, alpha, beta);
+    column_x8(out, in, msg, idx, 3, alpha, beta);
+    column_x8(out, in, msg, idx, 4, alpha, beta);
+    column_x8(out, in, msg, idx, 5, alpha, beta);
+    column_x8(out, in, msg, idx, 6, alpha, beta);
+    column_x8(out, in, msg, idx, 7, alpha, beta);
+}
+
+// the expanded message is rolled through a window of 3 blocks instead of being stored whole
+static void compress_x8(__m256i* cv, const lsh256_lanes* lanes, size_t t, __m256i active)
+{
+    __m256i window[3][16];
+    __m256i state[16];
+    __m256i tmp[16];
+
+    load_message_x8(window, lanes, t);
+
+    for (size_t i = 0; i < NUMSTEP; i += 2) {
+        if (i > 0) {
+            expand_message_x8(window[i % 3], window[(i + 2) % 3], window[(i + 1) % 3]);
+        }
+        step_x8(tmp, i == 0 ? cv : state, window[i % 3], i, ALPHA_EVEN, BETA_EVEN);
+
+        if (i > 0) {
+            expand_message_x8(window[(i + 1) % 3], window[i % 3], window[(i + 2) % 3]);
+        }
+        step_x8(state, tmp, window[(i + 1) % 3], i + 1, ALPHA_ODD, BETA_ODD);
+    }
+
+    expand_message_x8(window[NUMSTEP % 3], window[(NUMSTEP + 2) % 3], window[(NUMSTEP + 1) % 3]);
+
+    for (size_t i = 0; i < 16; ++i) {
+        cv[i] = _mm256_blendv_epi8(cv[i], state[i] ^ window[NUMSTEP % 3][i], active);
+    }
+}
+
+void lsh256_hash_x8(uint8_t* const digests[8], const uint8_t* const msgs[8], const size_t lens[8])
+{
+    lsh256_lanes lanes;
+    __m256i cv[16];
+    __m256i result[8];
+    size_t total;
+
+    schedule_lanes(&lanes, msgs, lens, &total);
+
+    for (size_t i = 0; i < 16; ++i) {
+        cv[i] = _mm256_set1_epi32(IV[i]);
+    }
+
+    for (size_t t = 0; t < total; ++t) {
+        __attribute__ ((aligned(32))) int32_t mask[8];
+
+        for (size_t l = 0; l < LANES; ++l) {
+            mask[l] = t <= lanes.nblocks[l] ? -1 : 0;
+        }
+
+        compress_x8(cv, &lanes, t, _mm256_load_si256((const __m256i*) mask));
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        result[i] = cv[i] ^ cv[i + 8];
+    }
+    transpose8(result);
+
+    for (size_t l = 0; l < LANES; ++l) {
+        _mm256_storeu_si256((__m256i*) digests[l], result[l]);
+    }
+}
@@ -79,6 +79,27 @@ static inline uint32_t rol32(uint32_t value, size_t rot)
     return (value << rot) | (value >> (32 - rot));
 }
 
+// the next 16 expanded words from the previous two blocks, m1 = M[i - 1] and m0 = M[i - 2]
+static inline void expand_block(uint32_t* msg, const uint32_t* m1, const uint32_t* m0)
+{
+    msg[ 0] = m1[ 0] + m0[ 3];
+    msg[ 1] = m1[ 1] + m0[ 2];
+    msg[ 2] = m1[ 2] + m0[ 0];
+    msg[ 3] = m1[ 3] + m0[ 1];
+    msg[ 4] = m1[ 4] + m0[ 7];
+    msg[ 5] = m1[ 5] + m0[ 4];
+    msg[ 6] = m1[ 6] + m0[ 5];
+    msg[ 7] = m1[ 7] + m0[ 6];
+    msg[ 8] = m1[ 8] + m0[11];
+    msg[ 9] = m1[ 9] + m0[10];
+    msg[10] = m1[10] + m0[ 8];
+    msg[11] = m1[11] + m0[ 9];
+    msg[12] = m1[12] + m0[15];
+    msg[13] = m1[13] + m0[12];
+    msg[14] = m1[14] + m0[13];
+    msg[15] = m1[15] + m0[14];
+}
+
 static void expand_message(lsh256_context* ctx, const uint8_t* in)
 {
     uint32_t* msg = ctx->msg;
@@ -86,63 +107,49 @@ static void expand_message(lsh256_context* ctx, const uint8_t* in)
 
     for (size_t i = 2; i <= NUMSTEP; ++i) {
         size_t idx = 16 * i;
-        msg[idx     ] = msg[idx - 16] + msg[idx - 29];
-        msg[idx +  1] = msg[idx - 15] + msg[idx - 30];
-        msg[idx +  2] = msg[idx - 14] + msg[idx - 32];
-        msg[idx +  3] = msg[idx - 13] + msg[idx - 31];
-        msg[idx +  4] = msg[idx - 12] + msg[idx - 25];
-        msg[idx +  5] = msg[idx - 11] + msg[idx - 28];
-        msg[idx +  6] = msg[idx - 10] + msg[idx - 27];
-        msg[idx +  7] = msg[idx -  9] + msg[idx - 26];
-        msg[idx +  8] = msg[idx -  8] + msg[idx - 21];
-        msg[idx +  9] = msg[idx -  7] + msg[idx - 22];
-        msg[idx + 10] = msg[idx -  6] + msg[idx - 24];
-        msg[idx + 11] = msg[idx -  5] + msg[idx - 23];
-        msg[idx + 12] = msg[idx -  4] + msg[idx - 17];
-        msg[idx + 13] = msg[idx -  3] + msg[idx - 20];
-        msg[idx + 14] = msg[idx -  2] + msg[idx - 19];
-        msg[idx + 15] = msg[idx -  1] + msg[idx - 18];
+        expand_block(msg + idx, msg + idx - 16, msg + idx - 32);
     }
 }
 
-static inline void permute_word(lsh256_context* ctx)
+static inline void permute_word(uint32_t* cv, const uint32_t* tcv)
 {
-    ctx->cv[ 0] = ctx->tcv[ 6];
-    ctx->cv[ 1] = ctx->tcv[ 4];
-    ctx->cv[ 2] = ctx->tcv[ 5];
-    ctx->cv[ 3] = ctx->tcv[ 7];
+    cv[ 0] = tcv[ 6];
+    cv[ 1] = tcv[ 4];
+    cv[ 2] = tcv[ 5];
+    cv[ 3] = tcv[ 7];
     
-    ctx->cv[ 4] = ctx->tcv[12];
-    ctx->cv[ 5] = ctx->tcv[15];
-    ctx->cv[ 6] = ctx->tcv[14];
-    ctx->cv[ 7] = ctx->tcv[13];
-
-    ctx->cv[ 8] = ctx->tcv[ 2];
-    ctx->cv[ 9] = ctx->tcv[ 0];
-    ctx->cv[10] = ctx->tcv[ 1];
-    ctx->cv[11] = ctx->tcv[ 3];
-
-    ctx->cv[12] = ctx->tcv[ 8];
-    ctx->cv[13] = ctx->tcv[11];
-    ctx->cv[14] = ctx->tcv[10];
-    ctx->cv[15] = ctx->tcv[ 9];
+    cv[ 4] = tcv[12];
+    cv[ 5] = tcv[15];
+    cv[ 6] = tcv[14];
+    cv[ 7] = tcv[13];
+
+    cv[ 8] = tcv[ 2];
+    cv[ 9] = tcv[ 0];
+    cv[10] = tcv[ 1];
+    cv[11] = tcv[ 3];
+
+    cv[12] = tcv[ 8];
+    cv[13] = tcv[11];
+    cv[14] = tcv[10];
+    cv[15] = tcv[ 9];
 }
 
-static void step(lsh256_context* ctx, size_t idx, uint32_t alpha, uint32_t beta)
+// msg is the 16 word block of the expanded message for step idx
+static void step(uint32_t* cv, uint32_t* tcv, const uint32_t* msg, size_t idx, uint32_t alpha, uint32_t beta)
 {
     uint32_t vl, vr;
     for (size_t col = 0; col < 8; ++col) {
-        vl = ctx->cv[col    ] ^ ctx->msg[16 * idx + col    ];
-        vr = ctx->cv[col + 8] ^ ctx->msg[16 * idx + col + 8];
+        vl = cv[col    ] ^ msg[col    ];
+        vr = cv[col + 8] ^ msg[col + 8];
 
         vl = rol32(vl + vr, alpha) ^ STEP_CONSTANT[8 * idx + col];
         vr = rol32(vl + vr, beta);
         
-        ctx->tcv[col] = vl + vr;
-        ctx->tcv[col + 8] = rol32(vr, GAMMA[col]);
+        tcv[col] = vl + vr;
+        tcv[col + 8] = rol32(vr, GAMMA[col]);
     }
 
-    permute_word(ctx);
+    permute_word(cv, tcv);
 }
 
 static void compress(lsh256_context* ctx, const uint8_t* data)
@@ -150,8 +157,8 @@ static void compress(lsh256_context* ctx, const uint8_t* data)
     expand_message(ctx, data);
 
     for (size_t i = 0; i < NUMSTEP; i += 2) {
-        step(ctx, i, ALPHA_EVEN, BETA_EVEN);
-        step(ctx, i + 1, ALPHA_ODD, BETA_ODD);
+        step(ctx->cv, ctx->tcv, ctx->msg + 16 * i, i, ALPHA_EVEN, BETA_EVEN);
+        step(ctx->cv, ctx->tcv, ctx->msg + 16 * (i + 1), i + 1, ALPHA_ODD, BETA_ODD);
     }
 
     for (size_t i = 0; i < 16; ++i) {
@@ -159,6 +166,34 @@ static void compress(lsh256_context* ctx, const uint8_t* data)
     }
 }
 
+/**
+ * compress with the message expanded on the fly: block i only depends on the blocks i - 1 and i - 2,
+ * so it rolls through a window of 3 blocks on the stack instead of the 27 blocks of lsh256_context.
+ */
+static void compress_rolling(uint32_t* cv, const uint8_t* data)
+{
+    uint32_t window[3][16];
+    uint32_t tcv[16];
+
+    memcpy(window, data, 32 * sizeof(uint32_t));
+
+    for (size_t i = 0; i < NUMSTEP; i += 2) {
+        if (i > 0) {
+            expand_block(window[i % 3], window[(i + 2) % 3], window[(i + 1) % 3]);
+            expand_block(window[(i + 1) % 3], window[i % 3], window[(i + 2) % 3]);
+        }
+
+        step(cv, tcv, window[i % 3], i, ALPHA_EVEN, BETA_EVEN);
+        step(cv, tcv, window[(i + 1) % 3], i + 1, ALPHA_ODD, BETA_ODD);
+    }
+
+    expand_block(window[NUMSTEP % 3], window[(NUMSTEP + 2) % 3], window[(NUMSTEP + 1) % 3]);
+
+    for (size_t i = 0; i < 16; ++i) {
+        cv[i] ^= window[NUMSTEP % 3][i];
+    }
+}
+
 void lsh256_init(lsh256_context* ctx)
 {
     ctx->bidx = 0;
@@ -217,4 +252,74 @@ void lsh256_final(lsh256_context* ctx, uint8_t* digest)
     }
 
     lsh256_init(ctx);
-}
\ No newline at end of file
+}
+
+void lsh256_init_compact(lsh256_compact_context* ctx)
+{
+    ctx->bidx = 0;
+    ctx->length = 0;
+    memset(ctx->block, 0, BLOCKSIZE);
+
+    memcpy(ctx->cv, IV, 16 * sizeof(uint32_t));
+}
+
+void lsh256_update_compact(lsh256_compact_context* ctx, const uint8_t* data, size_t length)
+{
+    ctx->length += length;
+
+    if (ctx->bidx > 0) {
+        size_t gap = BLOCKSIZE - ctx->bidx;
+
+        if (length >= gap) {
+            memcpy(ctx->block + ctx->bidx, data, gap);
+            compress_rolling(ctx->cv, ctx->block);
+            ctx->bidx = 0;
+            data += gap;
+            length -= gap;
+
+        } else {
+            memcpy(ctx->block + ctx->bidx, data, length);
+            ctx->bidx += length;
+            data += length;
+            length = 0;
+        }
+    }
+    
+    while (length >= BLOCKSIZE) {
+        compress_rolling(ctx->cv, data);
+        data += BLOCKSIZE;
+        length -= BLOCKSIZE;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->block + ctx->bidx, data, length);
+        ctx->bidx += length;
+    }
+}
+
+void lsh256_final_compact(lsh256_compact_context* ctx, uint8_t* digest)
+{
+    uint32_t* result = (uint32_t*) digest;
+
+    ctx->block[(ctx->bidx)++] = (uint8_t) 0x80;
+    memset(ctx->block + ctx->bidx, 0, BLOCKSIZE - ctx->bidx);
+    compress_rolling(ctx->cv, ctx->block);
+
+    for (size_t i = 0; i < 8; ++i) {
+        result[i] = ctx->cv[i] ^ ctx->cv[i + 8];
+    }
+
+    lsh256_init_compact(ctx);
+}
+
+// one message after the other, only the AVX2 backend hashes them in parallel lanes
+void lsh256_hash_x8(uint8_t* const digests[8], const uint8_t* const msgs[8], const size_t lens[8])
+{
+    lsh256_context ctx;
+
+    for (size_t i = 0; i < 8; ++i) {
+        lsh256_init(&ctx);
+        lsh256_update(&ctx, msgs[i], lens[i]);
+        lsh256_final(&ctx, digests[i]);
+    }
+}
@@ -92,6 +92,26 @@ static inline __m128i rol32(__m128i value, size_t rot)
     return _mm_slli_epi32(value, rot) | _mm_srli_epi32(value, (32 - rot));
 }
 
+// the next block of the expanded message from the previous two, m1 = M[i - 1] and m0 = M[i - 2]
+static inline void expand_block(__m128i* msg, const __m128i* m1, const __m128i* m0)
+{
+    msg[0] = _mm_add_epi32(
+        m1[0], _mm_shuffle_epi32(m0[0], _MM_SHUFFLE(1, 0, 2, 3))
+    );
+    
+    msg[1] = _mm_add_epi32(
+        m1[1], _mm_shuffle_epi32(m0[1], _MM_SHUFFLE(2, 1, 0, 3))
+    );
+
+    msg[2] = _mm_add_epi32(
+        m1[2], _mm_shuffle_epi32(m0[2], _MM_SHUFFLE(1, 0, 2, 3))
+    );
+
+    msg[3] = _mm_add_epi32(
+        m1[3], _mm_shuffle_epi32(m0[3], _MM_SHUFFLE(2, 1, 0, 3))
+    );
+}
+
 static void expand_message(lsh256_sse4_context* ctx, const uint8_t* in)
 {
     __m128i* msg = ctx->msg;
@@ -101,34 +121,20 @@ static void expand_message(lsh256_sse4_context* ctx, const uint8_t* in)
     
     for (size_t i = 2; i <= NUMSTEP; ++i) {
         size_t idx = 4 * i;
-
-        msg[idx] = _mm_add_epi32(
-            msg[idx - 4], _mm_shuffle_epi32(msg[idx - 8], _MM_SHUFFLE(1, 0, 2, 3))
-        );
-        
-        msg[idx + 1] = _mm_add_epi32(
-            msg[idx - 3], _mm_shuffle_epi32(msg[idx - 7], _MM_SHUFFLE(2, 1, 0, 3))
-        );
-
-        msg[idx + 2] = _mm_add_epi32(
-            msg[idx - 2], _mm_shuffle_epi32(msg[idx - 6], _MM_SHUFFLE(1, 0, 2, 3))
-        );
-
-        msg[idx + 3] = _mm_add_epi32(
-            msg[idx - 1], _mm_shuffle_epi32(msg[idx - 5], _MM_SHUFFLE(2, 1, 0, 3))
-        );
+        expand_block(msg + idx, msg + idx - 4, msg + idx - 8);
     }
 }
 
-static inline void permute_word(lsh256_sse4_context* ctx)
+static inline void permute_word(__m128i* cv, __m128i* tcv)
 {
-    ctx->cv[0] = _mm_shuffle_epi32(ctx->tcv[1], _MM_SHUFFLE(3,1,0,2));
-    ctx->cv[1] = _mm_shuffle_epi32(ctx->tcv[3], _MM_SHUFFLE(1,2,3,0));
-    ctx->cv[2] = _mm_shuffle_epi32(ctx->tcv[0], _MM_SHUFFLE(3,1,0,2));
-    ctx->cv[3] = _mm_shuffle_epi32(ctx->tcv[2], _MM_SHUFFLE(1,2,3,0));
+    cv[0] = _mm_shuffle_epi32(tcv[1], _MM_SHUFFLE(3,1,0,2));
+    cv[1] = _mm_shuffle_epi32(tcv[3], _MM_SHUFFLE(1,2,3,0));
+    cv[2] = _mm_shuffle_epi32(tcv[0], _MM_SHUFFLE(3,1,0,2));
+    cv[3] = _mm_shuffle_epi32(tcv[2], _MM_SHUFFLE(1,2,3,0));
 }
 
-static void step(lsh256_sse4_context* ctx, size_t idx, uint32_t alpha, uint32_t beta)
+// msg is the block of the expanded message for step idx
+static void step(__m128i* cv, __m128i* tcv, const __m128i* msg, size_t idx, uint32_t alpha, uint32_t beta)
 {
     __m128i vl, vr;
     __m128i step_constant[2];
@@ -137,17 +143,17 @@ static void step(lsh256_sse4_context* ctx, size_t idx, uint32_t alpha, uint32_t
     step_constant[1] = _mm_loadu_si128((const __m128i*) STEP_CONSTANT + 2 * idx + 1);
 
     for (int col = 0; col < 2; ++col) {    
-        vl = ctx->cv[col    ] ^ ctx->msg[4 * idx + col    ];
-        vr = ctx->cv[col + 2] ^ ctx->msg[4 * idx + col + 2];
+        vl = cv[col    ] ^ msg[col    ];
+        vr = cv[col + 2] ^ msg[col + 2];
 
         vl = rol32(_mm_add_epi32(vl, vr), alpha) ^ step_constant[col];
         vr = rol32(_mm_add_epi32(vl, vr), beta);
 
-        ctx->tcv[col    ] = _mm_add_epi32(vl, vr);
-        ctx->tcv[col + 2] = _mm_shuffle_epi8(vr, ((__m128i*)GAMMA)[col]);
+        tcv[col    ] = _mm_add_epi32(vl, vr);
+        tcv[col + 2] = _mm_shuffle_epi8(vr, ((__m128i*)GAMMA)[col]);
     }
 
-    permute_word(ctx);
+    permute_word(cv, tcv);
 }
 
 static void compress(lsh256_sse4_context* ctx, const uint8_t* data)
@@ -155,8 +161,8 @@ static void compress(lsh256_sse4_context* ctx, const uint8_t* data)
     expand_message(ctx, data);
 
     for (size_t i = 0; i < NUMSTEP; i += 2) {
-        step(ctx, i, ALPHA_EVEN, BETA_EVEN);
-        step(ctx, i + 1, ALPHA_ODD, BETA_ODD);
+        step(ctx->cv, ctx->tcv, ctx->msg + 4 * i, i, ALPHA_EVEN, BETA_EVEN);
+        step(ctx->cv, ctx->tcv, ctx->msg + 4 * (i + 1), i + 1, ALPHA_ODD, BETA_ODD);
     }
 
     for (size_t i = 0; i < 4; ++i) {
@@ -164,6 +170,36 @@ static void compress(lsh256_sse4_context* ctx, const uint8_t* data)
     }
 }
 
+/**
+ * compress with the message expanded on the fly: block i only depends on the blocks i - 1 and i - 2,
+ * so it rolls through a window of 3 blocks on the stack instead of the 27 blocks of the context.
+ */
+static void compress_rolling(__m128i* cv, const uint8_t* data)
+{
+    __m128i window[3][4];
+    __m128i tcv[4];
+
+    for (size_t i = 0; i < 8; ++i) {
+        window[i / 4][i % 4] = _mm_loadu_si128((__m128i*) data + i);
+    }
+
+    for (size_t i = 0; i < NUMSTEP; i += 2) {
+        if (i > 0) {
+            expand_block(window[i % 3], window[(i + 2) % 3], window[(i + 1) % 3]);
+            expand_block(window[(i + 1) % 3], window[i % 3], window[(i + 2) % 3]);
+        }
+
+        step(cv, tcv, window[i % 3], i, ALPHA_EVEN, BETA_EVEN);
+        step(cv, tcv, window[(i + 1) % 3], i + 1, ALPHA_ODD, BETA_ODD);
+    }
+
+    expand_block(window[NUMSTEP % 3], window[(NUMSTEP + 2) % 3], window[(NUMSTEP + 1) % 3]);
+
+    for (size_t i = 0; i < 4; ++i) {
+        cv[i] ^= window[NUMSTEP % 3][i];
+    }
+}
+
 void lsh256_init(lsh256_context* ctx)
 {
     ctx->bidx = 0;
@@ -222,4 +258,74 @@ void lsh256_final(lsh256_context* ctx, uint8_t* digest)
     }
 
     lsh256_init(ctx);
-}
\ No newline at end of file
+}
+
+void lsh256_init_compact(lsh256_compact_context* ctx)
+{
+    ctx->bidx = 0;
+    ctx->length = 0;
+    memset(ctx->block, 0, BLOCKSIZE);
+
+    memcpy(ctx->cv, IV, 16 * sizeof(uint32_t));
+}
+
+void lsh256_update_compact(lsh256_compact_context* ctx, const uint8_t* data, size_t length)
+{
+    ctx->length += length;
+
+    if (ctx->bidx > 0) {
+        size_t gap = BLOCKSIZE - ctx->bidx;
+
+        if (length >= gap) {
+            memcpy(ctx->block + ctx->bidx, data, gap);
+            compress_rolling((__m128i*) ctx->cv, ctx->block);
+            ctx->bidx = 0;
+            data += gap;
+            length -= gap;
+
+        } else {
+            memcpy(ctx->block + ctx->bidx, data, length);
+            ctx->bidx += length;
+            data += length;
+            length = 0;
+        }
+    }
+    
+    while (length >= BLOCKSIZE) {
+        compress_rolling((__m128i*) ctx->cv, data);
+        data += BLOCKSIZE;
+        length -= BLOCKSIZE;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->block + ctx->bidx, data, length);
+        ctx->bidx += length;
+    }
+}
+
+void lsh256_final_compact(lsh256_compact_context* ctx, uint8_t* digest)
+{
+    uint32_t* result = (uint32_t*) digest;
+
+    ctx->block[(ctx->bidx)++] = (uint8_t) 0x80;
+    memset(ctx->block + ctx->bidx, 0, BLOCKSIZE - ctx->bidx);
+    compress_rolling((__m128i*) ctx->cv, ctx->block);
+
+    for (size_t i = 0; i < 8; ++i) {
+        result[i] = ctx->cv[i] ^ ctx->cv[i + 8];
+    }
+
+    lsh256_init_compact(ctx);
+}
+
+// one message after the other, only the AVX2 backend hashes them in parallel lanes
+void lsh256_hash_x8(uint8_t* const digests[8], const uint8_t* const msgs[8], const size_t lens[8])
+{
+    lsh256_context ctx;
+
+    for (size_t i = 0; i < 8; ++i) {
+        lsh256_init(&ctx);
+        lsh256_update(&ctx, msgs[i], lens[i]);
+        lsh256_final(&ctx, digests[i]);
+    }
+}
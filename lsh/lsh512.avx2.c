@@ -125,6 +125,26 @@ static inline __m256i rol64(__m256i value, size_t rot)
     return _mm256_slli_epi64(value, rot) | _mm256_srli_epi64(value, 64 - rot);
 }
 
+// the next block of the expanded message from the previous two, m1 = M[i - 1] and m0 = M[i - 2]
+static inline void expand_block(__m256i* msg, const __m256i* m1, const __m256i* m0)
+{
+    msg[0] = _mm256_add_epi64(
+        m1[0], _mm256_permute4x64_epi64(m0[0], _MM_SHUFFLE(1, 0, 2, 3))
+    );
+    
+    msg[1] = _mm256_add_epi64(
+        m1[1], _mm256_permute4x64_epi64(m0[1], _MM_SHUFFLE(2, 1, 0, 3))
+    );
+
+    msg[2] = _mm256_add_epi64(
+        m1[2], _mm256_permute4x64_epi64(m0[2], _MM_SHUFFLE(1, 0, 2, 3))
+    );
+
+    msg[3] = _mm256_add_epi64(
+        m1[3], _mm256_permute4x64_epi64(m0[3], _MM_SHUFFLE(2, 1, 0, 3))
+    );
+}
+
 static void expand_message(lsh512_avx2_context* ctx, const uint8_t* in)
 {
     __m256i* msg = ctx->msg;
@@ -134,34 +154,20 @@ static void expand_message(lsh512_avx2_context* ctx, const uint8_t* in)
 
     for (size_t i = 2; i <= NUMSTEP; ++i) {
         size_t idx = 4 * i;
-
-        msg[idx] = _mm256_add_epi64(
-            msg[idx - 4], _mm256_permute4x64_epi64(msg[idx - 8], _MM_SHUFFLE(1, 0, 2, 3))
-        );
-        
-        msg[idx + 1] = _mm256_add_epi64(
-            msg[idx - 3], _mm256_permute4x64_epi64(msg[idx - 7], _MM_SHUFFLE(2, 1, 0, 3))
-        );
-
-        msg[idx + 2] = _mm256_add_epi64(
-            msg[idx - 2], _mm256_permute4x64_epi64(msg[idx - 6], _MM_SHUFFLE(1, 0, 2, 3))
-        );
-
-        msg[idx + 3] = _mm256_add_epi64(
-            msg[idx - 1], _mm256_permute4x64_epi64(msg[idx - 5], _MM_SHUFFLE(2, 1, 0, 3))
-        );
+        expand_block(msg + idx, msg + idx - 4, msg + idx - 8);
     }
 }
 
-static inline void permute_word(lsh512_avx2_context* ctx)
+static inline void permute_word(__m256i* cv, __m256i* tcv)
 {
-    ctx->cv[0] = _mm256_permute4x64_epi64(ctx->tcv[1], _MM_SHUFFLE(3, 1, 0, 2));
-    ctx->cv[1] = _mm256_permute4x64_epi64(ctx->tcv[3], _MM_SHUFFLE(1, 2, 3, 0));
-    ctx->cv[2] = _mm256_permute4x64_epi64(ctx->tcv[0], _MM_SHUFFLE(3, 1, 0, 2));
-    ctx->cv[3] = _mm256_permute4x64_epi64(ctx->tcv[2], _MM_SHUFFLE(1, 2, 3, 0));
+    cv[0] = _mm256_permute4x64_epi64(tcv[1], _MM_SHUFFLE(3, 1, 0, 2));
+    cv[1] = _mm256_permute4x64_epi64(tcv[3], _MM_SHUFFLE(1, 2, 3, 0));
+    cv[2] = _mm256_permute4x64_epi64(tcv[0], _MM_SHUFFLE(3, 1, 0, 2));
+    cv[3] = _mm256_permute4x64_epi64(tcv[2], _MM_SHUFFLE(1, 2, 3, 0));
 }
 
-static void step(lsh512_avx2_context* ctx, size_t idx, uint64_t alpha, uint64_t beta)
+// msg is the block of the expanded message for step idx
+static void step(__m256i* cv, __m256i* tcv, const __m256i* msg, size_t idx, uint64_t alpha, uint64_t beta)
 {
     __m256i vl, vr;
     __m256i step_constant[2];
@@ -170,17 +176,17 @@ static void step(lsh512_avx2_context* ctx, size_t idx, uint64_t alpha, uint64_t
     step_constant[1] = _mm256_loadu_si256((const __m256i*) STEP_CONSTANT + 2 * idx + 1);
 
     for (size_t col = 0; col < 2; ++col) {
-        vl = ctx->cv[col    ] ^ ctx->msg[4 * idx + col    ];
-        vr = ctx->cv[col + 2] ^ ctx->msg[4 * idx + col + 2];
+        vl = cv[col    ] ^ msg[col    ];
+        vr = cv[col + 2] ^ msg[col + 2];
 
         vl = rol64(_mm256_add_epi64(vl, vr), alpha) ^ step_constant[col];
         vr = rol64(_mm256_add_epi64(vl, vr), beta);
 
-        ctx->tcv[col    ] = _mm256_add_epi64(vl, vr);
-        ctx->tcv[col + 2] = _mm256_shuffle_epi8(vr, ((__m256i*)GAMMA)[col]);
+        tcv[col    ] = _mm256_add_epi64(vl, vr);
+        tcv[col + 2] = _mm256_shuffle_epi8(vr, ((__m256i*)GAMMA)[col]);
     }
 
-    permute_word(ctx);
+    permute_word(cv, tcv);
 }
 
 static void compress(lsh512_avx2_context* ctx, const uint8_t* data)
@@ -188,8 +194,8 @@ static void compress(lsh512_avx2_context* ctx, const uint8_t* data)
     expand_message(ctx, data);
 
     for (size_t i = 0; i < NUMSTEP; i += 2) {
-        step(ctx, i, ALPHA_EVEN, BETA_EVEN);
-        step(ctx, i + 1, ALPHA_ODD, BETA_ODD);
+        step(ctx->cv, ctx->tcv, ctx->msg + 4 * i, i, ALPHA_EVEN, BETA_EVEN);
+        step(ctx->cv, ctx->tcv, ctx->msg + 4 * (i + 1), i + 1, ALPHA_ODD, BETA_ODD);
     }
 
     for (size_t i = 0; i < 4; ++i) {
@@ -197,6 +203,36 @@ static void compress(lsh512_avx2_context* ctx, const uint8_t* data)
     }
 }
 
+/**
+ * compress with the message expanded on the fly: block i only depends on the blocks i - 1 and i - 2,
+ * so it rolls through a window of 3 blocks on the stack instead of the 29 blocks of the context.
+ */
+static void compress_rolling(__m256i* cv, const uint8_t* data)
+{
+    __m256i window[3][4];
+    __m256i tcv[4];
+
+    for (size_t i = 0; i < 8; ++i) {
+        window[i / 4][i % 4] = _mm256_loadu_si256((__m256i*) data + i);
+    }
+
+    for (size_t i = 0; i < NUMSTEP; i += 2) {
+        if (i > 0) {
+            expand_block(window[i % 3], window[(i + 2) % 3], window[(i + 1) % 3]);
+            expand_block(window[(i + 1) % 3], window[i % 3], window[(i + 2) % 3]);
+        }
+
+        step(cv, tcv, window[i % 3], i, ALPHA_EVEN, BETA_EVEN);
+        step(cv, tcv, window[(i + 1) % 3], i + 1, ALPHA_ODD, BETA_ODD);
+    }
+
+    expand_block(window[NUMSTEP % 3], window[(NUMSTEP + 2) % 3], window[(NUMSTEP + 1) % 3]);
+
+    for (size_t i = 0; i < 4; ++i) {
+        cv[i] ^= window[NUMSTEP % 3][i];
+    }
+}
+
 void lsh512_init(lsh512_context* ctx)
 {
     ctx->bidx = 0;
@@ -256,3 +292,248 @@ void lsh512_final(lsh512_context* ctx, uint8_t* digest)
 
     lsh512_init(ctx);
 }
+
+void lsh512_init_compact(lsh512_compact_context* ctx)
+{
+    ctx->bidx = 0;
+    ctx->length = 0;
+    memset(ctx->block, 0, BLOCKSIZE);
+
+    memcpy(ctx->cv, IV, 16 * sizeof(uint64_t));
+}
+
+void lsh512_update_compact(lsh512_compact_context* ctx, const uint8_t* data, size_t length)
+{
+    ctx->length += length;
+
+    if (ctx->bidx > 0) {
+        size_t gap = BLOCKSIZE - ctx->bidx;
+
+        if (length >= gap) {
+            memcpy(ctx->block + ctx->bidx, data, gap);
+            compress_rolling((__m256i*) ctx->cv, ctx->block);
+            ctx->bidx = 0;
+            data += gap;
+            length -= gap;
+
+        } else {
+            memcpy(ctx->block + ctx->bidx, data, length);
+            ctx->bidx += length;
+            data += length;
+            length = 0;
+        }
+    }
+    
+    while (length >= BLOCKSIZE) {
+        compress_rolling((__m256i*) ctx->cv, data);
+        data += BLOCKSIZE;
+        length -= BLOCKSIZE;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->block + ctx->bidx, data, length);
+        ctx->bidx += length;
+    }
+}
+
+void lsh512_final_compact(lsh512_compact_context* ctx, uint8_t* digest)
+{
+    uint64_t* result = (uint64_t*) digest;
+
+    ctx->block[(ctx->bidx)++] = (uint8_t) 0x80;
+    memset(ctx->block + ctx->bidx, 0, BLOCKSIZE - ctx->bidx);
+    compress_rolling((__m256i*) ctx->cv, ctx->block);
+
+    for (size_t i = 0; i < 8; ++i) {
+        result[i] = ctx->cv[i] ^ ctx->cv[i + 8];
+    }
+
+    lsh512_init_compact(ctx);
+}
+
+/**
+ * Multi-message hashing: 4 independent messages, one in each 64-bit lane of the registers.
+ * The state is kept transposed, cv[j] holds word j of every lane, so a step is the scalar
+ * step with each word replaced by a register, and the word permutation only decides where it stores them.
+ */
+const static size_t LANES = 4;
+
+// the rotations by gamma of each column are by whole bytes, done as byte shuffles
+const static __attribute__ ((aligned(32))) uint64_t GAMMA_X4[8][4] = {
+    {0x0706050403020100, 0x0f0e0d0c0b0a0908, 0x0706050403020100, 0x0f0e0d0c0b0a0908},
+    {0x0504030201000706, 0x0d0c0b0a09080f0e, 0x0504030201000706, 0x0d0c0b0a09080f0e},
+    {0x0302010007060504, 0x0b0a09080f0e0d0c, 0x0302010007060504, 0x0b0a09080f0e0d0c},
+    {0x0100070605040302, 0x09080f0e0d0c0b0a, 0x0100070605040302, 0x09080f0e0d0c0b0a},
+    {0x0605040302010007, 0x0e0d0c0b0a09080f, 0x0605040302010007, 0x0e0d0c0b0a09080f},
+    {0x0403020100070605, 0x0c0b0a09080f0e0d, 0x0403020100070605, 0x0c0b0a09080f0e0d},
+    {0x0201000706050403, 0x0a09080f0e0d0c0b, 0x0201000706050403, 0x0a09080f0e0d0c0b},
+    {0x0007060504030201, 0x080f0e0d0c0b0a09, 0x0007060504030201, 0x080f0e0d0c0b0a09},
+};
+
+// the word permutation as the position each word moves to, cv[WORD_DEST[j]] = tcv[j]
+const static size_t WORD_DEST[] = {9, 10, 8, 11, 1, 2, 0, 3, 12, 15, 14, 13, 4, 7, 6, 5};
+
+const static size_t MSGEXP_TAU[] = {3, 2, 0, 1, 7, 4, 5, 6, 11, 10, 8, 9, 15, 12, 13, 14};
+
+/**
+ * Lane scheduler: a lane reads the whole blocks of its message in place and then its
+ * padded last block, copied here. A lane whose message is done keeps hashing its last block
+ * with the chaining value update masked off until the longest message is done.
+ */
+typedef struct st_lsh512_lanes {
+    const uint8_t* data[4];
+    size_t nblocks[4];
+    __attribute__ ((aligned(32))) uint8_t last[4][256];
+} lsh512_lanes;
+
+static void schedule_lanes(lsh512_lanes* lanes, const uint8_t* const msgs[4], const size_t lens[4], size_t* total)
+{
+    *total = 0;
+
+    for (size_t l = 0; l < LANES; ++l) {
+        size_t rest = lens[l] % BLOCKSIZE;
+
+        lanes->data[l] = msgs[l];
+        lanes->nblocks[l] = lens[l] / BLOCKSIZE;
+
+        if (rest > 0) {
+            memcpy(lanes->last[l], msgs[l] + lens[l] - rest, rest);
+        }
+        lanes->last[l][rest] = (uint8_t) 0x80;
+        memset(lanes->last[l] + rest + 1, 0, BLOCKSIZE - rest - 1);
+
+        if (lanes->nblocks[l] + 1 > *total) {
+            *total = lanes->nblocks[l] + 1;
+        }
+    }
+}
+
+static inline const uint8_t* lane_block(const lsh512_lanes* lanes, size_t l, size_t t)
+{
+    return t < lanes->nblocks[l] ? lanes->data[l] + BLOCKSIZE * t : lanes->last[l];
+}
+
+// rows r[l] = words 0..3 of lane l become r[j] = word j of lanes 0..3
+static inline void transpose4(__m256i* r)
+{
+    __m256i t0 = _mm256_unpacklo_epi64(r[0], r[1]);
+    __m256i t1 = _mm256_unpackhi_epi64(r[0], r[1]);
+    __m256i t2 = _mm256_unpacklo_epi64(r[2], r[3]);
+    __m256i t3 = _mm256_unpackhi_epi64(r[2], r[3]);
+
+    r[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+    r[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+    r[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+    r[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+// M0 into window[0] and M1 into window[1], word k of every lane in msg[k]
+static void load_message_x4(__m256i window[][16], const lsh512_lanes* lanes, size_t t)
+{
+    for (size_t c = 0; c < 8; ++c) {
+        __m256i* msg = window[c / 4] + 4 * (c % 4);
+
+        for (size_t l = 0; l < LANES; ++l) {
+            msg[l] = _mm256_loadu_si256((const __m256i*) lane_block(lanes, l, t) + c);
+        }
+        transpose4(msg);
+    }
+}
+
+// the next 16 expanded words from the previous two, m1 = M[i - 1] and m0 = M[i - 2]
+static inline void expand_message_x4(__m256i* out, const __m256i* m1, const __m256i* m0)
+{
+    for (size_t k = 0; k < 16; ++k) {
+        out[k] = _mm256_add_epi64(m1[k], m0[MSGEXP_TAU[k]]);
+    }
+}
+
+static inline void column_x4(__m256i* out, const __m256i* in, const __m256i* msg, size_t idx, size_t col, uint64_t alpha, uint64_t beta)
+{
+    __m256i vl, vr;
+
+    vl = in[col    ] ^ msg[col    ];
+    vr = in[col + 8] ^ msg[col + 8];
+
+    vl = rol64(_mm256_add_epi64(vl, vr), alpha) ^ _mm256_set1_epi64x(STEP_CONSTANT[8 * idx + col]);
+    vr = rol64(_mm256_add_epi64(vl, vr), beta);
+
+    out[WORD_DEST[col]] = _mm256_add_epi64(vl, vr);
+    out[WORD_DEST[col + 8]] = _mm256_shuffle_epi8(vr, _mm256_load_si256((const __m256i*) GAMMA_X4[col]));
+}
+
+// out is the permuted state after the step on in, the two alternate instead of copying the permutation
+static inline void step_x4(__m256i* out, const __m256i* in, const __m256i* msg, size_t idx, uint64_t alpha, uint64_t beta)
+{
+    column_x4(out, in, msg, idx, 0, alpha, beta);
+    column_x4(out, in, msg, idx, 1, alpha, beta);
+    column_x4(out, in, msg, idx, 2, alpha, beta);
+    column_x4(out, in, msg, idx, 3, alpha, beta);
+    column_x4(out, in, msg, idx, 4, alpha, beta);
+    column_x4(out, in, msg, idx, 5, alpha, beta);
+    column_x4(out, in, msg, idx, 6, alpha, beta);
+    column_x4(out, in, msg, idx, 7, alpha, beta);
+}
+
+// the expanded message is rolled through a window of 3 blocks instead of being stored whole
+static void compress_x4(__m256i* cv, const lsh512_lanes* lanes, size_t t, __m256i active)
+{
+    __m256i window[3][16];
+    __m256i state[16];
+    __m256i tmp[16];
+
+    load_message_x4(window, lanes, t);
+
+    for (size_t i = 0; i < NUMSTEP; i += 2) {
+        if (i > 0) {
+            expand_message_x4(window[i % 3], window[(i + 2) % 3], window[(i + 1) % 3]);
+        }
+        step_x4(tmp, i == 0 ? cv : state, window[i % 3], i, ALPHA_EVEN, BETA_EVEN);
+
+        if (i > 0) {
+            expand_message_x4(window[(i + 1) % 3], window[i % 3], window[(i + 2) % 3]);
+        }
+        step_x4(state, tmp, window[(i + 1) % 3], i + 1, ALPHA_ODD, BETA_ODD);
+    }
+
+    expand_message_x4(window[NUMSTEP % 3], window[(NUMSTEP + 2) % 3], window[(NUMSTEP + 1) % 3]);
+
+    for (size_t i = 0; i < 16; ++i) {
+        cv[i] = _mm256_blendv_epi8(cv[i], state[i] ^ window[NUMSTEP % 3][i], active);
+    }
+}
+
+void lsh512_hash_x4(uint8_t* const digests[4], const uint8_t* const msgs[4], const size_t lens[4])
+{
+    lsh512_lanes lanes;
+    __m256i cv[16];
+    __m256i result[8];
+    size_t total;
+
+    schedule_lanes(&lanes, msgs, lens, &total);
+
+    for (size_t i = 0; i < 16; ++i) {
+        cv[i] = _mm256_set1_epi64x(IV[i]);
+    }
+
+    for (size_t t = 0; t < total; ++t) {
+        __attribute__ ((aligned(32))) int64_t mask[4];
+
+        for (size_t l = 0; l < LANES; ++l) {
+            mask[l] = t <= lanes.nblocks[l] ? -1 : 0;
+        }
+
+        compress_x4(cv, &lanes, t, _mm256_load_si256((const __m256i*) mask));
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        result[i] = cv[i] ^ cv[i + 8];
+    }
+    transpose4(result);
+    transpose4(result + 4);
+
+    for (size_t l = 0; l < LANES; ++l) {
+        _mm256_storeu_si256((__m256i*) digests[l], result[l]);
+        _mm256_storeu_si256((__m256i*) digests[l] + 1, result[4 + l]);
+    }
+}
@@ -130,62 +130,69 @@ static inline __m128i swap_epi64(__m128i value)
     return _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
 }
 
+// the next block of the expanded message from the previous two, m1 = M[i - 1] and m0 = M[i - 2]
+static inline void expand_block(__m128i* msg, const __m128i* m1, const __m128i* m0)
+{
+    __m128i tmp;
+
+    tmp = swap_epi64(m0[1]);
+    msg[0] = _mm_add_epi64(m1[0], tmp);
+    msg[1] = _mm_add_epi64(m1[1], m0[0]);
+
+    tmp = swap_epi64(m0[3]);
+    msg[2] = _mm_add_epi64(
+        m1[2], _mm_unpacklo_epi64(tmp, m0[2])
+    );
+    msg[3] = _mm_add_epi64(
+        m1[3], _mm_unpackhi_epi64(m0[2], tmp)
+    );
+
+    tmp = swap_epi64(m0[5]);
+    msg[4] = _mm_add_epi64(m1[4], tmp);
+    msg[5] = _mm_add_epi64(m1[5], m0[4]);
+
+    tmp = swap_epi64(m0[7]);
+    msg[6] = _mm_add_epi64(
+        m1[6], _mm_unpacklo_epi64(tmp, m0[6])
+    );
+    msg[7] = _mm_add_epi64(
+        m1[7], _mm_unpackhi_epi64(m0[6], tmp)
+    );
+}
+
 static void expand_message(lsh512_sse4_context* ctx, const uint8_t* in)
 {
     __m128i* msg = ctx->msg;
-    __m128i tmp;
     for (size_t i = 0; i < 16; ++i) {
         msg[i] = _mm_loadu_si128((__m128i*) in + i);
     }
 
     for (size_t i = 2; i <= NUMSTEP; ++i) {
         size_t idx = 8 * i;
-
-        tmp = swap_epi64(msg[idx - 15]);
-        msg[idx] = _mm_add_epi64(msg[idx - 8], tmp);
-        msg[idx + 1] = _mm_add_epi64(msg[idx - 7], msg[idx - 16]);
-
-        tmp = swap_epi64(msg[idx - 13]);
-        msg[idx + 2] = _mm_add_epi64(
-            msg[idx - 6], _mm_unpacklo_epi64(tmp, msg[idx - 14])
-        );
-        msg[idx + 3] = _mm_add_epi64(
-            msg[idx - 5], _mm_unpackhi_epi64(msg[idx - 14], tmp)
-        );
-
-        tmp = swap_epi64(msg[idx - 11]);
-        msg[idx + 4] = _mm_add_epi64(msg[idx - 4], tmp);
-        msg[idx + 5] = _mm_add_epi64(msg[idx - 3], msg[idx - 12]);
-
-        tmp = swap_epi64(msg[idx - 9]);
-        msg[idx + 6] = _mm_add_epi64(
-            msg[idx - 2], _mm_unpacklo_epi64(tmp, msg[idx - 10])
-        );
-        msg[idx + 7] = _mm_add_epi64(
-            msg[idx - 1], _mm_unpackhi_epi64(msg[idx- 10], tmp)
-        );
+        expand_block(msg + idx, msg + idx - 8, msg + idx - 16);
     }
 }
 
-static inline void permute_word(lsh512_sse4_context* ctx)
+static inline void permute_word(__m128i* cv, __m128i* tcv)
 {   
-    ctx->tcv[5] = swap_epi64(ctx->tcv[5]);
-    ctx->tcv[7] = swap_epi64(ctx->tcv[7]);
+    tcv[5] = swap_epi64(tcv[5]);
+    tcv[7] = swap_epi64(tcv[7]);
 
-    ctx->cv[0] = _mm_unpacklo_epi64(ctx->tcv[3], ctx->tcv[2]);
-    ctx->cv[1] = _mm_unpackhi_epi64(ctx->tcv[2], ctx->tcv[3]);
+    cv[0] = _mm_unpacklo_epi64(tcv[3], tcv[2]);
+    cv[1] = _mm_unpackhi_epi64(tcv[2], tcv[3]);
     
-    ctx->cv[2] = _mm_unpacklo_epi64(ctx->tcv[6], ctx->tcv[7]);
-    ctx->cv[3] = _mm_unpackhi_epi64(ctx->tcv[7], ctx->tcv[6]);
+    cv[2] = _mm_unpacklo_epi64(tcv[6], tcv[7]);
+    cv[3] = _mm_unpackhi_epi64(tcv[7], tcv[6]);
 
-    ctx->cv[4] = _mm_unpacklo_epi64(ctx->tcv[1], ctx->tcv[0]);
-    ctx->cv[5] = _mm_unpackhi_epi64(ctx->tcv[0], ctx->tcv[1]);
+    cv[4] = _mm_unpacklo_epi64(tcv[1], tcv[0]);
+    cv[5] = _mm_unpackhi_epi64(tcv[0], tcv[1]);
     
-    ctx->cv[6] = _mm_unpacklo_epi64(ctx->tcv[4], ctx->tcv[5]);
-    ctx->cv[7] = _mm_unpackhi_epi64(ctx->tcv[5], ctx->tcv[4]);
+    cv[6] = _mm_unpacklo_epi64(tcv[4], tcv[5]);
+    cv[7] = _mm_unpackhi_epi64(tcv[5], tcv[4]);
 }
 
-static void step(lsh512_sse4_context* ctx, size_t idx, uint64_t alpha, uint64_t beta)
+// msg is the block of the expanded message for step idx
+static void step(__m128i* cv, __m128i* tcv, const __m128i* msg, size_t idx, uint64_t alpha, uint64_t beta)
 {
     __m128i vl, vr;
     __m128i step_constant[4];
@@ -196,17 +203,17 @@ static void step(lsh512_sse4_context* ctx, size_t idx, uint64_t alpha, uint64_t
     step_constant[3] = _mm_loadu_si128((const __m128i*) (STEP_CONSTANT + (8 * idx)) + 3);
 
     for (size_t col = 0; col < 4; ++col) {
-        vl = ctx->cv[col    ] ^ ctx->msg[8 * idx + col    ];
-        vr = ctx->cv[col + 4] ^ ctx->msg[8 * idx + col + 4];
+        vl = cv[col    ] ^ msg[col    ];
+        vr = cv[col + 4] ^ msg[col + 4];
 
         vl = rol64(_mm_add_epi64(vl, vr), alpha) ^ step_constant[col];
         vr = rol64(_mm_add_epi64(vl, vr), beta);
 
-        ctx->tcv[col    ] = _mm_add_epi64(vl, vr);
-        ctx->tcv[col + 4] = _mm_shuffle_epi8(vr, ((__m128i*)GAMMA)[col]);
+        tcv[col    ] = _mm_add_epi64(vl, vr);
+        tcv[col + 4] = _mm_shuffle_epi8(vr, ((__m128i*)GAMMA)[col]);
     }
 
-    permute_word(ctx);
+    permute_word(cv, tcv);
 }
 
 static void compress(lsh512_sse4_context* ctx, const uint8_t* data)
@@ -214,8 +221,8 @@ static void compress(lsh512_sse4_context* ctx, const uint8_t* data)
     expand_message(ctx, data);
 
     for (size_t i = 0; i < NUMSTEP; i += 2) {
-        step(ctx, i, ALPHA_EVEN, BETA_EVEN);
-        step(ctx, i + 1, ALPHA_ODD, BETA_ODD);
+        step(ctx->cv, ctx->tcv, ctx->msg + 8 * i, i, ALPHA_EVEN, BETA_EVEN);
+        step(ctx->cv, ctx->tcv, ctx->msg + 8 * (i + 1), i + 1, ALPHA_ODD, BETA_ODD);
     }
 
     for (size_t i = 0; i < 8; ++i) {
@@ -223,6 +230,36 @@ static void compress(lsh512_sse4_context* ctx, const uint8_t* data)
     }
 }
 
+/**
+ * compress with the message expanded on the fly: block i only depends on the blocks i - 1 and i - 2,
+ * so it rolls through a window of 3 blocks on the stack instead of the 29 blocks of the context.
+ */
+static void compress_rolling(__m128i* cv, const uint8_t* data)
+{
+    __m128i window[3][8];
+    __m128i tcv[8];
+
+    for (size_t i = 0; i < 16; ++i) {
+        window[i / 8][i % 8] = _mm_loadu_si128((__m128i*) data + i);
+    }
+
+    for (size_t i = 0; i < NUMSTEP; i += 2) {
+        if (i > 0) {
+            expand_block(window[i % 3], window[(i + 2) % 3], window[(i + 1) % 3]);
+            expand_block(window[(i + 1) % 3], window[i % 3], window[(i + 2) % 3]);
+        }
+
+        step(cv, tcv, window[i % 3], i, ALPHA_EVEN, BETA_EVEN);
+        step(cv, tcv, window[(i + 1) % 3], i + 1, ALPHA_ODD, BETA_ODD);
+    }
+
+    expand_block(window[NUMSTEP % 3], window[(NUMSTEP + 2) % 3], window[(NUMSTEP + 1) % 3]);
+
+    for (size_t i = 0; i < 8; ++i) {
+        cv[i] ^= window[NUMSTEP % 3][i];
+    }
+}
+
 void lsh512_init(lsh512_context* ctx)
 {
     ctx->bidx = 0;
@@ -282,3 +319,73 @@ void lsh512_final(lsh512_context* ctx, uint8_t* digest)
 
     lsh512_init(ctx);
 }
+
+void lsh512_init_compact(lsh512_compact_context* ctx)
+{
+    ctx->bidx = 0;
+    ctx->length = 0;
+    memset(ctx->block, 0, BLOCKSIZE);
+
+    memcpy(ctx->cv, IV, 16 * sizeof(uint64_t));
+}
+
+void lsh512_update_compact(lsh512_compact_context* ctx, const uint8_t* data, size_t length)
+{
+    ctx->length += length;
+
+    if (ctx->bidx > 0) {
+        size_t gap = BLOCKSIZE - ctx->bidx;
+
+        if (length >= gap) {
+            memcpy(ctx->block + ctx->bidx, data, gap);
+            compress_rolling((__m128i*) ctx->cv, ctx->block);
+            ctx->bidx = 0;
+            data += gap;
+            length -= gap;
+
+        } else {
+            memcpy(ctx->block + ctx->bidx, data, length);
+            ctx->bidx += length;
+            data += length;
+            length = 0;
+        }
+    }
+    
+    while (length >= BLOCKSIZE) {
+        compress_rolling((__m128i*) ctx->cv, data);
+        data += BLOCKSIZE;
+        length -= BLOCKSIZE;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->block + ctx->bidx, data, length);
+        ctx->bidx += length;
+    }
+}
+
+void lsh512_final_compact(lsh512_compact_context* ctx, uint8_t* digest)
+{
+    uint64_t* result = (uint64_t*) digest;
+
+    ctx->block[(ctx->bidx)++] = (uint8_t) 0x80;
+    memset(ctx->block + ctx->bidx, 0, BLOCKSIZE - ctx->bidx);
+    compress_rolling((__m128i*) ctx->cv, ctx->block);
+
+    for (size_t i = 0; i < 8; ++i) {
+        result[i] = ctx->cv[i] ^ ctx->cv[i + 8];
+    }
+
+    lsh512_init_compact(ctx);
+}
+
+// one message after the other, only the AVX2 backend hashes them in parallel lanes
+void lsh512_hash_x4(uint8_t* const digests[4], const uint8_t* const msgs[4], const size_t lens[4])
+{
+    lsh512_context ctx;
+
+    for (size_t i = 0; i < 4; ++i) {
+        lsh512_init(&ctx);
+        lsh512_update(&ctx, msgs[i], lens[i]);
+        lsh512_final(&ctx, digests[i]);
+    }
+}
@@ -1,5 +1,11 @@
 #include "lsh.h"
+
+#ifdef LSH_TEST_DISPATCH
+#include "lsh.dispatch.h"
+#endif
+
 #include <stdio.h>
+#include <string.h>
 
 static void print_hex(const uint8_t* data, size_t count)
 {
@@ -52,10 +58,160 @@ void test_lsh512()
     print_hex(digest, 64);
 }
 
-int main()
+// lengths around the block boundaries and one message much longer than the others
+const static size_t TEST_LENGTHS[] = {0, 1, 127, 128, 129, 255, 256, 1000, 4096};
+
+void test_lsh256_x8()
+{
+    uint8_t data[4096] = {0, };
+    uint8_t digests[8][32] = {{0, }};
+    uint8_t expected[32] = {0, };
+    uint8_t* outs[8];
+    const uint8_t* msgs[8];
+    size_t lens[8];
+    int passed = 1;
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t) (i * 7 + 1);
+    }
+
+    for (size_t shift = 0; shift < 2; ++shift) {
+        for (size_t l = 0; l < 8; ++l) {
+            outs[l] = digests[l];
+            lens[l] = TEST_LENGTHS[(l + shift) % 9];
+            msgs[l] = data + l;
+            if (lens[l] + l > sizeof(data)) {
+                lens[l] -= l;
+            }
+        }
+
+        lsh256_hash_x8(outs, msgs, lens);
+
+        for (size_t l = 0; l < 8; ++l) {
+            lsh256_context ctx;
+            lsh256_init(&ctx);
+            lsh256_update(&ctx, msgs[l], lens[l]);
+            lsh256_final(&ctx, expected);
+
+            passed &= memcmp(expected, digests[l], 32) == 0;
+        }
+    }
+
+    printf("lsh256_hash_x8 %s\n\n", passed ? "passed" : "failed");
+}
+
+void test_lsh512_x4()
+{
+    uint8_t data[4096] = {0, };
+    uint8_t digests[4][64] = {{0, }};
+    uint8_t expected[64] = {0, };
+    uint8_t* outs[4];
+    const uint8_t* msgs[4];
+    size_t lens[4];
+    int passed = 1;
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t) (i * 7 + 1);
+    }
+
+    for (size_t shift = 0; shift < 9; shift += 4) {
+        for (size_t l = 0; l < 4; ++l) {
+            outs[l] = digests[l];
+            lens[l] = TEST_LENGTHS[(l + shift) % 9];
+            msgs[l] = data + l;
+            if (lens[l] + l > sizeof(data)) {
+                lens[l] -= l;
+            }
+        }
+
+        lsh512_hash_x4(outs, msgs, lens);
+
+        for (size_t l = 0; l < 4; ++l) {
+            lsh512_context ctx;
+            lsh512_init(&ctx);
+            lsh512_update(&ctx, msgs[l], lens[l]);
+            lsh512_final(&ctx, expected);
+
+            passed &= memcmp(expected, digests[l], 64) == 0;
+        }
+    }
+
+    printf("lsh512_hash_x4 %s\n\n", passed ? "passed" : "failed");
+}
+
+// the compact contexts against the full ones, fed in uneven chunks so that updates straddle the blocks
+void test_lsh_compact()
+{
+    uint8_t data[4096] = {0, };
+    uint8_t expected[64] = {0, };
+    uint8_t digest[64] = {0, };
+    int passed = 1;
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t) (i * 7 + 1);
+    }
+
+    for (size_t t = 0; t < sizeof(TEST_LENGTHS) / sizeof(TEST_LENGTHS[0]); ++t) {
+        size_t length = TEST_LENGTHS[t];
+
+        lsh256_context ctx256;
+        lsh256_compact_context compact256;
+        lsh512_context ctx512;
+        lsh512_compact_context compact512;
+
+        lsh256_init(&ctx256);
+        lsh256_update(&ctx256, data, length);
+        lsh256_final(&ctx256, expected);
+
+        lsh256_init_compact(&compact256);
+        for (size_t i = 0; i < length; i += 97) {
+            lsh256_update_compact(&compact256, data + i, length - i < 97 ? length - i : 97);
+        }
+        lsh256_final_compact(&compact256, digest);
+        passed &= memcmp(expected, digest, 32) == 0;
+
+        lsh512_init(&ctx512);
+        lsh512_update(&ctx512, data, length);
+        lsh512_final(&ctx512, expected);
+
+        lsh512_init_compact(&compact512);
+        for (size_t i = 0; i < length; i += 97) {
+            lsh512_update_compact(&compact512, data + i, length - i < 97 ? length - i : 97);
+        }
+        lsh512_final_compact(&compact512, digest);
+        passed &= memcmp(expected, digest, 64) == 0;
+    }
+
+    printf("lsh compact contexts (%ld and %ld bytes) %s\n\n", sizeof(lsh256_compact_context), sizeof(lsh512_compact_context), passed ? "passed" : "failed");
+}
+
+static void run_tests(void)
 {
     test_lsh256();
     test_lsh512();
-    
+    test_lsh256_x8();
+    test_lsh512_x4();
+    test_lsh_compact();
+}
+
+int main()
+{
+#ifdef LSH_TEST_DISPATCH
+    // every backend this cpu supports, not only the one bound at startup
+    const char* backends[] = {"avx2", "sse4", "generic"};
+
+    for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); ++i) {
+        if (lsh_select_backend(backends[i]) != 0) {
+            printf("backend %s not supported, skipped\n\n", backends[i]);
+            continue;
+        }
+
+        printf("backend %s\n\n", lsh_backend_name());
+        run_tests();
+    }
+#else
+    run_tests();
+#endif
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cbc.h"
+#include "util.inc"
+
+// number of ciphertext blocks decrypted at once, rounded down to a multiple of the cipher batch
+#define CBC_BATCH_BLOCKS 32
+
+// largest supported block size
+#define CBC_MAX_BLOCKSIZE 16
+
+void cbc_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* iv, size_t length, const block_cipher* cipher)
+{
+    uint8_t block[CBC_MAX_BLOCKSIZE];
+    size_t blocksize = cipher->blocksize;
+    const uint8_t* prev = iv;
+
+    while (length >= blocksize) {
+        xor(block, pt, prev, blocksize);
+        cipher->encrypt(ct, block, rks);
+        prev = ct;
+
+        pt += blocksize;
+        ct += blocksize;
+        length -= blocksize;
+    }
+}
+
+void cbc_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, const uint8_t* iv, size_t length, const block_cipher* cipher)
+{
+    uint8_t buffer[CBC_BATCH_BLOCKS * CBC_MAX_BLOCKSIZE];
+    uint8_t prev[CBC_MAX_BLOCKSIZE];
+    size_t blocksize = cipher->blocksize;
+    size_t batch = cipher_batch_blocks(cipher, CBC_BATCH_BLOCKS);
+    size_t nblocks = length / blocksize;
+
+    memcpy(prev, iv, blocksize);
+
+    while (nblocks > 0) {
+        size_t count = nblocks < batch ? nblocks : batch;
+        size_t chunk = count * blocksize;
+
+        cipher_decrypt_blocks(cipher, buffer, ct, count, rks);
+
+        // every ciphertext is read before pt is written, so pt may alias ct
+        xor(buffer, buffer, prev, blocksize);
+        xor(buffer + blocksize, buffer + blocksize, ct, chunk - blocksize);
+        memcpy(prev, ct + chunk - blocksize, blocksize);
+        memcpy(pt, buffer, chunk);
+
+        ct += chunk;
+        pt += chunk;
+        nblocks -= count;
+    }
+}
+
+static void cbc_init(cbc_context* ctx, const uint8_t* rks, const uint8_t* iv, int decrypt, const block_cipher* cipher)
+{
+    ctx->cipher = cipher;
+    ctx->rks = rks;
+    ctx->decrypt = decrypt;
+    ctx->bidx = 0;
+    memset(ctx->iv, 0, sizeof(ctx->iv));
+    memset(ctx->block, 0, sizeof(ctx->block));
+
+    if (iv != NULL) {
+        memcpy(ctx->iv, iv, cipher->blocksize);
+    }
+}
+
+void cbc_encrypt_init(cbc_context* ctx, const uint8_t* rks, const uint8_t* iv, const block_cipher* cipher)
+{
+    cbc_init(ctx, rks, iv, 0, cipher);
+}
+
+void cbc_decrypt_init(cbc_context* ctx, const uint8_t* drks, const uint8_t* iv, const block_cipher* cipher)
+{
+    cbc_init(ctx, drks, iv, 1, cipher);
+}
+
+// whole blocks, the last ciphertext block becomes the chaining value of the next update
+static void cbc_process(cbc_context* ctx, uint8_t* out, const uint8_t* in, size_t length)
+{
+    size_t blocksize = ctx->cipher->blocksize;
+    uint8_t last[CBC_MAX_BLOCKSIZE];
+
+    if (length == 0) {
+        return;
+    }
+
+    if (ctx->decrypt) {
+        memcpy(last, in + length - blocksize, blocksize);
+        cbc_decrypt(out, in, ctx->rks, ctx->iv, length, ctx->cipher);
+    } else {
+        cbc_encrypt(out, in, ctx->rks, ctx->iv, length, ctx->cipher);
+        memcpy(last, out + length - blocksize, blocksize);
+    }
+
+    memcpy(ctx->iv, last, blocksize);
+}
+
+size_t cbc_update(cbc_context* ctx, uint8_t* out, const uint8_t* in, size_t length)
+{
+    size_t blocksize = ctx->cipher->blocksize;
+    size_t written = 0;
+
+    if (ctx->bidx > 0) {
+        size_t gap = blocksize - ctx->bidx;
+
+        if (length < gap) {
+            memcpy(ctx->block + ctx->bidx, in, length);
+            ctx->bidx += length;
+            return 0;
+        }
+
+        memcpy(ctx->block + ctx->bidx, in, gap);
+        cbc_process(ctx, out, ctx->block, blocksize);
+        ctx->bidx = 0;
+
+        in += gap;
+        out += blocksize;
+        length -= gap;
+        written += blocksize;
+    }
+
+    size_t whole = length - (length % blocksize);
+    cbc_process(ctx, out, in, whole);
+    written += whole;
+
+    memcpy(ctx->block, in + whole, length - whole);
+    ctx->bidx = length - whole;
+
+    return written;
+}
+
+size_t cbc_final(cbc_context* ctx)
+{
+    size_t remains = ctx->bidx;
+
+    cbc_init(ctx, ctx->rks, NULL, ctx->decrypt, ctx->cipher);
+
+    return remains;
+}
+
+size_t pkcs7_padded_length(size_t length, size_t blocksize)
+{
+    return length - (length % blocksize) + blocksize;
+}
+
+size_t pkcs7_pad(uint8_t* data, size_t length, size_t blocksize)
+{
+    size_t padded = pkcs7_padded_length(length, blocksize);
+    uint8_t value = (uint8_t) (padded - length);
+
+    memset(data + length, value, value);
+
+    return padded;
+}
+
+int pkcs7_unpad(const uint8_t* data, size_t length, size_t blocksize, size_t* unpadded)
+{
+    if (length == 0 || length % blocksize != 0) {
+        return -1;
+    }
+
+    const uint8_t* last = data + length - blocksize;
+    size_t value = last[blocksize - 1];
+    size_t bad = (value == 0) | (value > blocksize);
+
+    // every byte of the last block is checked, whatever the padding length is
+    for (size_t i = 0; i < blocksize; ++i) {
+        size_t in_padding = (blocksize - i) <= value;
+        bad |= in_padding & (last[i] != value);
+    }
+
+    if (bad) {
+        return -1;
+    }
+
+    *unpadded = length - value;
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "cipher.h"
+
+/**
+ * CBC mode over whole blocks, a trailing partial block is ignored like in ECB.
+ * Encryption is serial, decryption runs the cipher's multi-block path over batches of ciphertext.
+ * Both work in place. The block size is at most 16 bytes.
+ */
+void cbc_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* iv, size_t length, const block_cipher* cipher);
+void cbc_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, const uint8_t* iv, size_t length, const block_cipher* cipher);
+
+/**
+ * Streaming CBC, the chaining value is carried across updates. An update of any length writes
+ * every block it completes to out and returns the number of bytes written, a partial block is
+ * kept in the context until the next update. out may alias in when no partial block is pending.
+ * cbc_final returns the number of trailing bytes that never formed a block, which are dropped
+ * like in cbc_encrypt, and clears the context.
+ */
+typedef struct st_cbc_context {
+    const block_cipher* cipher;
+    const uint8_t* rks;
+    int decrypt;
+    size_t bidx;
+    uint8_t iv[16];
+    uint8_t block[16];
+} cbc_context;
+
+void cbc_encrypt_init(cbc_context* ctx, const uint8_t* rks, const uint8_t* iv, const block_cipher* cipher);
+void cbc_decrypt_init(cbc_context* ctx, const uint8_t* drks, const uint8_t* iv, const block_cipher* cipher);
+size_t cbc_update(cbc_context* ctx, uint8_t* out, const uint8_t* in, size_t length);
+size_t cbc_final(cbc_context* ctx);
+
+/**
+ * PKCS#7 padding. pkcs7_pad appends the padding to the length bytes in data, which must have room
+ * for pkcs7_padded_length(length, blocksize) bytes, and returns the padded length.
+ * pkcs7_unpad checks the padding of length bytes without branching on the data and stores the
+ * unpadded length; it returns 0 on success and -1 for invalid padding.
+ */
+size_t pkcs7_padded_length(size_t length, size_t blocksize);
+size_t pkcs7_pad(uint8_t* data, size_t length, size_t blocksize);
+int pkcs7_unpad(const uint8_t* data, size_t length, size_t blocksize, size_t* unpadded);
@@ -0,0 +1,108 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cbc_mb.h"
+#include "util.inc"
+
+#define CBC_MB_MAX_LANES 16
+
+// largest supported block size
+#define CBC_MB_MAX_BLOCKSIZE 16
+
+// the interleaved LEA-256 round keys of 16 lanes
+#define CBC_MB_MAX_KEYS_SIZE (16 * 6 * 32 * 4)
+
+void cbc_encrypt_jobs(cbc_job* jobs, size_t njobs, const lane_cipher* cipher)
+{
+    __attribute__ ((aligned(32))) uint8_t keys[CBC_MB_MAX_KEYS_SIZE];
+    __attribute__ ((aligned(32))) uint8_t state[CBC_MB_MAX_LANES * CBC_MB_MAX_BLOCKSIZE];
+    const cbc_job* lane_job[CBC_MB_MAX_LANES] = {NULL};
+    size_t lane_offset[CBC_MB_MAX_LANES] = {0};
+    size_t blocksize = cipher->blocksize;
+    size_t lanes = cipher->lanes;
+    size_t active = 0;
+    size_t next = 0;
+
+    if (njobs == 0) {
+        return;
+    }
+
+    // idle lanes run on the key of the first job, their output is dropped
+    memset(state, 0, sizeof(state));
+    for (size_t i = 0; i < lanes; ++i) {
+        cipher->set_key(keys, i, jobs[0].rks);
+    }
+
+    for (;;) {
+        // refill the idle lanes from the queue
+        for (size_t i = 0; i < lanes; ++i) {
+            if (lane_job[i] != NULL) {
+                continue;
+            }
+
+            while (next < njobs && jobs[next].length < blocksize) {
+                ++next;
+            }
+
+            if (next == njobs) {
+                continue;
+            }
+
+            lane_job[i] = &jobs[next++];
+            lane_offset[i] = 0;
+            cipher->set_key(keys, i, lane_job[i]->rks);
+            memcpy(state + i * blocksize, lane_job[i]->iv, blocksize);
+            ++active;
+        }
+
+        if (active == 0) {
+            break;
+        }
+
+        for (size_t i = 0; i < lanes; ++i) {
+            if (lane_job[i] != NULL) {
+                xor(state + i * blocksize, state + i * blocksize, lane_job[i]->pt + lane_offset[i], blocksize);
+            }
+        }
+
+        cipher->encrypt(state, state, keys);
+
+        for (size_t i = 0; i < lanes; ++i) {
+            if (lane_job[i] == NULL) {
+                continue;
+            }
+
+            memcpy(lane_job[i]->ct + lane_offset[i], state + i * blocksize, blocksize);
+            lane_offset[i] += blocksize;
+
+            if (lane_job[i]->length - lane_offset[i] < blocksize) {
+                lane_job[i] = NULL;
+                --active;
+            }
+        }
+    }
+}
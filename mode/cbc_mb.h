@@ -0,0 +1,48 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "cipher.h"
+
+/**
+ * One CBC encryption session: length bytes of whole blocks from pt to ct under its own round keys and iv.
+ */
+typedef struct st_cbc_job {
+    uint8_t* ct;
+    const uint8_t* pt;
+    size_t length;
+    const uint8_t* rks;
+    const uint8_t* iv;
+} cbc_job;
+
+/**
+ * Multi-buffer CBC encryption of independent sessions.
+ * The jobs are taken in order into the lanes of the cipher and advanced in lockstep,
+ * a lane which finishes its job is refilled with the next one.
+ */
+void cbc_encrypt_jobs(cbc_job* jobs, size_t njobs, const lane_cipher* cipher);
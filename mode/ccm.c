@@ -0,0 +1,276 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ccm.h"
+#include "ctr.h"
+#include "util.inc"
+
+static int ccm_check(size_t length, size_t taglen, size_t noncelen, const block_cipher* cipher)
+{
+    size_t q = 15 - noncelen;
+
+    if (cipher->blocksize != 16 || noncelen < 7 || noncelen > 13) {
+        return -1;
+    }
+
+    if (taglen < 4 || taglen > 16 || (taglen & 1) != 0) {
+        return -1;
+    }
+
+    if (q < 8 && (uint64_t) length >= ((uint64_t) 1 << (8 * q))) {
+        return -1;
+    }
+
+    return 0;
+}
+
+// writes value big-endian into the last q bytes of the block
+static void store_length(uint8_t* block, size_t q, uint64_t value)
+{
+    for (size_t i = 0; i < q; ++i) {
+        block[15 - i] = (i < 8) ? (uint8_t) (value >> (8 * i)) : 0;
+    }
+}
+
+// counter block A_i, flags || nonce || i
+static void build_counter(uint8_t* ctr, const uint8_t* nonce, size_t noncelen, uint64_t index)
+{
+    size_t q = 15 - noncelen;
+
+    ctr[0] = (uint8_t) (q - 1);
+    memcpy(ctr + 1, nonce, noncelen);
+    store_length(ctr, q, index);
+}
+
+// A_i to A_i+1, the length check keeps the carry inside the counter field
+static void increase_counter(uint8_t* ctr)
+{
+    size_t idx = 15;
+    while ( (++ctr[idx]) == 0 && idx != 0) {
+        --idx;
+    }
+}
+
+/**
+ * CBC-MAC over B_0 and the encoded associated data, leaving the chaining value in mac.
+ * E(A_0), which masks the tag, is computed in the same call as the first MAC block.
+ */
+static void ccm_header(uint8_t* mac, uint8_t* s0, size_t taglen, size_t length, const uint8_t* aad, size_t aadlen, const uint8_t* nonce, size_t noncelen, const uint8_t* rks, const block_cipher* cipher)
+{
+    uint8_t blocks[32];
+    uint8_t block[16] = {0};
+    size_t q = 15 - noncelen;
+    size_t used;
+
+    blocks[0] = (uint8_t) (((aadlen > 0) << 6) | (((taglen - 2) / 2) << 3) | (q - 1));
+    memcpy(blocks + 1, nonce, noncelen);
+    store_length(blocks, q, length);
+    build_counter(blocks + 16, nonce, noncelen, 0);
+
+    cipher_encrypt_blocks(cipher, blocks, blocks, 2, rks);
+    memcpy(mac, blocks, 16);
+    memcpy(s0, blocks + 16, 16);
+
+    if (aadlen == 0) {
+        return;
+    }
+
+    if ((uint64_t) aadlen < 0xff00) {
+        block[0] = (uint8_t) (aadlen >> 8);
+        block[1] = (uint8_t) aadlen;
+        used = 2;
+    } else if ((uint64_t) aadlen <= 0xffffffff) {
+        block[0] = 0xff;
+        block[1] = 0xfe;
+        store32_be(block + 2, (uint32_t) aadlen);
+        used = 6;
+    } else {
+        block[0] = 0xff;
+        block[1] = 0xff;
+        store64_be(block + 2, (uint64_t) aadlen);
+        used = 10;
+    }
+
+    while (aadlen > 0) {
+        size_t chunk = 16 - used;
+        if (chunk > aadlen) {
+            chunk = aadlen;
+        }
+
+        memcpy(block + used, aad, chunk);
+        xor(mac, mac, block, used + chunk);
+        cipher->encrypt(mac, mac, rks);
+
+        memset(block, 0, 16);
+        aad += chunk;
+        aadlen -= chunk;
+        used = 0;
+    }
+}
+
+/**
+ * pairing each MAC block with a CTR block only pays off when the multi-block path runs two
+ * blocks side by side. Otherwise the CBC-MAC chain and CTR over the whole payload, through
+ * the wide or fused CTR kernels, run as two passes.
+ */
+static int ccm_interleaved(const block_cipher* cipher)
+{
+    return cipher->encrypt_blocks != NULL && cipher->parallel != 0 && cipher->parallel <= 2;
+}
+
+// continues the CBC-MAC chain in mac over data, the last block zero padded
+static void ccm_mac(uint8_t* mac, const uint8_t* data, size_t length, const uint8_t* rks, const block_cipher* cipher)
+{
+    while (length > 0) {
+        size_t chunk = (length < 16) ? length : 16;
+
+        xor(mac, mac, data, chunk);
+        cipher->encrypt(mac, mac, rks);
+
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+// each step encrypts the MAC input of P_i together with the counter block A_i
+static void ccm_encrypt_interleaved(uint8_t* mac, uint8_t* ct, const uint8_t* pt, size_t length, uint8_t* ctr, const uint8_t* rks, const block_cipher* cipher)
+{
+    uint8_t blocks[32];
+
+    memcpy(blocks, mac, 16);
+
+    while (length > 0) {
+        size_t chunk = (length < 16) ? length : 16;
+
+        xor(blocks, blocks, pt, chunk);
+        memcpy(blocks + 16, ctr, 16);
+        increase_counter(ctr);
+
+        cipher_encrypt_blocks(cipher, blocks, blocks, 2, rks);
+        xor(ct, pt, blocks + 16, chunk);
+
+        pt += chunk;
+        ct += chunk;
+        length -= chunk;
+    }
+
+    memcpy(mac, blocks, 16);
+}
+
+/**
+ * P_i is only known after its keystream block, so each step encrypts A_i together
+ * with the MAC input of the previous plaintext block, which is still in pt.
+ */
+static void ccm_decrypt_interleaved(uint8_t* mac, uint8_t* pt, const uint8_t* ct, size_t length, uint8_t* ctr, const uint8_t* rks, const block_cipher* cipher)
+{
+    uint8_t blocks[32];
+    size_t pending = 0;
+
+    while (length > 0) {
+        size_t chunk = (length < 16) ? length : 16;
+
+        xor(blocks, mac, pt - pending, pending);
+        memcpy(blocks + pending, mac + pending, 16 - pending);
+        memcpy(blocks + 16, ctr, 16);
+        increase_counter(ctr);
+
+        cipher_encrypt_blocks(cipher, blocks, blocks, 2, rks);
+        if (pending > 0) {
+            memcpy(mac, blocks, 16);
+        }
+        xor(pt, ct, blocks + 16, chunk);
+
+        pt += chunk;
+        ct += chunk;
+        length -= chunk;
+        pending = chunk;
+    }
+
+    ccm_mac(mac, pt - pending, pending, rks, cipher);
+}
+
+int ccm_encrypt(uint8_t* ct, uint8_t* tag, size_t taglen, const uint8_t* pt, size_t length, const uint8_t* aad, size_t aadlen, const uint8_t* nonce, size_t noncelen, const uint8_t* rks, const block_cipher* cipher)
+{
+    uint8_t mac[16];
+    uint8_t ctr[16];
+    uint8_t s0[16];
+
+    if (ccm_check(length, taglen, noncelen, cipher) != 0) {
+        return -1;
+    }
+
+    ccm_header(mac, s0, taglen, length, aad, aadlen, nonce, noncelen, rks, cipher);
+    build_counter(ctr, nonce, noncelen, 1);
+
+    // the MAC reads pt before ctr_encrypt overwrites it in place
+    if (ccm_interleaved(cipher)) {
+        ccm_encrypt_interleaved(mac, ct, pt, length, ctr, rks, cipher);
+    } else {
+        ccm_mac(mac, pt, length, rks, cipher);
+        ctr_encrypt(ct, pt, rks, ctr, length, cipher);
+    }
+
+    xor(tag, mac, s0, taglen);
+
+    return 0;
+}
+
+int ccm_decrypt(uint8_t* pt, const uint8_t* ct, size_t length, const uint8_t* tag, size_t taglen, const uint8_t* aad, size_t aadlen, const uint8_t* nonce, size_t noncelen, const uint8_t* rks, const block_cipher* cipher)
+{
+    uint8_t mac[16];
+    uint8_t ctr[16];
+    uint8_t s0[16];
+    uint8_t expected[16];
+    uint8_t diff = 0;
+
+    if (ccm_check(length, taglen, noncelen, cipher) != 0) {
+        return -1;
+    }
+
+    ccm_header(mac, s0, taglen, length, aad, aadlen, nonce, noncelen, rks, cipher);
+    build_counter(ctr, nonce, noncelen, 1);
+
+    if (ccm_interleaved(cipher)) {
+        ccm_decrypt_interleaved(mac, pt, ct, length, ctr, rks, cipher);
+    } else {
+        ctr_decrypt(pt, ct, rks, ctr, length, cipher);
+        ccm_mac(mac, pt, length, rks, cipher);
+    }
+
+    xor(expected, mac, s0, taglen);
+
+    for (size_t i = 0; i < taglen; ++i) {
+        diff |= expected[i] ^ tag[i];
+    }
+
+    if (diff != 0) {
+        memset(pt, 0, length);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "cipher.h"
+
+/**
+ * CCM authenticated encryption, NIST SP 800-38C, for 16-byte block ciphers.
+ * The nonce is 7 to 13 bytes and the tag 4, 6, ..., 16 bytes; length must fit in the
+ * 15 - noncelen bytes of the length field. For ciphers whose multi-block path runs two blocks
+ * side by side (parallel of 2 or less), the CBC-MAC block and the CTR block of each step are
+ * encrypted together, so the data is read once; otherwise the CBC-MAC chain runs first and
+ * CTR over the whole payload.
+ * Both work in place and return -1 for invalid parameters.
+ * ccm_decrypt also returns -1 when the tag does not match, in which case pt is zeroed.
+ */
+int ccm_encrypt(uint8_t* ct, uint8_t* tag, size_t taglen, const uint8_t* pt, size_t length, const uint8_t* aad, size_t aadlen, const uint8_t* nonce, size_t noncelen, const uint8_t* rks, const block_cipher* cipher);
+int ccm_decrypt(uint8_t* pt, const uint8_t* ct, size_t length, const uint8_t* tag, size_t taglen, const uint8_t* aad, size_t aadlen, const uint8_t* nonce, size_t noncelen, const uint8_t* rks, const block_cipher* cipher);
@@ -0,0 +1,57 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cipher.h"
+#include "../aes/aes.h"
+
+// the AES-NI and bitsliced backends run 8 blocks at a time and VAES 16, 2 blocks already side by side
+// CTR goes to aes*_ctr_blocks, which AES-NI and VAES run on counters built in registers
+// decryption takes the equivalent inverse cipher schedule of aes*_keygen_dec, so no block pays for AESIMC
+
+const block_cipher CIPHER_AES128 = {
+    "AES-128", 16, 16, (AES128_ROUNDS + 1) * 16, 16, 2,
+    aes128_keygen, aes128_keygen_dec,
+    aes128_encrypt, aes128_decrypt_eqinv,
+    aes128_encrypt_blocks, aes128_decrypt_blocks_eqinv,
+    aes128_ctr_blocks,
+};
+
+const block_cipher CIPHER_AES192 = {
+    "AES-192", 16, 24, (AES192_ROUNDS + 1) * 16, 16, 2,
+    aes192_keygen, aes192_keygen_dec,
+    aes192_encrypt, aes192_decrypt_eqinv,
+    aes192_encrypt_blocks, aes192_decrypt_blocks_eqinv,
+    aes192_ctr_blocks,
+};
+
+const block_cipher CIPHER_AES256 = {
+    "AES-256", 16, 32, (AES256_ROUNDS + 1) * 16, 16, 2,
+    aes256_keygen, aes256_keygen_dec,
+    aes256_encrypt, aes256_decrypt_eqinv,
+    aes256_encrypt_blocks, aes256_decrypt_blocks_eqinv,
+    aes256_ctr_blocks,
+};
@@ -0,0 +1,53 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cipher.h"
+#include "../aria/aria.h"
+
+const block_cipher CIPHER_ARIA128 = {
+    "ARIA-128", 16, 16, 13 * 16, 1, 0,
+    aria128_expand_key_enc, aria128_expand_key_dec,
+    aria128_encrypt, aria128_decrypt,
+    NULL, NULL,
+    NULL,
+};
+
+const block_cipher CIPHER_ARIA192 = {
+    "ARIA-192", 16, 24, 15 * 16, 1, 0,
+    aria192_expand_key_enc, aria192_expand_key_dec,
+    aria192_encrypt, aria192_decrypt,
+    NULL, NULL,
+    NULL,
+};
+
+const block_cipher CIPHER_ARIA256 = {
+    "ARIA-256", 16, 32, 17 * 16, 1, 0,
+    aria256_expand_key_enc, aria256_expand_key_dec,
+    aria256_encrypt, aria256_decrypt,
+    NULL, NULL,
+    NULL,
+};
@@ -0,0 +1,53 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cipher.h"
+#include "../cham/cham.h"
+
+const block_cipher CIPHER_CHAM64 = {
+    "CHAM-64/128", 8, 16, 2 * 16, 1, 0,
+    cham64_keygen, cham64_keygen,
+    cham64_encrypt, cham64_decrypt,
+    NULL, NULL,
+    NULL,
+};
+
+const block_cipher CIPHER_CHAM128 = {
+    "CHAM-128/128", 16, 16, 2 * 16, 1, 0,
+    cham128_keygen, cham128_keygen,
+    cham128_encrypt, cham128_decrypt,
+    NULL, NULL,
+    NULL,
+};
+
+const block_cipher CIPHER_CHAM256 = {
+    "CHAM-128/256", 16, 32, 4 * 16, 1, 0,
+    cham256_keygen, cham256_keygen,
+    cham256_encrypt, cham256_decrypt,
+    NULL, NULL,
+    NULL,
+};
@@ -0,0 +1,155 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef void (*block_func)(uint8_t* dst, const uint8_t* src, const uint8_t* rks);
+typedef void (*blocks_func)(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks);
+typedef void (*keygen_func)(uint8_t* rks, const uint8_t* mk);
+typedef void (*ctr_func)(uint8_t* dst, const uint8_t* src, size_t nblocks, uint8_t* ctr, const uint8_t* rks);
+
+/**
+ * Block cipher descriptor consumed by the modes.
+ * encrypt_blocks/decrypt_blocks take any number of blocks and may be NULL, in which case
+ * the modes fall back to the single block functions. batch is the number of blocks the
+ * multi-block functions process at once, and the modes hand them multiples of it.
+ * parallel is the fewest blocks encrypt_blocks runs side by side rather than one after
+ * another, 0 without a multi-block path; serial modes pair blocks only when it is 2 or less.
+ * Ciphers with separate decryption round keys set keygen_dec, otherwise it is keygen.
+ * ctr_blocks, when set, applies the CTR keystream of a big-endian counter over the whole
+ * block to nblocks blocks and advances the counter, without writing the counter blocks out.
+ */
+typedef struct st_block_cipher {
+    const char* name;
+    size_t blocksize;
+    size_t keysize;
+    size_t rks_size;
+    size_t batch;
+    size_t parallel;
+    keygen_func keygen;
+    keygen_func keygen_dec;
+    block_func encrypt;
+    block_func decrypt;
+    blocks_func encrypt_blocks;
+    blocks_func decrypt_blocks;
+    ctr_func ctr_blocks;
+} block_cipher;
+
+/**
+ * Multi-buffer descriptor: encrypt takes one block for each of the lanes, every lane
+ * with its own key, which set_key installs from the usual round keys into keys of keys_size bytes.
+ */
+typedef struct st_lane_cipher {
+    const char* name;
+    size_t blocksize;
+    size_t lanes;
+    size_t keys_size;
+    void (*set_key)(uint8_t* keys, size_t lane, const uint8_t* rks);
+    void (*encrypt)(uint8_t* dst, const uint8_t* src, const uint8_t* keys);
+} lane_cipher;
+
+// cipher.aes.c
+extern const block_cipher CIPHER_AES128;
+extern const block_cipher CIPHER_AES192;
+extern const block_cipher CIPHER_AES256;
+
+// cipher.aria.c
+extern const block_cipher CIPHER_ARIA128;
+extern const block_cipher CIPHER_ARIA192;
+extern const block_cipher CIPHER_ARIA256;
+
+// cipher.cham.c
+extern const block_cipher CIPHER_CHAM64;
+extern const block_cipher CIPHER_CHAM128;
+extern const block_cipher CIPHER_CHAM256;
+
+// cipher.hight.c
+extern const block_cipher CIPHER_HIGHT;
+
+// cipher.lea.c
+extern const block_cipher CIPHER_LEA128;
+extern const block_cipher CIPHER_LEA192;
+extern const block_cipher CIPHER_LEA256;
+
+// cipher.seed.c
+extern const block_cipher CIPHER_SEED;
+
+// lanes.aes.c, AES-NI
+extern const lane_cipher LANES_AES128;
+extern const lane_cipher LANES_AES192;
+extern const lane_cipher LANES_AES256;
+
+// lanes.lea.c, AVX2
+extern const lane_cipher LANES_LEA128_X8;
+extern const lane_cipher LANES_LEA192_X8;
+extern const lane_cipher LANES_LEA256_X8;
+extern const lane_cipher LANES_LEA128_X16;
+extern const lane_cipher LANES_LEA192_X16;
+extern const lane_cipher LANES_LEA256_X16;
+
+static inline void cipher_encrypt_blocks(const block_cipher* cipher, uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    if (cipher->encrypt_blocks != NULL) {
+        cipher->encrypt_blocks(dst, src, nblocks, rks);
+        return;
+    }
+
+    for (size_t i = 0; i < nblocks; ++i) {
+        cipher->encrypt(dst, src, rks);
+        dst += cipher->blocksize;
+        src += cipher->blocksize;
+    }
+}
+
+static inline void cipher_decrypt_blocks(const block_cipher* cipher, uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    if (cipher->decrypt_blocks != NULL) {
+        cipher->decrypt_blocks(dst, src, nblocks, rks);
+        return;
+    }
+
+    for (size_t i = 0; i < nblocks; ++i) {
+        cipher->decrypt(dst, src, rks);
+        dst += cipher->blocksize;
+        src += cipher->blocksize;
+    }
+}
+
+// the largest multiple of the cipher batch that fits in max_blocks, at least one block
+static inline size_t cipher_batch_blocks(const block_cipher* cipher, size_t max_blocks)
+{
+    size_t batch = cipher->batch;
+
+    if (batch == 0 || batch > max_blocks) {
+        return max_blocks;
+    }
+
+    return max_blocks - (max_blocks % batch);
+}
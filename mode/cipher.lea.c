@@ -0,0 +1,119 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cipher.h"
+#include "../lea/lea.avx2.h"
+
+/**
+ * LEA has fixed width 8 and 16 block kernels (lea.avx2.c, or lea.dispatch.c on any CPU),
+ * which are adapted here to an arbitrary number of blocks. CTR goes to lea*_ctr_blocks.
+ * Encryption runs fewer than 8 blocks one at a time, so the descriptors set parallel to 8.
+ */
+static void lea_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks, block_func blk16, block_func blk8, block_func blk2, block_func blk1)
+{
+    for (; nblocks >= 16; nblocks -= 16) {
+        blk16(dst, src, rks);
+        dst += 256;
+        src += 256;
+    }
+
+    if (nblocks >= 8) {
+        blk8(dst, src, rks);
+        dst += 128;
+        src += 128;
+        nblocks -= 8;
+    }
+
+    // the decryption tail goes 2 blocks at a time (lea.c), encryption has no 2 block kernel
+    if (blk2 != NULL) {
+        for (; nblocks >= 2; nblocks -= 2) {
+            blk2(dst, src, rks);
+            dst += 32;
+            src += 32;
+        }
+    }
+
+    for (; nblocks > 0; --nblocks) {
+        blk1(dst, src, rks);
+        dst += 16;
+        src += 16;
+    }
+}
+
+static void lea128_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    lea_blocks(dst, src, nblocks, rks, lea128_encrypt_16blk, lea128_encrypt_8blk, NULL, lea128_encrypt);
+}
+
+static void lea128_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    lea_blocks(dst, src, nblocks, rks, lea128_decrypt_16blk, lea128_decrypt_8blk, lea128_decrypt_2blk, lea128_decrypt);
+}
+
+static void lea192_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    lea_blocks(dst, src, nblocks, rks, lea192_encrypt_16blk, lea192_encrypt_8blk, NULL, lea192_encrypt);
+}
+
+static void lea192_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    lea_blocks(dst, src, nblocks, rks, lea192_decrypt_16blk, lea192_decrypt_8blk, lea192_decrypt_2blk, lea192_decrypt);
+}
+
+static void lea256_encrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    lea_blocks(dst, src, nblocks, rks, lea256_encrypt_16blk, lea256_encrypt_8blk, NULL, lea256_encrypt);
+}
+
+static void lea256_decrypt_blocks(uint8_t* dst, const uint8_t* src, size_t nblocks, const uint8_t* rks)
+{
+    lea_blocks(dst, src, nblocks, rks, lea256_decrypt_16blk, lea256_decrypt_8blk, lea256_decrypt_2blk, lea256_decrypt);
+}
+
+const block_cipher CIPHER_LEA128 = {
+    "LEA-128", 16, 16, 24 * 24, 16, 8,
+    lea128_keygen, lea128_keygen,
+    lea128_encrypt, lea128_decrypt,
+    lea128_encrypt_blocks, lea128_decrypt_blocks,
+    lea128_ctr_blocks,
+};
+
+const block_cipher CIPHER_LEA192 = {
+    "LEA-192", 16, 24, 28 * 24, 16, 8,
+    lea192_keygen, lea192_keygen,
+    lea192_encrypt, lea192_decrypt,
+    lea192_encrypt_blocks, lea192_decrypt_blocks,
+    lea192_ctr_blocks,
+};
+
+const block_cipher CIPHER_LEA256 = {
+    "LEA-256", 16, 32, 32 * 24, 16, 8,
+    lea256_keygen, lea256_keygen,
+    lea256_encrypt, lea256_decrypt,
+    lea256_encrypt_blocks, lea256_decrypt_blocks,
+    lea256_ctr_blocks,
+};
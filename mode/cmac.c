@@ -0,0 +1,149 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cmac.h"
+#include "util.inc"
+
+// doubling in GF(2^n), the reduction constant is 0x87 for 128-bit and 0x1b for 64-bit blocks
+static void cmac_double(uint8_t* out, const uint8_t* in, size_t blocksize)
+{
+    uint8_t rb = (blocksize == 16) ? 0x87 : 0x1b;
+    uint8_t carry = 0 - (in[0] >> 7);
+
+    for (size_t i = 0; i < blocksize - 1; ++i) {
+        out[i] = (uint8_t) ((in[i] << 1) | (in[i + 1] >> 7));
+    }
+
+    out[blocksize - 1] = (uint8_t) ((in[blocksize - 1] << 1) ^ (carry & rb));
+}
+
+int cmac_init_key(cmac_key* key, const uint8_t* rks, const block_cipher* cipher)
+{
+    uint8_t l[16] = {0};
+
+    if (cipher->blocksize != 16 && cipher->blocksize != 8) {
+        return -1;
+    }
+
+    cipher->encrypt(l, l, rks);
+
+    key->cipher = cipher;
+    key->rks = rks;
+    cmac_double(key->k1, l, cipher->blocksize);
+    cmac_double(key->k2, key->k1, cipher->blocksize);
+
+    return 0;
+}
+
+void cmac_init(cmac_context* ctx, const cmac_key* key)
+{
+    ctx->key = key;
+    ctx->bidx = 0;
+    memset(ctx->block, 0, sizeof(ctx->block));
+    memset(ctx->mac, 0, sizeof(ctx->mac));
+}
+
+// mac = E(mac ^ data) over nblocks whole blocks
+static void cmac_blocks(uint8_t* mac, const uint8_t* data, size_t nblocks, const cmac_key* key)
+{
+    size_t blocksize = key->cipher->blocksize;
+
+    for (size_t i = 0; i < nblocks; ++i) {
+        xor(mac, mac, data, blocksize);
+        key->cipher->encrypt(mac, mac, key->rks);
+        data += blocksize;
+    }
+}
+
+// the last block, complete or not, is masked by K1 or padded and masked by K2
+static void cmac_last(uint8_t* tag, uint8_t* mac, const uint8_t* last, size_t remains, const cmac_key* key)
+{
+    size_t blocksize = key->cipher->blocksize;
+    uint8_t block[16] = {0};
+
+    memcpy(block, last, remains);
+
+    if (remains == blocksize) {
+        xor(block, block, key->k1, blocksize);
+    } else {
+        block[remains] = 0x80;
+        xor(block, block, key->k2, blocksize);
+    }
+
+    xor(mac, mac, block, blocksize);
+    key->cipher->encrypt(tag, mac, key->rks);
+}
+
+void cmac_update(cmac_context* ctx, const uint8_t* data, size_t length)
+{
+    size_t blocksize = ctx->key->cipher->blocksize;
+
+    if (length == 0) {
+        return;
+    }
+
+    // the buffered block is only processed once more data shows it is not the last one
+    if (ctx->bidx > 0) {
+        size_t gap = blocksize - ctx->bidx;
+
+        if (length <= gap) {
+            memcpy(ctx->block + ctx->bidx, data, length);
+            ctx->bidx += length;
+            return;
+        }
+
+        memcpy(ctx->block + ctx->bidx, data, gap);
+        cmac_blocks(ctx->mac, ctx->block, 1, ctx->key);
+        ctx->bidx = 0;
+        data += gap;
+        length -= gap;
+    }
+
+    size_t nblocks = (length - 1) / blocksize;
+    cmac_blocks(ctx->mac, data, nblocks, ctx->key);
+    data += nblocks * blocksize;
+    length -= nblocks * blocksize;
+
+    memcpy(ctx->block, data, length);
+    ctx->bidx = length;
+}
+
+void cmac_final(cmac_context* ctx, uint8_t* tag)
+{
+    cmac_last(tag, ctx->mac, ctx->block, ctx->bidx, ctx->key);
+    cmac_init(ctx, ctx->key);
+}
+
+void cmac(uint8_t* tag, const uint8_t* data, size_t length, const cmac_key* key)
+{
+    size_t blocksize = key->cipher->blocksize;
+    size_t nblocks = (length > 0) ? (length - 1) / blocksize : 0;
+    uint8_t mac[16] = {0};
+
+    cmac_blocks(mac, data, nblocks, key);
+    cmac_last(tag, mac, data + nblocks * blocksize, length - nblocks * blocksize, key);
+}
@@ -0,0 +1,63 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "cipher.h"
+
+/**
+ * CMAC key, NIST SP 800-38B. cmac_init_key derives the subkeys K1 and K2 once and the key
+ * is shared by any number of contexts. 8 and 16-byte block ciphers are supported, for other
+ * block sizes cmac_init_key returns -1. The rks must outlive the key.
+ */
+typedef struct st_cmac_key {
+    const block_cipher* cipher;
+    const uint8_t* rks;
+    uint8_t k1[16];
+    uint8_t k2[16];
+} cmac_key;
+
+typedef struct st_cmac_context {
+    const cmac_key* key;
+    size_t bidx;
+    uint8_t block[16];
+    uint8_t mac[16];
+} cmac_context;
+
+int cmac_init_key(cmac_key* key, const uint8_t* rks, const block_cipher* cipher);
+
+/**
+ * Incremental CMAC. Whole blocks are chained straight from the input, only a partial block
+ * and the last block are kept in the context. cmac_final writes blocksize bytes of tag and
+ * resets the context for the next message under the same key.
+ */
+void cmac_init(cmac_context* ctx, const cmac_key* key);
+void cmac_update(cmac_context* ctx, const uint8_t* data, size_t length);
+void cmac_final(cmac_context* ctx, uint8_t* tag);
+
+// one-shot CMAC, nothing but the last block is copied
+void cmac(uint8_t* tag, const uint8_t* data, size_t length, const cmac_key* key);
@@ -26,15 +26,13 @@
  */
 
 #include "ctr.h"
-#include <stdlib.h>
-#include <string.h>
+#include "util.inc"
 
-static void xor(uint8_t* lhs, const uint8_t* rhs, size_t length)
-{
-    for (size_t i = 0; i < length; ++i) {
-        lhs[i] ^= rhs[i];
-    }
-}
+// number of counter blocks encrypted at once, rounded down to a multiple of the cipher batch
+#define CTR_BATCH_BLOCKS 32
+
+// largest supported block size
+#define CTR_MAX_BLOCKSIZE 16
 
 static void increase_counter(uint8_t* ctr, size_t length)
 {
@@ -44,30 +42,197 @@ static void increase_counter(uint8_t* ctr, size_t length)
     }
 }
 
-void ctr_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* iv, size_t blocksize, size_t length, void(*encrypt)(uint8_t*, const uint8_t*, const uint8_t*))
+/**
+ * writes nblocks consecutive counter blocks starting from ctr, and advances ctr by nblocks.
+ * 64 and 128-bit counters are handled as big-endian integers instead of byte by byte.
+ */
+static void build_counters(uint8_t* out, uint8_t* ctr, size_t blocksize, size_t nblocks)
+{
+    if (blocksize == 16) {
+        uint64_t hi = load64_be(ctr);
+        uint64_t lo = load64_be(ctr + 8);
+
+        for (size_t i = 0; i < nblocks; ++i) {
+            store64_be(out, hi);
+            store64_be(out + 8, lo);
+            out += 16;
+
+            hi += (++lo == 0);
+        }
+
+        store64_be(ctr, hi);
+        store64_be(ctr + 8, lo);
+
+    } else if (blocksize == 8) {
+        uint64_t value = load64_be(ctr);
+
+        for (size_t i = 0; i < nblocks; ++i) {
+            store64_be(out, value++);
+            out += 8;
+        }
+
+        store64_be(ctr, value);
+
+    } else {
+        for (size_t i = 0; i < nblocks; ++i) {
+            memcpy(out, ctr, blocksize);
+            increase_counter(ctr, blocksize);
+            out += blocksize;
+        }
+    }
+}
+
+// adds offset to the big-endian counter
+static void add_counter(uint8_t* ctr, size_t blocksize, uint64_t offset)
+{
+    if (blocksize == 16) {
+        uint64_t hi = load64_be(ctr);
+        uint64_t lo = load64_be(ctr + 8);
+
+        lo += offset;
+        hi += (lo < offset);
+
+        store64_be(ctr, hi);
+        store64_be(ctr + 8, lo);
+
+    } else if (blocksize == 8) {
+        store64_be(ctr, load64_be(ctr) + offset);
+
+    } else {
+        unsigned int carry = 0;
+
+        for (size_t i = blocksize; i-- > 0; ) {
+            carry += ctr[i] + (offset & 0xff);
+            ctr[i] = (uint8_t) carry;
+            carry >>= 8;
+            offset >>= 8;
+        }
+    }
+}
+
+static void ctr_process(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, uint8_t* ctr, size_t length, const block_cipher* cipher)
+{
+    uint8_t ks[CTR_BATCH_BLOCKS * CTR_MAX_BLOCKSIZE];
+    size_t blocksize = cipher->blocksize;
+    size_t batch = cipher_batch_blocks(cipher, CTR_BATCH_BLOCKS);
+
+    // the whole blocks in one call to the fused kernel, the partial last block below
+    if (cipher->ctr_blocks != NULL) {
+        size_t nblocks = length / blocksize;
+
+        cipher->ctr_blocks(ct, pt, nblocks, ctr, rks);
+
+        pt += nblocks * blocksize;
+        ct += nblocks * blocksize;
+        length -= nblocks * blocksize;
+    }
+
+    while (length > 0) {
+        size_t nblocks = (length + blocksize - 1) / blocksize;
+        if (nblocks > batch) {
+            nblocks = batch;
+        }
+
+        size_t chunk = nblocks * blocksize;
+        if (chunk > length) {
+            chunk = length;
+        }
+
+        build_counters(ks, ctr, blocksize, nblocks);
+        cipher_encrypt_blocks(cipher, ks, ks, nblocks, rks);
+        xor(ct, pt, ks, chunk);
+
+        pt += chunk;
+        ct += chunk;
+        length -= chunk;
+    }
+}
+
+void ctr_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* iv, size_t length, const block_cipher* cipher)
+{
+    uint8_t ctr[CTR_MAX_BLOCKSIZE];
+
+    memcpy(ctr, iv, cipher->blocksize);
+    ctr_process(ct, pt, rks, ctr, length, cipher);
+}
+
+void ctr_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, const uint8_t* iv, size_t length, const block_cipher* cipher)
+{
+    ctr_encrypt(pt, ct, rks, iv, length, cipher);
+}
+
+void ctr_crypt_at(uint8_t* out, const uint8_t* in, const uint8_t* rks, const uint8_t* iv, uint64_t offset, size_t length, const block_cipher* cipher)
 {
-    uint8_t* ctr = calloc(blocksize, sizeof(uint8_t));
+    uint8_t ctr[CTR_MAX_BLOCKSIZE];
+    uint8_t ks[CTR_MAX_BLOCKSIZE];
+    size_t blocksize = cipher->blocksize;
+    size_t skip = offset % blocksize;
+
     memcpy(ctr, iv, blocksize);
+    add_counter(ctr, blocksize, offset / blocksize);
+
+    // partial first block, only its tail is used
+    if (skip > 0 && length > 0) {
+        size_t chunk = blocksize - skip;
+        if (chunk > length) {
+            chunk = length;
+        }
 
-    while (length >= blocksize) {
-        encrypt(ct, ctr, rks);
-        xor(ct, pt, blocksize);
-        increase_counter(ctr, blocksize);
+        cipher->encrypt(ks, ctr, rks);
+        xor(out, in, ks + skip, chunk);
+        add_counter(ctr, blocksize, 1);
 
-        pt += blocksize;
-        ct += blocksize;
-        length -= blocksize;
+        in += chunk;
+        out += chunk;
+        length -= chunk;
     }
 
-    if (length > 0) {
-        encrypt(ct, ctr, rks);
-        xor(ct, pt, length);
+    ctr_process(out, in, rks, ctr, length, cipher);
+}
+
+void ctr_init(ctr_context* ctx, const uint8_t* rks, const uint8_t* iv, const block_cipher* cipher)
+{
+    ctx->cipher = cipher;
+    ctx->rks = rks;
+    ctx->bidx = 0;
+    memset(ctx->ctr, 0, sizeof(ctx->ctr));
+    memset(ctx->block, 0, sizeof(ctx->block));
+    memcpy(ctx->ctr, iv, cipher->blocksize);
+}
+
+void ctr_update(ctr_context* ctx, uint8_t* out, const uint8_t* in, size_t length)
+{
+    size_t blocksize = ctx->cipher->blocksize;
+
+    // the rest of the keystream block of the previous update
+    if (ctx->bidx > 0) {
+        size_t chunk = blocksize - ctx->bidx;
+        if (chunk > length) {
+            chunk = length;
+        }
+
+        xor(out, in, ctx->block + ctx->bidx, chunk);
+        ctx->bidx = (ctx->bidx + chunk) % blocksize;
+
+        in += chunk;
+        out += chunk;
+        length -= chunk;
     }
 
-    free(ctr);
+    size_t whole = length - (length % blocksize);
+    ctr_process(out, in, ctx->rks, ctx->ctr, whole, ctx->cipher);
+
+    // a partial block keeps its keystream block for the next update
+    if (whole < length) {
+        build_counters(ctx->block, ctx->ctr, blocksize, 1);
+        ctx->cipher->encrypt(ctx->block, ctx->block, ctx->rks);
+
+        xor(out + whole, in + whole, ctx->block, length - whole);
+        ctx->bidx = length - whole;
+    }
 }
 
-void ctr_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, const uint8_t* iv, size_t blocksize, size_t length, void(*encrypt)(uint8_t*, const uint8_t*, const uint8_t*))
+void ctr_final(ctr_context* ctx)
 {
-    ctr_encrypt(pt, ct, rks, iv, blocksize, length, encrypt);
-}
\ No newline at end of file
+    memset(ctx, 0, sizeof(ctr_context));
+}
@@ -27,8 +27,36 @@
 
 #pragma once
 
-#include <stdint.h>
-#include <stddef.h>
+#include "cipher.h"
 
-void ctr_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* iv, size_t blocksize, size_t length, void(*encrypt)(uint8_t*, const uint8_t*, const uint8_t*));
-void ctr_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, const uint8_t* iv, size_t blocksize, size_t length, void(*decrypt)(uint8_t*, const uint8_t*, const uint8_t*));
\ No newline at end of file
+/**
+ * CTR mode, the counter is the whole block in big-endian.
+ * Counter blocks are built and encrypted in batches through the cipher's multi-block path.
+ * The block size is at most 16 bytes.
+ */
+void ctr_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* iv, size_t length, const block_cipher* cipher);
+void ctr_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, const uint8_t* iv, size_t length, const block_cipher* cipher);
+
+/**
+ * Encrypts or decrypts length bytes of the CTR stream starting at byte offset, without walking from the iv.
+ * The counter for the first block is iv + offset / blocksize, and a partial first block is
+ * handled when offset is not a multiple of blocksize. For a block offset n, pass n * blocksize.
+ */
+void ctr_crypt_at(uint8_t* out, const uint8_t* in, const uint8_t* rks, const uint8_t* iv, uint64_t offset, size_t length, const block_cipher* cipher);
+
+/**
+ * Streaming CTR, encryption and decryption alike. The counter and the unused keystream of
+ * the last block are carried across updates, so updates of any length produce the same
+ * stream as a single ctr_encrypt. out may alias in. ctr_final clears the context.
+ */
+typedef struct st_ctr_context {
+    const block_cipher* cipher;
+    const uint8_t* rks;
+    size_t bidx;
+    uint8_t ctr[16];
+    uint8_t block[16];
+} ctr_context;
+
+void ctr_init(ctr_context* ctx, const uint8_t* rks, const uint8_t* iv, const block_cipher* cipher);
+void ctr_update(ctr_context* ctx, uint8_t* out, const uint8_t* in, size_t length);
+void ctr_final(ctr_context* ctx);
@@ -25,26 +25,87 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "ecb.h"
 
-void ecb_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, size_t blocksize, size_t length, void(*encrypt)(uint8_t*, const uint8_t*, const uint8_t*))
+void ecb_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, size_t length, const block_cipher* cipher)
+{
+    cipher_encrypt_blocks(cipher, ct, pt, length / cipher->blocksize, rks);
+}
+
+void ecb_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, size_t length, const block_cipher* cipher)
 {
-    while (length >= blocksize) {
-        encrypt(ct, pt, rks);
-        
-        pt += blocksize;
-        ct += blocksize;
-        length -= blocksize;
+    cipher_decrypt_blocks(cipher, pt, ct, length / cipher->blocksize, rks);
+}
+
+static void ecb_init(ecb_context* ctx, const uint8_t* rks, int decrypt, const block_cipher* cipher)
+{
+    ctx->cipher = cipher;
+    ctx->rks = rks;
+    ctx->decrypt = decrypt;
+    ctx->bidx = 0;
+    memset(ctx->block, 0, sizeof(ctx->block));
+}
+
+void ecb_encrypt_init(ecb_context* ctx, const uint8_t* rks, const block_cipher* cipher)
+{
+    ecb_init(ctx, rks, 0, cipher);
+}
+
+void ecb_decrypt_init(ecb_context* ctx, const uint8_t* drks, const block_cipher* cipher)
+{
+    ecb_init(ctx, drks, 1, cipher);
+}
+
+static void ecb_process(ecb_context* ctx, uint8_t* out, const uint8_t* in, size_t length)
+{
+    if (ctx->decrypt) {
+        ecb_decrypt(out, in, ctx->rks, length, ctx->cipher);
+    } else {
+        ecb_encrypt(out, in, ctx->rks, length, ctx->cipher);
     }
 }
 
-void ecb_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, size_t blocksize, size_t length, void(*decrypt)(uint8_t*, const uint8_t*, const uint8_t*))
+size_t ecb_update(ecb_context* ctx, uint8_t* out, const uint8_t* in, size_t length)
 {
-    while (length >= blocksize) {
-        decrypt(pt, ct, rks);
-        
-        ct += blocksize;
-        pt += blocksize;
-        length -= blocksize;
+    size_t blocksize = ctx->cipher->blocksize;
+    size_t written = 0;
+
+    if (ctx->bidx > 0) {
+        size_t gap = blocksize - ctx->bidx;
+
+        if (length < gap) {
+            memcpy(ctx->block + ctx->bidx, in, length);
+            ctx->bidx += length;
+            return 0;
+        }
+
+        memcpy(ctx->block + ctx->bidx, in, gap);
+        ecb_process(ctx, out, ctx->block, blocksize);
+        ctx->bidx = 0;
+
+        in += gap;
+        out += blocksize;
+        length -= gap;
+        written += blocksize;
     }
-}
\ No newline at end of file
+
+    size_t whole = length - (length % blocksize);
+    ecb_process(ctx, out, in, whole);
+    written += whole;
+
+    memcpy(ctx->block, in + whole, length - whole);
+    ctx->bidx = length - whole;
+
+    return written;
+}
+
+size_t ecb_final(ecb_context* ctx)
+{
+    size_t remains = ctx->bidx;
+
+    ecb_init(ctx, ctx->rks, ctx->decrypt, ctx->cipher);
+
+    return remains;
+}
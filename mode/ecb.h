@@ -27,8 +27,26 @@
 
 #pragma once
 
-#include <stdint.h>
-#include <stddef.h>
+#include "cipher.h"
 
-void ecb_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, size_t blocksize, size_t length, void(*encrypt)(uint8_t*, const uint8_t*, const uint8_t*));
-void ecb_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, size_t blocksize, size_t length, void(*decrypt)(uint8_t*, const uint8_t*, const uint8_t*));
\ No newline at end of file
+void ecb_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, size_t length, const block_cipher* cipher);
+void ecb_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, size_t length, const block_cipher* cipher);
+
+/**
+ * Streaming ECB. An update of any length writes every block it completes to out and returns
+ * the number of bytes written, a partial block is kept in the context until the next update.
+ * out may alias in when no partial block is pending. ecb_final returns the number of trailing
+ * bytes that never formed a block, which are dropped like in ecb_encrypt, and clears the context.
+ */
+typedef struct st_ecb_context {
+    const block_cipher* cipher;
+    const uint8_t* rks;
+    int decrypt;
+    size_t bidx;
+    uint8_t block[16];
+} ecb_context;
+
+void ecb_encrypt_init(ecb_context* ctx, const uint8_t* rks, const block_cipher* cipher);
+void ecb_decrypt_init(ecb_context* ctx, const uint8_t* drks, const block_cipher* cipher);
+size_t ecb_update(ecb_context* ctx, uint8_t* out, const uint8_t* in, size_t length);
+size_t ecb_final(ecb_context* ctx);
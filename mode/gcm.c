@@ -0,0 +1,267 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "gcm.h"
+#include "util.inc"
+
+// number of blocks encrypted and hashed at once, rounded down to a multiple of the cipher batch
+#define GCM_BATCH_BLOCKS 32
+
+int gcm_init(gcm_key* key, const uint8_t* rks, const block_cipher* cipher)
+{
+    uint8_t h[16] = {0};
+
+    if (cipher->blocksize != 16) {
+        return -1;
+    }
+
+    cipher->encrypt(h, h, rks);
+
+    key->cipher = cipher;
+    key->rks = rks;
+    ghash_init(&key->ghash, h);
+
+    return 0;
+}
+
+/**
+ * a non-empty iv, at most 2^32 - 2 blocks of data so that the 32-bit counter never returns
+ * to J0, and the tag lengths of SP 800-38D, 4 and 8 bytes or 12 to 16 bytes.
+ */
+static int gcm_check(size_t length, size_t taglen, size_t ivlen)
+{
+    if (ivlen == 0) {
+        return -1;
+    }
+
+    if ((uint64_t) length > ((uint64_t) 1 << 36) - 32) {
+        return -1;
+    }
+
+    if (taglen != 4 && taglen != 8 && (taglen < 12 || taglen > 16)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+// pre-counter block, iv || 0^31 || 1 for 96-bit ivs and GHASH(iv || length) otherwise
+static void gcm_j0(uint8_t* j0, const uint8_t* iv, size_t ivlen, const gcm_key* key)
+{
+    uint8_t block[16] = {0};
+
+    if (ivlen == 12) {
+        memcpy(j0, iv, 12);
+        store32_be(j0 + 12, 1);
+        return;
+    }
+
+    memset(j0, 0, 16);
+    ghash_update(j0, iv, ivlen, &key->ghash);
+
+    store64_be(block + 8, (uint64_t) ivlen * 8);
+    ghash_blocks(j0, block, 1, &key->ghash);
+}
+
+// writes nblocks counter blocks, only the last 32 bits of the counter are incremented
+static void build_counters(uint8_t* out, uint8_t* ctr, size_t nblocks)
+{
+    uint32_t value = load32_be(ctr + 12);
+
+    for (size_t i = 0; i < nblocks; ++i) {
+        memcpy(out, ctr, 12);
+        store32_be(out + 12, value++);
+        out += 16;
+    }
+
+    store32_be(ctr + 12, value);
+}
+
+/**
+ * CTR with GHASH stitched in: each batch of keystream is generated, then the batch of
+ * ciphertext is xored and hashed before moving on, so the data is touched once.
+ */
+static void gcm_process(uint8_t* out, const uint8_t* in, size_t length, uint8_t* ctr, uint8_t* y, int decrypt, const gcm_key* key)
+{
+    uint8_t ks[GCM_BATCH_BLOCKS * 16];
+    size_t batch = cipher_batch_blocks(key->cipher, GCM_BATCH_BLOCKS);
+
+    while (length > 0) {
+        size_t nblocks = (length + 15) / 16;
+        if (nblocks > batch) {
+            nblocks = batch;
+        }
+
+        size_t chunk = nblocks * 16;
+        if (chunk > length) {
+            chunk = length;
+        }
+
+        build_counters(ks, ctr, nblocks);
+        cipher_encrypt_blocks(key->cipher, ks, ks, nblocks, key->rks);
+
+        if (decrypt) {
+            ghash_update(y, in, chunk, &key->ghash);
+            xor(out, in, ks, chunk);
+        } else {
+            xor(out, in, ks, chunk);
+            ghash_update(y, out, chunk, &key->ghash);
+        }
+
+        in += chunk;
+        out += chunk;
+        length -= chunk;
+    }
+}
+
+static void gcm_crypt(uint8_t* out, uint8_t* tag, const uint8_t* in, size_t length, const uint8_t* aad, size_t aadlen, const uint8_t* iv, size_t ivlen, int decrypt, const gcm_key* key)
+{
+    uint8_t j0[16];
+    uint8_t ctr[16];
+    uint8_t y[16] = {0};
+    uint8_t block[16];
+
+    gcm_j0(j0, iv, ivlen, key);
+    ghash_update(y, aad, aadlen, &key->ghash);
+
+    memcpy(ctr, j0, 16);
+    store32_be(ctr + 12, load32_be(j0 + 12) + 1);
+    gcm_process(out, in, length, ctr, y, decrypt, key);
+
+    store64_be(block, (uint64_t) aadlen * 8);
+    store64_be(block + 8, (uint64_t) length * 8);
+    ghash_blocks(y, block, 1, &key->ghash);
+
+    key->cipher->encrypt(block, j0, key->rks);
+    xor(tag, y, block, 16);
+}
+
+int gcm_encrypt(uint8_t* ct, uint8_t* tag, size_t taglen, const uint8_t* pt, size_t length, const uint8_t* aad, size_t aadlen, const uint8_t* iv, size_t ivlen, const gcm_key* key)
+{
+    uint8_t full[16];
+
+    if (gcm_check(length, taglen, ivlen) != 0) {
+        return -1;
+    }
+
+    gcm_crypt(ct, full, pt, length, aad, aadlen, iv, ivlen, 0, key);
+    memcpy(tag, full, taglen);
+
+    return 0;
+}
+
+int gcm_decrypt(uint8_t* pt, const uint8_t* ct, size_t length, const uint8_t* tag, size_t taglen, const uint8_t* aad, size_t aadlen, const uint8_t* iv, size_t ivlen, const gcm_key* key)
+{
+    uint8_t full[16];
+    uint8_t diff = 0;
+
+    if (gcm_check(length, taglen, ivlen) != 0) {
+        return -1;
+    }
+
+    gcm_crypt(pt, full, ct, length, aad, aadlen, iv, ivlen, 1, key);
+
+    for (size_t i = 0; i < taglen; ++i) {
+        diff |= full[i] ^ tag[i];
+    }
+
+    if (diff != 0) {
+        memset(pt, 0, length);
+        return -1;
+    }
+
+    return 0;
+}
+
+int gmac_init(gmac_context* ctx, const gcm_key* key, const uint8_t* iv, size_t ivlen)
+{
+    if (ivlen == 0) {
+        return -1;
+    }
+
+    ctx->key = key;
+    ctx->bidx = 0;
+    ctx->length = 0;
+    memset(ctx->y, 0, 16);
+    memset(ctx->block, 0, 16);
+
+    gcm_j0(ctx->j0, iv, ivlen, key);
+
+    return 0;
+}
+
+void gmac_update(gmac_context* ctx, const uint8_t* data, size_t length)
+{
+    ctx->length += length;
+
+    if (ctx->bidx > 0) {
+        size_t gap = 16 - ctx->bidx;
+
+        if (length < gap) {
+            memcpy(ctx->block + ctx->bidx, data, length);
+            ctx->bidx += length;
+            return;
+        }
+
+        memcpy(ctx->block + ctx->bidx, data, gap);
+        ghash_blocks(ctx->y, ctx->block, 1, &ctx->key->ghash);
+        ctx->bidx = 0;
+        data += gap;
+        length -= gap;
+    }
+
+    ghash_blocks(ctx->y, data, length / 16, &ctx->key->ghash);
+    data += length - (length % 16);
+    length %= 16;
+
+    memcpy(ctx->block, data, length);
+    ctx->bidx = length;
+}
+
+void gmac_final(gmac_context* ctx, uint8_t* tag)
+{
+    uint8_t block[16] = {0};
+
+    ghash_update(ctx->y, ctx->block, ctx->bidx, &ctx->key->ghash);
+
+    store64_be(block, ctx->length * 8);
+    ghash_blocks(ctx->y, block, 1, &ctx->key->ghash);
+
+    ctx->key->cipher->encrypt(block, ctx->j0, ctx->key->rks);
+    xor(tag, ctx->y, block, 16);
+}
+
+int gmac(uint8_t* tag, const uint8_t* data, size_t length, const uint8_t* iv, size_t ivlen, const gcm_key* key)
+{
+    if (ivlen == 0) {
+        return -1;
+    }
+
+    gcm_crypt(NULL, tag, NULL, 0, data, length, iv, ivlen, 0, key);
+
+    return 0;
+}
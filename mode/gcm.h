@@ -0,0 +1,75 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "cipher.h"
+#include "ghash.h"
+
+/**
+ * GCM key, the cipher with its round keys and the GHASH key derived from them.
+ * gcm_init computes H = E(0) and its powers once, the key is reused for every message.
+ * It returns -1 when the block size of the cipher is not 16 bytes.
+ */
+typedef struct st_gcm_key {
+    const block_cipher* cipher;
+    const uint8_t* rks;
+    ghash_key ghash;
+} gcm_key;
+
+int gcm_init(gcm_key* key, const uint8_t* rks, const block_cipher* cipher);
+
+/**
+ * GCM authenticated encryption, NIST SP 800-38D.
+ * The data is read once: every batch of keystream is xored and the ciphertext is hashed
+ * while it is still in cache. Both work in place and return -1 for an empty iv, for more than
+ * 2^36 - 32 bytes of data and for a tag length other than 4, 8 or 12 to 16 bytes.
+ * gcm_decrypt also returns -1 when the tag does not match, in which case pt is zeroed.
+ */
+int gcm_encrypt(uint8_t* ct, uint8_t* tag, size_t taglen, const uint8_t* pt, size_t length, const uint8_t* aad, size_t aadlen, const uint8_t* iv, size_t ivlen, const gcm_key* key);
+int gcm_decrypt(uint8_t* pt, const uint8_t* ct, size_t length, const uint8_t* tag, size_t taglen, const uint8_t* aad, size_t aadlen, const uint8_t* iv, size_t ivlen, const gcm_key* key);
+
+/**
+ * GMAC, GCM over associated data only, under the H powers cached in a gcm_key.
+ * Whole blocks go straight from the input to GHASH, a partial block is kept in the context.
+ * gmac_final writes a 16-byte tag, and the one-shot gmac hashes the input in place.
+ * gmac_init and gmac return -1 for an empty iv.
+ */
+typedef struct st_gmac_context {
+    const gcm_key* key;
+    size_t bidx;
+    uint64_t length;
+    uint8_t j0[16];
+    uint8_t y[16];
+    uint8_t block[16];
+} gmac_context;
+
+int gmac_init(gmac_context* ctx, const gcm_key* key, const uint8_t* iv, size_t ivlen);
+void gmac_update(gmac_context* ctx, const uint8_t* data, size_t length);
+void gmac_final(gmac_context* ctx, uint8_t* tag);
+
+int gmac(uint8_t* tag, const uint8_t* data, size_t length, const uint8_t* iv, size_t ivlen, const gcm_key* key);
@@ -0,0 +1,217 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ghash.h"
+#include "util.inc"
+
+#if defined(__PCLMUL__)
+
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+
+static inline __m128i load_reversed(const uint8_t* in)
+{
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) in), reverse);
+}
+
+static inline void store_reversed(uint8_t* out, __m128i value)
+{
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    _mm_storeu_si128((__m128i*) out, _mm_shuffle_epi8(value, reverse));
+}
+
+// accumulates the unreduced 256-bit product a * b into lo, mid and hi
+static inline void clmul_acc(__m128i a, __m128i b, __m128i* lo, __m128i* mid, __m128i* hi)
+{
+    *lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+    *hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+    *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x01));
+    *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x10));
+}
+
+// shifts the bit-reflected product left by one and reduces it modulo x^128 + x^7 + x^2 + x + 1
+static inline __m128i reduce(__m128i lo, __m128i mid, __m128i hi)
+{
+    __m128i t0, t1, t2;
+
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    t0 = _mm_srli_epi32(lo, 31);
+    t1 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+
+    t2 = _mm_srli_si128(t0, 12);
+    t1 = _mm_slli_si128(t1, 4);
+    t0 = _mm_slli_si128(t0, 4);
+    lo = _mm_or_si128(lo, t0);
+    hi = _mm_or_si128(hi, t1);
+    hi = _mm_or_si128(hi, t2);
+
+    t0 = _mm_slli_epi32(lo, 31);
+    t1 = _mm_slli_epi32(lo, 30);
+    t2 = _mm_slli_epi32(lo, 25);
+    t0 = _mm_xor_si128(t0, _mm_xor_si128(t1, t2));
+    t1 = _mm_srli_si128(t0, 4);
+    t0 = _mm_slli_si128(t0, 12);
+    lo = _mm_xor_si128(lo, t0);
+
+    t2 = _mm_srli_epi32(lo, 1);
+    t0 = _mm_srli_epi32(lo, 2);
+    t2 = _mm_xor_si128(t2, t0);
+    t0 = _mm_srli_epi32(lo, 7);
+    t2 = _mm_xor_si128(t2, t0);
+    t2 = _mm_xor_si128(t2, t1);
+    lo = _mm_xor_si128(lo, t2);
+
+    return _mm_xor_si128(hi, lo);
+}
+
+static inline __m128i gf_mul(__m128i a, __m128i b)
+{
+    __m128i lo = _mm_setzero_si128();
+    __m128i mid = _mm_setzero_si128();
+    __m128i hi = _mm_setzero_si128();
+
+    clmul_acc(a, b, &lo, &mid, &hi);
+
+    return reduce(lo, mid, hi);
+}
+
+void ghash_init(ghash_key* key, const uint8_t* h)
+{
+    __m128i h1 = load_reversed(h);
+    __m128i hn = h1;
+
+    _mm_storeu_si128((__m128i*) key->h[0], h1);
+    for (size_t i = 1; i < GHASH_POWERS; ++i) {
+        hn = gf_mul(hn, h1);
+        _mm_storeu_si128((__m128i*) key->h[i], hn);
+    }
+}
+
+void ghash_blocks(uint8_t* y, const uint8_t* data, size_t nblocks, const ghash_key* key)
+{
+    __m128i acc = load_reversed(y);
+
+    // 8 blocks with one reduction: (y ^ x_1) * H^8 ^ x_2 * H^7 ^ ... ^ x_8 * H
+    for (; nblocks >= GHASH_POWERS; nblocks -= GHASH_POWERS) {
+        __m128i lo = _mm_setzero_si128();
+        __m128i mid = _mm_setzero_si128();
+        __m128i hi = _mm_setzero_si128();
+
+        acc = _mm_xor_si128(acc, load_reversed(data));
+        clmul_acc(acc, _mm_loadu_si128((const __m128i*) key->h[7]), &lo, &mid, &hi);
+        clmul_acc(load_reversed(data +  16), _mm_loadu_si128((const __m128i*) key->h[6]), &lo, &mid, &hi);
+        clmul_acc(load_reversed(data +  32), _mm_loadu_si128((const __m128i*) key->h[5]), &lo, &mid, &hi);
+        clmul_acc(load_reversed(data +  48), _mm_loadu_si128((const __m128i*) key->h[4]), &lo, &mid, &hi);
+        clmul_acc(load_reversed(data +  64), _mm_loadu_si128((const __m128i*) key->h[3]), &lo, &mid, &hi);
+        clmul_acc(load_reversed(data +  80), _mm_loadu_si128((const __m128i*) key->h[2]), &lo, &mid, &hi);
+        clmul_acc(load_reversed(data +  96), _mm_loadu_si128((const __m128i*) key->h[1]), &lo, &mid, &hi);
+        clmul_acc(load_reversed(data + 112), _mm_loadu_si128((const __m128i*) key->h[0]), &lo, &mid, &hi);
+        acc = reduce(lo, mid, hi);
+
+        data += 16 * GHASH_POWERS;
+    }
+
+    // remaining blocks are aggregated the same way with the lower powers
+    if (nblocks > 0) {
+        __m128i lo = _mm_setzero_si128();
+        __m128i mid = _mm_setzero_si128();
+        __m128i hi = _mm_setzero_si128();
+
+        acc = _mm_xor_si128(acc, load_reversed(data));
+        clmul_acc(acc, _mm_loadu_si128((const __m128i*) key->h[nblocks - 1]), &lo, &mid, &hi);
+        for (size_t i = 1; i < nblocks; ++i) {
+            clmul_acc(load_reversed(data + 16 * i), _mm_loadu_si128((const __m128i*) key->h[nblocks - 1 - i]), &lo, &mid, &hi);
+        }
+        acc = reduce(lo, mid, hi);
+    }
+
+    store_reversed(y, acc);
+}
+
+#else
+
+/**
+ * portable bit by bit multiplication, y = y * h in GF(2^128).
+ * The conditional additions are masked so that the timing does not depend on the data.
+ */
+static void gf_mul(uint8_t* y, const uint8_t* h)
+{
+    uint64_t xh = load64_be(y), xl = load64_be(y + 8);
+    uint64_t vh = load64_be(h), vl = load64_be(h + 8);
+    uint64_t zh = 0, zl = 0;
+
+    for (int i = 0; i < 128; ++i) {
+        uint64_t bit = (i < 64) ? (xh >> (63 - i)) : (xl >> (127 - i));
+        uint64_t mask = 0 - (bit & 1);
+
+        zh ^= vh & mask;
+        zl ^= vl & mask;
+
+        mask = 0 - (vl & 1);
+        vl = (vl >> 1) | (vh << 63);
+        vh = (vh >> 1) ^ (0xe100000000000000ULL & mask);
+    }
+
+    store64_be(y, zh);
+    store64_be(y + 8, zl);
+}
+
+void ghash_init(ghash_key* key, const uint8_t* h)
+{
+    memset(key, 0, sizeof(ghash_key));
+    memcpy(key->h[0], h, 16);
+}
+
+void ghash_blocks(uint8_t* y, const uint8_t* data, size_t nblocks, const ghash_key* key)
+{
+    for (size_t i = 0; i < nblocks; ++i) {
+        xor(y, y, data, 16);
+        gf_mul(y, key->h[0]);
+        data += 16;
+    }
+}
+
+#endif
+
+void ghash_update(uint8_t* y, const uint8_t* data, size_t length, const ghash_key* key)
+{
+    uint8_t block[16] = {0};
+    size_t nblocks = length / 16;
+    size_t remains = length % 16;
+
+    ghash_blocks(y, data, nblocks, key);
+
+    if (remains > 0) {
+        memcpy(block, data + 16 * nblocks, remains);
+        ghash_blocks(y, block, 1, key);
+    }
+}
@@ -0,0 +1,53 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// number of precomputed powers of H, which is also the number of blocks reduced at once
+#define GHASH_POWERS 8
+
+/**
+ * GHASH key, H^1 .. H^GHASH_POWERS in the layout of the multiplier.
+ * With PCLMULQDQ the powers are kept byte-reversed, otherwise only H is used.
+ */
+typedef struct st_ghash_key {
+    uint8_t h[GHASH_POWERS][16];
+} ghash_key;
+
+void ghash_init(ghash_key* key, const uint8_t* h);
+
+/**
+ * y = ((y ^ x_1) * H ^ x_2) * H ... over nblocks whole blocks of data.
+ * Runs of GHASH_POWERS blocks are multiplied by H^8 .. H^1 and reduced once.
+ */
+void ghash_blocks(uint8_t* y, const uint8_t* data, size_t nblocks, const ghash_key* key);
+
+// GHASH over length bytes, a trailing partial block is padded with zeros
+void ghash_update(uint8_t* y, const uint8_t* data, size_t length, const ghash_key* key);
@@ -0,0 +1,265 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "iovec.h"
+#include "ecb.h"
+#include "ctr.h"
+#include "cbc.h"
+
+// blocks staged around a segment boundary, rounded down to a multiple of the cipher batch
+#define IOV_STAGE_BLOCKS 16
+
+// largest supported block size
+#define IOV_MAX_BLOCKSIZE 16
+
+// position in a segment list
+typedef struct st_iov_cursor {
+    const mode_iovec* iov;
+    size_t count;
+    size_t idx;
+    size_t offset;
+} iov_cursor;
+
+static void cursor_init(iov_cursor* cur, const mode_iovec* iov, size_t count)
+{
+    cur->iov = iov;
+    cur->count = count;
+    cur->idx = 0;
+    cur->offset = 0;
+}
+
+static size_t total_length(const mode_iovec* iov, size_t count)
+{
+    size_t length = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        length += iov[i].length;
+    }
+
+    return length;
+}
+
+// number of bytes both lists can cover
+static size_t common_length(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin)
+{
+    size_t length = total_length(in, nin);
+    size_t available = total_length(out, nout);
+
+    return (length < available) ? length : available;
+}
+
+// bytes left in the current segment, empty segments are skipped
+static size_t cursor_contiguous(iov_cursor* cur)
+{
+    while (cur->idx < cur->count && cur->offset == cur->iov[cur->idx].length) {
+        cur->idx += 1;
+        cur->offset = 0;
+    }
+
+    if (cur->idx == cur->count) {
+        return 0;
+    }
+
+    return cur->iov[cur->idx].length - cur->offset;
+}
+
+static uint8_t* cursor_pointer(const iov_cursor* cur)
+{
+    return (uint8_t*) cur->iov[cur->idx].base + cur->offset;
+}
+
+// moves n bytes ahead, n is at most cursor_contiguous
+static void cursor_advance(iov_cursor* cur, size_t n)
+{
+    cur->offset += n;
+}
+
+static void cursor_gather(iov_cursor* cur, uint8_t* dst, size_t n)
+{
+    while (n > 0) {
+        size_t chunk = cursor_contiguous(cur);
+        if (chunk > n) {
+            chunk = n;
+        }
+
+        memcpy(dst, cursor_pointer(cur), chunk);
+        cursor_advance(cur, chunk);
+        dst += chunk;
+        n -= chunk;
+    }
+}
+
+static void cursor_scatter(iov_cursor* cur, const uint8_t* src, size_t n)
+{
+    while (n > 0) {
+        size_t chunk = cursor_contiguous(cur);
+        if (chunk > n) {
+            chunk = n;
+        }
+
+        memcpy(cursor_pointer(cur), src, chunk);
+        cursor_advance(cur, chunk);
+        src += chunk;
+        n -= chunk;
+    }
+}
+
+typedef size_t (*block_update_func)(void* ctx, uint8_t* out, const uint8_t* in, size_t length);
+
+/**
+ * walks both lists over the first length bytes. Runs of whole blocks contiguous in both go to
+ * update directly. A block straddling a boundary is gathered together with the blocks after it,
+ * up to a batch of the cipher, so that the multi-block path never runs for a single block; the
+ * staged blocks are then scattered back. A trailing partial block, which only CTR passes, goes
+ * to update along with the blocks before it.
+ */
+static void process_blocks_iov(iov_cursor* dst, iov_cursor* src, size_t length, const block_cipher* cipher, block_update_func update, void* ctx)
+{
+    uint8_t stage[(IOV_STAGE_BLOCKS + 1) * IOV_MAX_BLOCKSIZE];
+    size_t blocksize = cipher->blocksize;
+    size_t staged = cipher_batch_blocks(cipher, IOV_STAGE_BLOCKS) * blocksize;
+
+    while (length > 0) {
+        size_t chunk = cursor_contiguous(src);
+        size_t available = cursor_contiguous(dst);
+
+        if (chunk > available) {
+            chunk = available;
+        }
+        if (chunk >= length) {
+            chunk = length;
+        } else {
+            chunk -= chunk % blocksize;
+        }
+
+        if (chunk > 0) {
+            update(ctx, cursor_pointer(dst), cursor_pointer(src), chunk);
+            cursor_advance(src, chunk);
+            cursor_advance(dst, chunk);
+        } else {
+            chunk = (length < staged + blocksize) ? length : staged;
+            cursor_gather(src, stage, chunk);
+            update(ctx, stage, stage, chunk);
+            cursor_scatter(dst, stage, chunk);
+        }
+
+        length -= chunk;
+    }
+}
+
+// both lists over their common whole blocks
+static void process_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const block_cipher* cipher, block_update_func update, void* ctx)
+{
+    iov_cursor src, dst;
+    size_t length = common_length(out, nout, in, nin);
+
+    cursor_init(&src, in, nin);
+    cursor_init(&dst, out, nout);
+    process_blocks_iov(&dst, &src, length - (length % cipher->blocksize), cipher, update, ctx);
+}
+
+static size_t ecb_update_func(void* ctx, uint8_t* out, const uint8_t* in, size_t length)
+{
+    return ecb_update((ecb_context*) ctx, out, in, length);
+}
+
+static size_t cbc_update_func(void* ctx, uint8_t* out, const uint8_t* in, size_t length)
+{
+    return cbc_update((cbc_context*) ctx, out, in, length);
+}
+
+// CTR by stream offset, so each update is one ctr_crypt_at call and a partial last block needs no keystream kept
+typedef struct st_ctr_iov_context {
+    const block_cipher* cipher;
+    const uint8_t* rks;
+    const uint8_t* iv;
+    uint64_t offset;
+} ctr_iov_context;
+
+static size_t ctr_update_func(void* ctx, uint8_t* out, const uint8_t* in, size_t length)
+{
+    ctr_iov_context* c = (ctr_iov_context*) ctx;
+
+    ctr_crypt_at(out, in, c->rks, c->iv, c->offset, length, c->cipher);
+    c->offset += length;
+
+    return length;
+}
+
+void ecb_encrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* rks, const block_cipher* cipher)
+{
+    ecb_context ctx;
+
+    ecb_encrypt_init(&ctx, rks, cipher);
+    process_iov(out, nout, in, nin, cipher, ecb_update_func, &ctx);
+    ecb_final(&ctx);
+}
+
+void ecb_decrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* drks, const block_cipher* cipher)
+{
+    ecb_context ctx;
+
+    ecb_decrypt_init(&ctx, drks, cipher);
+    process_iov(out, nout, in, nin, cipher, ecb_update_func, &ctx);
+    ecb_final(&ctx);
+}
+
+void cbc_encrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* rks, const uint8_t* iv, const block_cipher* cipher)
+{
+    cbc_context ctx;
+
+    cbc_encrypt_init(&ctx, rks, iv, cipher);
+    process_iov(out, nout, in, nin, cipher, cbc_update_func, &ctx);
+    cbc_final(&ctx);
+}
+
+void cbc_decrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* drks, const uint8_t* iv, const block_cipher* cipher)
+{
+    cbc_context ctx;
+
+    cbc_decrypt_init(&ctx, drks, iv, cipher);
+    process_iov(out, nout, in, nin, cipher, cbc_update_func, &ctx);
+    cbc_final(&ctx);
+}
+
+// walked like ECB, so no keystream block is generated on its own at a segment boundary
+void ctr_encrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* rks, const uint8_t* iv, const block_cipher* cipher)
+{
+    iov_cursor src, dst;
+    ctr_iov_context ctx = {cipher, rks, iv, 0};
+
+    cursor_init(&src, in, nin);
+    cursor_init(&dst, out, nout);
+    process_blocks_iov(&dst, &src, common_length(out, nout, in, nin), cipher, ctr_update_func, &ctx);
+}
+
+void ctr_decrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* rks, const uint8_t* iv, const block_cipher* cipher)
+{
+    ctr_encrypt_iov(out, nout, in, nin, rks, iv, cipher);
+}
@@ -0,0 +1,57 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "cipher.h"
+
+/**
+ * A buffer segment, laid out like struct iovec so that arrays of either can be passed.
+ */
+typedef struct st_mode_iovec {
+    void* base;
+    size_t length;
+} mode_iovec;
+
+/**
+ * Scatter-gather variants of the modes. The input is the concatenation of the nin segments
+ * of in and the output is written across the nout segments of out, over the shorter of the
+ * two totals; segment boundaries need not fall on block boundaries. Runs that are contiguous in
+ * both lists go straight through the cipher's multi-block path. A block straddling a boundary
+ * is staged together with the blocks following it, up to 16 blocks rounded down to the cipher
+ * batch, so each boundary costs one extra copy of at most that many blocks instead of a
+ * single-block call. in and out may describe the same memory.
+ * ECB and CBC leave a trailing partial block unprocessed, like their one-shot functions.
+ */
+void ecb_encrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* rks, const block_cipher* cipher);
+void ecb_decrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* drks, const block_cipher* cipher);
+
+void ctr_encrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* rks, const uint8_t* iv, const block_cipher* cipher);
+void ctr_decrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* rks, const uint8_t* iv, const block_cipher* cipher);
+
+void cbc_encrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* rks, const uint8_t* iv, const block_cipher* cipher);
+void cbc_decrypt_iov(const mode_iovec* out, size_t nout, const mode_iovec* in, size_t nin, const uint8_t* drks, const uint8_t* iv, const block_cipher* cipher);
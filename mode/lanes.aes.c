@@ -0,0 +1,65 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cipher.h"
+#include "../aes/aes.ni.h"
+
+// the lane keys are the pointers to the round keys of every lane
+static void set_key(uint8_t* keys, size_t lane, const uint8_t* rks)
+{
+    ((const uint8_t**) keys)[lane] = rks;
+}
+
+static void aes128_encrypt_lanes_keys(uint8_t* dst, const uint8_t* src, const uint8_t* keys)
+{
+    aes128_encrypt_lanes(dst, src, (const uint8_t* const*) keys);
+}
+
+static void aes192_encrypt_lanes_keys(uint8_t* dst, const uint8_t* src, const uint8_t* keys)
+{
+    aes192_encrypt_lanes(dst, src, (const uint8_t* const*) keys);
+}
+
+static void aes256_encrypt_lanes_keys(uint8_t* dst, const uint8_t* src, const uint8_t* keys)
+{
+    aes256_encrypt_lanes(dst, src, (const uint8_t* const*) keys);
+}
+
+const lane_cipher LANES_AES128 = {
+    "AES-128", 16, AES_LANES, AES_LANES * sizeof(const uint8_t*),
+    set_key, aes128_encrypt_lanes_keys,
+};
+
+const lane_cipher LANES_AES192 = {
+    "AES-192", 16, AES_LANES, AES_LANES * sizeof(const uint8_t*),
+    set_key, aes192_encrypt_lanes_keys,
+};
+
+const lane_cipher LANES_AES256 = {
+    "AES-256", 16, AES_LANES, AES_LANES * sizeof(const uint8_t*),
+    set_key, aes256_encrypt_lanes_keys,
+};
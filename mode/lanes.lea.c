@@ -0,0 +1,121 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cipher.h"
+#include "../lea/lea.avx2.h"
+
+// the lane keys are the interleaved round keys of lea*_set_lane_key
+
+static void lea128_set_key_x8(uint8_t* keys, size_t lane, const uint8_t* rks)
+{
+    lea128_set_lane_key((uint32_t*) keys, 8, lane, rks);
+}
+
+static void lea128_encrypt_x8(uint8_t* dst, const uint8_t* src, const uint8_t* keys)
+{
+    lea128_encrypt_lanes_x8(dst, src, (const uint32_t*) keys);
+}
+
+static void lea128_set_key_x16(uint8_t* keys, size_t lane, const uint8_t* rks)
+{
+    lea128_set_lane_key((uint32_t*) keys, 16, lane, rks);
+}
+
+static void lea128_encrypt_x16(uint8_t* dst, const uint8_t* src, const uint8_t* keys)
+{
+    lea128_encrypt_lanes_x16(dst, src, (const uint32_t*) keys);
+}
+
+static void lea192_set_key_x8(uint8_t* keys, size_t lane, const uint8_t* rks)
+{
+    lea192_set_lane_key((uint32_t*) keys, 8, lane, rks);
+}
+
+static void lea192_encrypt_x8(uint8_t* dst, const uint8_t* src, const uint8_t* keys)
+{
+    lea192_encrypt_lanes_x8(dst, src, (const uint32_t*) keys);
+}
+
+static void lea192_set_key_x16(uint8_t* keys, size_t lane, const uint8_t* rks)
+{
+    lea192_set_lane_key((uint32_t*) keys, 16, lane, rks);
+}
+
+static void lea192_encrypt_x16(uint8_t* dst, const uint8_t* src, const uint8_t* keys)
+{
+    lea192_encrypt_lanes_x16(dst, src, (const uint32_t*) keys);
+}
+
+static void lea256_set_key_x8(uint8_t* keys, size_t lane, const uint8_t* rks)
+{
+    lea256_set_lane_key((uint32_t*) keys, 8, lane, rks);
+}
+
+static void lea256_encrypt_x8(uint8_t* dst, const uint8_t* src, const uint8_t* keys)
+{
+    lea256_encrypt_lanes_x8(dst, src, (const uint32_t*) keys);
+}
+
+static void lea256_set_key_x16(uint8_t* keys, size_t lane, const uint8_t* rks)
+{
+    lea256_set_lane_key((uint32_t*) keys, 16, lane, rks);
+}
+
+static void lea256_encrypt_x16(uint8_t* dst, const uint8_t* src, const uint8_t* keys)
+{
+    lea256_encrypt_lanes_x16(dst, src, (const uint32_t*) keys);
+}
+
+const lane_cipher LANES_LEA128_X8 = {
+    "LEA-128", 16, 8, 8 * 6 * LEA128_ROUNDS * sizeof(uint32_t),
+    lea128_set_key_x8, lea128_encrypt_x8,
+};
+
+const lane_cipher LANES_LEA192_X8 = {
+    "LEA-192", 16, 8, 8 * 6 * LEA192_ROUNDS * sizeof(uint32_t),
+    lea192_set_key_x8, lea192_encrypt_x8,
+};
+
+const lane_cipher LANES_LEA256_X8 = {
+    "LEA-256", 16, 8, 8 * 6 * LEA256_ROUNDS * sizeof(uint32_t),
+    lea256_set_key_x8, lea256_encrypt_x8,
+};
+
+const lane_cipher LANES_LEA128_X16 = {
+    "LEA-128", 16, 16, 16 * 6 * LEA128_ROUNDS * sizeof(uint32_t),
+    lea128_set_key_x16, lea128_encrypt_x16,
+};
+
+const lane_cipher LANES_LEA192_X16 = {
+    "LEA-192", 16, 16, 16 * 6 * LEA192_ROUNDS * sizeof(uint32_t),
+    lea192_set_key_x16, lea192_encrypt_x16,
+};
+
+const lane_cipher LANES_LEA256_X16 = {
+    "LEA-256", 16, 16, 16 * 6 * LEA256_ROUNDS * sizeof(uint32_t),
+    lea256_set_key_x16, lea256_encrypt_x16,
+};
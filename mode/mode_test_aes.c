@@ -1,7 +1,13 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
 
 #include "ecb.h"
 #include "ctr.h"
+#include "cbc.h"
+#include "iovec.h"
+#include "parallel.h"
 #include "../aes/aes.h"
 
 static void print_hex8(const char* title, uint8_t* data, size_t length)
@@ -17,6 +23,342 @@ static void print_hex8(const char* title, uint8_t* data, size_t length)
     printf("\n");
 }
 
+// the same cipher without its multi-block path
+static block_cipher single_block_cipher(const block_cipher* cipher)
+{
+    block_cipher single = *cipher;
+
+    single.encrypt_blocks = NULL;
+    single.decrypt_blocks = NULL;
+    single.ctr_blocks = NULL;
+
+    return single;
+}
+
+static void compare_ctr(size_t length)
+{
+    block_cipher single = single_block_cipher(&CIPHER_AES128);
+    uint8_t mk[16] = {0};
+    uint8_t iv[16] = {0};
+    uint8_t pt[1024] = {0};
+    uint8_t enc[1024] = {0};
+    uint8_t enc_blocks[1024] = {0};
+    uint8_t dec[1024] = {0};
+
+    // exercises the carry into the upper 64 bits
+    memset(iv, 0xff, 16);
+    iv[15] = 0xf0;
+
+    for (size_t i = 0; i < length; ++i) {
+        pt[i] = (uint8_t) i;
+    }
+
+    uint8_t rks[(AES128_ROUNDS + 1) * 16] = {0,};
+    aes128_keygen(rks, mk);
+
+    ctr_encrypt(enc, pt, rks, iv, length, &single);
+    ctr_encrypt(enc_blocks, pt, rks, iv, length, &CIPHER_AES128);
+    ctr_decrypt(dec, enc_blocks, rks, iv, length, &CIPHER_AES128);
+
+    printf("CTR %ld bytes single/blocks ", length);
+    if (memcmp(enc, enc_blocks, length) == 0 && memcmp(dec, pt, length) == 0) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+static void compare_ctr_at(void)
+{
+    uint8_t mk[16] = {0};
+    uint8_t iv[16] = {0};
+    uint8_t pt[1024] = {0};
+    uint8_t enc[1024] = {0};
+    uint8_t part[1024] = {0};
+    const size_t offsets[] = {0, 1, 15, 16, 17, 250, 1000};
+    const size_t lengths[] = {0, 1, 7, 16, 100, 24};
+    int passed = 1;
+
+    memset(iv, 0xff, 16);
+    iv[15] = 0xfa;
+
+    for (size_t i = 0; i < sizeof(pt); ++i) {
+        pt[i] = (uint8_t) (i * 3);
+    }
+
+    uint8_t rks[(AES128_ROUNDS + 1) * 16] = {0,};
+    aes128_keygen(rks, mk);
+
+    ctr_encrypt(enc, pt, rks, iv, sizeof(pt), &CIPHER_AES128);
+
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); ++i) {
+        for (size_t j = 0; j < sizeof(lengths) / sizeof(lengths[0]); ++j) {
+            size_t offset = offsets[i];
+            size_t length = lengths[j];
+
+            if (offset + length > sizeof(pt)) {
+                continue;
+            }
+
+            ctr_crypt_at(part, enc + offset, rks, iv, offset, length, &CIPHER_AES128);
+            passed &= memcmp(part, pt + offset, length) == 0;
+        }
+    }
+
+    printf("CTR random access ");
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+static void compare_parallel(size_t length)
+{
+    uint8_t mk[16] = {0};
+    uint8_t iv[16] = {0};
+    uint8_t* pt = malloc(length);
+    uint8_t* enc = malloc(length);
+    uint8_t* enc_parallel = malloc(length);
+    int passed = 1;
+
+    iv[15] = 0x80;
+
+    for (size_t i = 0; i < length; ++i) {
+        pt[i] = (uint8_t) (i * 5);
+    }
+
+    uint8_t rks[(AES128_ROUNDS + 1) * 16] = {0,};
+    uint8_t drks[(AES128_ROUNDS + 1) * 16] = {0,};
+    aes128_keygen(rks, mk);
+    aes128_keygen_dec(drks, mk);
+
+    ecb_encrypt(enc, pt, rks, length, &CIPHER_AES128);
+    ecb_encrypt_parallel(enc_parallel, pt, rks, length, &CIPHER_AES128, 0);
+    passed &= memcmp(enc, enc_parallel, length - length % 16) == 0;
+
+    ecb_decrypt_parallel(enc_parallel, enc, drks, length, &CIPHER_AES128, 3);
+    passed &= memcmp(pt, enc_parallel, length - length % 16) == 0;
+
+    ctr_encrypt(enc, pt, rks, iv, length, &CIPHER_AES128);
+    ctr_encrypt_parallel(enc_parallel, pt, rks, iv, length, &CIPHER_AES128, 0);
+    passed &= memcmp(enc, enc_parallel, length) == 0;
+
+    ctr_decrypt_parallel(enc_parallel, enc, rks, iv, length, &CIPHER_AES128, 3);
+    passed &= memcmp(pt, enc_parallel, length) == 0;
+
+    printf("ECB/CTR parallel %ld bytes ", length);
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+
+    free(pt);
+    free(enc);
+    free(enc_parallel);
+}
+
+static void benchmark_parallel(size_t length, size_t iterations)
+{
+    uint8_t mk[16] = {0};
+    uint8_t iv[16] = {0};
+    uint8_t* pt = calloc(length, 1);
+    uint8_t* enc = calloc(length, 1);
+
+    uint8_t rks[(AES128_ROUNDS + 1) * 16] = {0,};
+    aes128_keygen(rks, mk);
+
+    double start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        ctr_encrypt(enc, pt, rks, iv, length, &CIPHER_AES128);
+    }
+
+    double elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld bytes of ctr(blocks): %lf sec\n", length * iterations, elapsed);
+
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        ctr_encrypt_parallel(enc, pt, rks, iv, length, &CIPHER_AES128, 0);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld bytes of ctr(parallel, %d threads): %lf sec\n", length * iterations, omp_get_max_threads(), elapsed);
+
+    free(pt);
+    free(enc);
+}
+
+// records of three segments, copied into one buffer for ctr_encrypt or passed as they are
+static void benchmark_iovec(size_t iterations)
+{
+    uint8_t mk[16] = {0};
+    uint8_t iv[16] = {0};
+    uint8_t head[13] = {0};
+    uint8_t body[1400] = {0};
+    uint8_t tail[87] = {0};
+    uint8_t record[1500] = {0};
+    mode_iovec iov[3] = {{head, sizeof(head)}, {body, sizeof(body)}, {tail, sizeof(tail)}};
+
+    uint8_t rks[(AES128_ROUNDS + 1) * 16] = {0,};
+    aes128_keygen(rks, mk);
+
+    double start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        memcpy(record, head, sizeof(head));
+        memcpy(record + sizeof(head), body, sizeof(body));
+        memcpy(record + sizeof(head) + sizeof(body), tail, sizeof(tail));
+        ctr_encrypt(record, record, rks, iv, sizeof(record), &CIPHER_AES128);
+        memcpy(head, record, sizeof(head));
+        memcpy(body, record + sizeof(head), sizeof(body));
+        memcpy(tail, record + sizeof(head) + sizeof(body), sizeof(tail));
+    }
+
+    double elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld records of ctr(bounce buffer): %lf sec\n", iterations, elapsed);
+
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        ctr_encrypt_iov(iov, 3, iov, 3, rks, iv, &CIPHER_AES128);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld records of ctr(iovec): %lf sec\n", iterations, elapsed);
+}
+
+// NIST SP 800-38A, F.2.1 and F.2.2
+static void test_cbc(void)
+{
+    uint8_t mk[] = {
+        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+    };
+    uint8_t iv[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    };
+    uint8_t pt[] = {
+        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+    };
+    uint8_t ct[] = {
+        0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+        0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+        0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+        0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09, 0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7
+    };
+    uint8_t enc[64] = {0};
+    uint8_t dec[64] = {0};
+    uint8_t padded[32] = {0};
+    size_t length = 0;
+    int passed = 1;
+
+    uint8_t rks[(AES128_ROUNDS + 1) * 16] = {0,};
+    uint8_t drks[(AES128_ROUNDS + 1) * 16] = {0,};
+    aes128_keygen(rks, mk);
+    aes128_keygen_dec(drks, mk);
+
+    cbc_encrypt(enc, pt, rks, iv, 64, &CIPHER_AES128);
+    cbc_decrypt(dec, ct, drks, iv, 64, &CIPHER_AES128);
+
+    print_hex8("CBC_ENC", enc, 64);
+    print_hex8("CBC_DEC", dec, 64);
+
+    passed &= memcmp(enc, ct, 64) == 0;
+    passed &= memcmp(dec, pt, 64) == 0;
+
+    // 16 bytes of data get a whole block of padding
+    memcpy(padded, pt, 16);
+    passed &= pkcs7_pad(padded, 16, 16) == 32 && padded[31] == 16 && padded[16] == 16;
+    passed &= pkcs7_unpad(padded, 32, 16, &length) == 0 && length == 16;
+
+    memcpy(padded, pt, 16);
+    passed &= pkcs7_pad(padded, 13, 16) == 16 && padded[13] == 3 && padded[15] == 3;
+    passed &= pkcs7_unpad(padded, 16, 16, &length) == 0 && length == 13;
+
+    padded[14] = 2;
+    passed &= pkcs7_unpad(padded, 16, 16, &length) == -1;
+
+    printf("CBC and PKCS#7 ");
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+static void benchmark(size_t iterations)
+{
+    block_cipher single = single_block_cipher(&CIPHER_AES128);
+    uint8_t mk[16] = {0};
+    uint8_t iv[16] = {0};
+    uint8_t pt[4096] = {0};
+    uint8_t enc[4096] = {0};
+
+    uint8_t rks[(AES128_ROUNDS + 1) * 16] = {0,};
+    uint8_t drks[(AES128_ROUNDS + 1) * 16] = {0,};
+    aes128_keygen(rks, mk);
+    aes128_keygen_dec(drks, mk);
+
+    double start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        ctr_encrypt(enc, pt, rks, iv, sizeof(pt), &single);
+    }
+
+    double elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld bytes of ctr(single): %lf sec\n", sizeof(pt) * iterations, elapsed);
+
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        ctr_encrypt(enc, pt, rks, iv, sizeof(pt), &CIPHER_AES128);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld bytes of ctr(blocks): %lf sec\n", sizeof(pt) * iterations, elapsed);
+
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        cbc_encrypt(enc, pt, rks, iv, sizeof(pt), &CIPHER_AES128);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld bytes of cbc encryption: %lf sec\n", sizeof(pt) * iterations, elapsed);
+
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        cbc_decrypt(pt, enc, drks, iv, sizeof(pt), &single);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld bytes of cbc decryption(single): %lf sec\n", sizeof(pt) * iterations, elapsed);
+
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        cbc_decrypt(pt, enc, drks, iv, sizeof(pt), &CIPHER_AES128);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld bytes of cbc decryption(blocks): %lf sec\n", sizeof(pt) * iterations, elapsed);
+}
+
 int main()
 {
     uint8_t mk[] = {
@@ -41,19 +383,32 @@ int main()
     size_t length = 32;
 
     uint8_t rks[(AES128_ROUNDS + 1) * 16] = {0,};
+    uint8_t drks[(AES128_ROUNDS + 1) * 16] = {0,};
     aes128_keygen(rks, mk);
+    aes128_keygen_dec(drks, mk);
 
-    ecb_encrypt(enc, pt, rks, 16, length, aes128_encrypt);
-    ecb_decrypt(dec, ct_ecb, rks, 16, length, aes128_decrypt);
+    ecb_encrypt(enc, pt, rks, length, &CIPHER_AES128);
+    ecb_decrypt(dec, ct_ecb, drks, length, &CIPHER_AES128);
 
     print_hex8("ECB_ENC", enc, length);
     print_hex8("ECB_DEC", dec, length);
 
-    ctr_encrypt(enc, pt, rks, ctr, 16, length, aes128_encrypt);
-    ctr_decrypt(dec, ct_ctr, rks, ctr, 16, length, aes128_encrypt);
+    ctr_encrypt(enc, pt, rks, ctr, length, &CIPHER_AES128);
+    ctr_decrypt(dec, ct_ctr, rks, ctr, length, &CIPHER_AES128);
 
     print_hex8("CTR_ENC", enc, length);
     print_hex8("CTR_DEC", dec, length);
 
+    compare_ctr(1);
+    compare_ctr(255);
+    compare_ctr(1024);
+    compare_ctr_at();
+    test_cbc();
+    compare_parallel(1000000 + 7);
+
+    benchmark(10000);
+    benchmark_iovec(100000);
+    benchmark_parallel(16 * 1024 * 1024, 4);
+
     return 0;
 }
\ No newline at end of file
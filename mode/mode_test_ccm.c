@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#include "cbc.h"
+#include "ctr.h"
+#include "ccm.h"
+
+#define TEST_LENGTH 1000
+
+typedef struct st_ccm_vector {
+    const block_cipher* cipher;
+    size_t noncelen;
+    size_t taglen;
+    size_t aadlen;
+    size_t length;
+    uint8_t ct[32];
+    uint8_t tag[16];
+} ccm_vector;
+
+static const ccm_vector VECTORS[] = {
+    {&CIPHER_AES128, 7, 4, 0, 0,
+        {0},
+        {0x65, 0x95, 0xf4, 0xa0}},
+    {&CIPHER_AES128, 13, 16, 20, 100,
+        {0x41, 0xa4, 0xe5, 0xd4, 0x6d, 0x51, 0xa3, 0x8b, 0xc2, 0x8c, 0xd9, 0x4e, 0x29, 0xc3, 0x84, 0x8d,
+         0xf1, 0x14, 0xb5, 0x04, 0x2c, 0x0d, 0x45, 0xae, 0x34, 0x1b, 0xa9, 0x46, 0x26, 0xfe, 0x14, 0x34},
+        {0xdf, 0x6e, 0xc3, 0x33, 0xfd, 0xa7, 0x11, 0xd1, 0xeb, 0x13, 0x22, 0x4c, 0x26, 0x38, 0xab, 0xad}},
+    {&CIPHER_AES192, 12, 8, 300, 37,
+        {0x73, 0x28, 0x1b, 0x2a, 0xac, 0x13, 0xb4, 0x49, 0x29, 0x92, 0x8a, 0x4c, 0x99, 0x8d, 0x93, 0x93,
+         0xfe, 0x53, 0x5e, 0x79, 0x21, 0xd6, 0x8c, 0x67, 0x74, 0x43, 0x29, 0x96, 0x3d, 0xf2, 0xf8, 0xd1},
+        {0xe4, 0xa1, 0x2f, 0xdb, 0x91, 0xb3, 0x62, 0x2f}},
+    {&CIPHER_AES256, 8, 10, 65300, 1000,
+        {0x15, 0x6e, 0x0f, 0xae, 0x6e, 0x8d, 0xcf, 0x96, 0x51, 0x2a, 0x7a, 0x9d, 0x35, 0x2b, 0x62, 0x59,
+         0xb0, 0x9b, 0x11, 0x6d, 0x73, 0xf8, 0x65, 0xc3, 0xd5, 0x7f, 0x4a, 0x12, 0x0c, 0x64, 0x97, 0x3a},
+        {0x69, 0xab, 0x73, 0xd9, 0x5b, 0xcd, 0x19, 0xc9, 0x07, 0x7c}},
+    {&CIPHER_ARIA128, 13, 16, 20, 100,
+        {0x52, 0x3f, 0xcb, 0x97, 0x3a, 0x19, 0x30, 0x2b, 0x4e, 0x54, 0x71, 0x9c, 0x39, 0x1a, 0x07, 0x53,
+         0xb3, 0x01, 0x45, 0xea, 0x6e, 0x62, 0xe1, 0x6f, 0xfa, 0xc4, 0x7a, 0x31, 0x75, 0xe6, 0x7e, 0x3d},
+        {0x74, 0x72, 0x35, 0x52, 0xe4, 0x71, 0x32, 0xa5, 0x6c, 0xaf, 0x44, 0x6b, 0x63, 0xc2, 0xde, 0xdb}},
+    {&CIPHER_ARIA256, 11, 12, 5, 1000,
+        {0xcd, 0x94, 0x68, 0x85, 0xb6, 0xf0, 0x3d, 0x23, 0x02, 0xdd, 0xce, 0x86, 0x5d, 0x89, 0xf6, 0x67,
+         0xce, 0x3a, 0xbe, 0xf3, 0x8e, 0xae, 0x60, 0x7a, 0xe8, 0xcd, 0x40, 0x09, 0xcf, 0x4e, 0x88, 0x23},
+        {0x8e, 0xd1, 0x33, 0x8f, 0x54, 0xbd, 0x97, 0x0a, 0x65, 0x40, 0xb6, 0x51}},
+};
+
+static uint8_t mk[32];
+static uint8_t nonce[13];
+static uint8_t aad[70000];
+static uint8_t pt[TEST_LENGTH];
+
+static void init_inputs()
+{
+    for (size_t i = 0; i < sizeof(mk); ++i) {
+        mk[i] = (uint8_t) (i * 3 + 1);
+    }
+
+    for (size_t i = 0; i < sizeof(nonce); ++i) {
+        nonce[i] = (uint8_t) (0x10 + i);
+    }
+
+    for (size_t i = 0; i < sizeof(aad); ++i) {
+        aad[i] = (uint8_t) (i * 5);
+    }
+
+    for (size_t i = 0; i < sizeof(pt); ++i) {
+        pt[i] = (uint8_t) (i * 7);
+    }
+}
+
+static void print_result(const char* name, const char* test, int passed)
+{
+    printf("%-14s %s ", name, test);
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+static void test_vector(const ccm_vector* vector)
+{
+    const block_cipher* cipher = vector->cipher;
+    size_t check = (vector->length < 32) ? vector->length : 32;
+    uint8_t rks[1024];
+    uint8_t ct[TEST_LENGTH];
+    uint8_t dec[TEST_LENGTH];
+    uint8_t tag[16];
+    int passed = 1;
+
+    cipher->keygen(rks, mk);
+
+    passed &= ccm_encrypt(ct, tag, vector->taglen, pt, vector->length, aad, vector->aadlen, nonce, vector->noncelen, rks, cipher) == 0;
+    passed &= memcmp(ct, vector->ct, check) == 0;
+    passed &= memcmp(tag, vector->tag, vector->taglen) == 0;
+
+    passed &= ccm_decrypt(dec, ct, vector->length, tag, vector->taglen, aad, vector->aadlen, nonce, vector->noncelen, rks, cipher) == 0;
+    passed &= memcmp(dec, pt, vector->length) == 0;
+
+    print_result(cipher->name, "CCM", passed);
+}
+
+static void test_cipher(const block_cipher* cipher)
+{
+    uint8_t rks[1024];
+    uint8_t ct[TEST_LENGTH];
+    uint8_t dec[TEST_LENGTH];
+    uint8_t tag[16];
+    int passed = 1;
+
+    cipher->keygen(rks, mk);
+
+    for (size_t length = 0; length <= 100; ++length) {
+        ccm_encrypt(ct, tag, 8, pt, length, aad, length % 33, nonce, 12, rks, cipher);
+        memcpy(dec, ct, length);
+        passed &= ccm_decrypt(dec, dec, length, tag, 8, aad, length % 33, nonce, 12, rks, cipher) == 0;
+        passed &= memcmp(dec, pt, length) == 0;
+    }
+
+    ccm_encrypt(ct, tag, 16, pt, TEST_LENGTH, aad, 20, nonce, 13, rks, cipher);
+
+    tag[0] ^= 1;
+    passed &= ccm_decrypt(dec, ct, TEST_LENGTH, tag, 16, aad, 20, nonce, 13, rks, cipher) == -1;
+    tag[0] ^= 1;
+
+    ct[TEST_LENGTH - 1] ^= 1;
+    passed &= ccm_decrypt(dec, ct, TEST_LENGTH, tag, 16, aad, 20, nonce, 13, rks, cipher) == -1;
+    passed &= dec[0] == 0 && dec[TEST_LENGTH - 1] == 0;
+
+    // length does not fit in the 2-byte length field of a 13-byte nonce
+    passed &= ccm_encrypt(ct, tag, 16, pt, 0x10000, aad, 0, nonce, 13, rks, cipher) == -1;
+    passed &= ccm_encrypt(ct, tag, 5, pt, TEST_LENGTH, aad, 0, nonce, 13, rks, cipher) == -1;
+    passed &= ccm_encrypt(ct, tag, 16, pt, TEST_LENGTH, aad, 0, nonce, 6, rks, cipher) == -1;
+
+    print_result(cipher->name, "CCM encrypt/decrypt", passed);
+}
+
+// the same cipher with parallel moved across 2 takes the other CCM path
+static void test_paths(const block_cipher* cipher)
+{
+    block_cipher other = *cipher;
+    uint8_t rks[1024];
+    uint8_t ct[TEST_LENGTH];
+    uint8_t expected[TEST_LENGTH];
+    uint8_t tag[16];
+    uint8_t expected_tag[16];
+    int passed = 1;
+
+    other.parallel = (cipher->parallel == 0 || cipher->parallel > 2) ? 2 : 0;
+
+    cipher->keygen(rks, mk);
+
+    for (size_t length = 0; length <= TEST_LENGTH; length += 97) {
+        ccm_encrypt(expected, expected_tag, 16, pt, length, aad, length % 33, nonce, 13, rks, cipher);
+        ccm_encrypt(ct, tag, 16, pt, length, aad, length % 33, nonce, 13, rks, &other);
+        passed &= memcmp(ct, expected, length) == 0;
+        passed &= memcmp(tag, expected_tag, 16) == 0;
+        passed &= ccm_decrypt(ct, ct, length, tag, 16, aad, length % 33, nonce, 13, rks, &other) == 0;
+        passed &= memcmp(ct, pt, length) == 0;
+    }
+
+    print_result(cipher->name, "CCM interleaved/two passes", passed);
+}
+
+static void benchmark(const block_cipher* cipher)
+{
+    size_t length = 1 << 10;
+    size_t count = 1 << 14;
+    uint8_t rks[1024];
+    uint8_t iv[16] = {0};
+    uint8_t tag[16];
+    uint8_t* data = calloc(length, 1);
+    uint8_t* mac = calloc(length, 1);
+
+    cipher->keygen(rks, mk);
+
+    double start = omp_get_wtime();
+
+    for (size_t i = 0; i < count; ++i) {
+        cbc_encrypt(mac, data, rks, iv, length, cipher);
+        ctr_encrypt(data, data, rks, iv, length, cipher);
+    }
+
+    double elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld records of %ld bytes, %s cbc-mac + ctr(two passes): %lf sec\n", count, length, cipher->name, elapsed);
+
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < count; ++i) {
+        ccm_encrypt(data, tag, 16, data, length, aad, 16, nonce, 13, rks, cipher);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld records of %ld bytes, %s ccm: %lf sec\n", count, length, cipher->name, elapsed);
+
+    free(data);
+    free(mac);
+}
+
+int main()
+{
+    init_inputs();
+
+    for (size_t i = 0; i < sizeof(VECTORS) / sizeof(VECTORS[0]); ++i) {
+        test_vector(&VECTORS[i]);
+    }
+
+    test_cipher(&CIPHER_AES128);
+    test_cipher(&CIPHER_ARIA192);
+    test_cipher(&CIPHER_LEA128);
+    test_cipher(&CIPHER_LEA256);
+
+    test_paths(&CIPHER_AES128);
+    test_paths(&CIPHER_LEA128);
+    test_paths(&CIPHER_LEA256);
+
+    benchmark(&CIPHER_AES128);
+    benchmark(&CIPHER_LEA128);
+    benchmark(&CIPHER_ARIA128);
+
+    return 0;
+}
@@ -0,0 +1,302 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "ecb.h"
+#include "ctr.h"
+#include "cbc.h"
+#include "iovec.h"
+
+#define TEST_LENGTH 1000
+
+// the same cipher without its multi-block path
+static block_cipher single_block_cipher(const block_cipher* cipher)
+{
+    block_cipher single = *cipher;
+
+    single.encrypt_blocks = NULL;
+    single.decrypt_blocks = NULL;
+    single.ctr_blocks = NULL;
+
+    return single;
+}
+
+static void test_cipher(const block_cipher* cipher)
+{
+    block_cipher single = single_block_cipher(cipher);
+    uint8_t mk[32] = {0};
+    uint8_t iv[16] = {0};
+    uint8_t rks[1024] = {0};
+    uint8_t drks[1024] = {0};
+    uint8_t pt[TEST_LENGTH] = {0};
+    uint8_t enc[TEST_LENGTH] = {0};
+    uint8_t enc_single[TEST_LENGTH] = {0};
+    uint8_t dec[TEST_LENGTH] = {0};
+    size_t length = TEST_LENGTH - (TEST_LENGTH % cipher->blocksize);
+    int passed = 1;
+
+    for (size_t i = 0; i < sizeof(mk); ++i) {
+        mk[i] = (uint8_t) (0x11 * i);
+    }
+
+    for (size_t i = 0; i < sizeof(iv); ++i) {
+        iv[i] = 0xff - i;
+    }
+
+    for (size_t i = 0; i < sizeof(pt); ++i) {
+        pt[i] = (uint8_t) (i * 7);
+    }
+
+    cipher->keygen(rks, mk);
+    cipher->keygen_dec(drks, mk);
+
+    ecb_encrypt(enc, pt, rks, length, cipher);
+    ecb_encrypt(enc_single, pt, rks, length, &single);
+    ecb_decrypt(dec, enc, drks, length, cipher);
+    passed &= memcmp(enc, enc_single, length) == 0;
+    passed &= memcmp(dec, pt, length) == 0;
+
+    ctr_encrypt(enc, pt, rks, iv, TEST_LENGTH, cipher);
+    ctr_encrypt(enc_single, pt, rks, iv, TEST_LENGTH, &single);
+    ctr_decrypt(dec, enc, rks, iv, TEST_LENGTH, cipher);
+    passed &= memcmp(enc, enc_single, TEST_LENGTH) == 0;
+    passed &= memcmp(dec, pt, TEST_LENGTH) == 0;
+
+    ctr_crypt_at(dec, enc + 333, rks, iv, 333, 500, cipher);
+    passed &= memcmp(dec, pt + 333, 500) == 0;
+
+    cbc_encrypt(enc, pt, rks, iv, length, cipher);
+    cbc_encrypt(enc_single, pt, rks, iv, length, &single);
+    cbc_decrypt(dec, enc, drks, iv, length, cipher);
+    passed &= memcmp(enc, enc_single, length) == 0;
+    passed &= memcmp(dec, pt, length) == 0;
+
+    cbc_decrypt(enc_single, enc_single, drks, iv, length, &single);
+    passed &= memcmp(enc_single, pt, length) == 0;
+
+    memcpy(dec, enc, length);
+    cbc_decrypt(dec, dec, drks, iv, length, cipher);
+    passed &= memcmp(dec, pt, length) == 0;
+
+    printf("%-14s ECB/CTR/CBC ", cipher->name);
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+// streaming contexts fed in fragments of uneven lengths against the one-shot functions
+static void test_streaming(const block_cipher* cipher)
+{
+    static const size_t fragments[] = {1, 3, 17, 0, 40, 5, 16, 64, 2, 100};
+    uint8_t mk[32] = {0};
+    uint8_t iv[16] = {0};
+    uint8_t rks[1024] = {0};
+    uint8_t drks[1024] = {0};
+    uint8_t pt[TEST_LENGTH] = {0};
+    uint8_t expected[TEST_LENGTH] = {0};
+    uint8_t enc[TEST_LENGTH] = {0};
+    uint8_t dec[TEST_LENGTH] = {0};
+    size_t length = TEST_LENGTH - (TEST_LENGTH % cipher->blocksize);
+    ecb_context ecb;
+    ctr_context ctr;
+    cbc_context cbc;
+    int passed = 1;
+
+    for (size_t i = 0; i < sizeof(mk); ++i) {
+        mk[i] = (uint8_t) (0x11 * i);
+    }
+
+    for (size_t i = 0; i < sizeof(iv); ++i) {
+        iv[i] = 0xff - i;
+    }
+
+    for (size_t i = 0; i < sizeof(pt); ++i) {
+        pt[i] = (uint8_t) (i * 7);
+    }
+
+    cipher->keygen(rks, mk);
+    cipher->keygen_dec(drks, mk);
+
+    size_t in = 0, out = 0, next = 0;
+
+    // CTR, fragments in place
+    memcpy(enc, pt, TEST_LENGTH);
+    ctr_encrypt(expected, pt, rks, iv, TEST_LENGTH, cipher);
+    ctr_init(&ctr, rks, iv, cipher);
+    for (in = 0; in < TEST_LENGTH; in += fragments[next], next = (next + 1) % 10) {
+        size_t chunk = (TEST_LENGTH - in < fragments[next]) ? TEST_LENGTH - in : fragments[next];
+        ctr_update(&ctr, enc + in, enc + in, chunk);
+    }
+    ctr_final(&ctr);
+    passed &= memcmp(enc, expected, TEST_LENGTH) == 0;
+
+    // ECB and CBC, the output lags the input by the pending partial block
+    ecb_encrypt(expected, pt, rks, length, cipher);
+    ecb_encrypt_init(&ecb, rks, cipher);
+    for (in = 0, out = 0; in < TEST_LENGTH; in += fragments[next], next = (next + 1) % 10) {
+        size_t chunk = (TEST_LENGTH - in < fragments[next]) ? TEST_LENGTH - in : fragments[next];
+        out += ecb_update(&ecb, enc + out, pt + in, chunk);
+    }
+    passed &= ecb_final(&ecb) == TEST_LENGTH - length;
+    passed &= out == length && memcmp(enc, expected, length) == 0;
+
+    ecb_decrypt_init(&ecb, drks, cipher);
+    for (in = 0, out = 0; in < length; in += fragments[next], next = (next + 1) % 10) {
+        size_t chunk = (length - in < fragments[next]) ? length - in : fragments[next];
+        out += ecb_update(&ecb, dec + out, enc + in, chunk);
+    }
+    passed &= ecb_final(&ecb) == 0;
+    passed &= out == length && memcmp(dec, pt, length) == 0;
+
+    cbc_encrypt(expected, pt, rks, iv, length, cipher);
+    cbc_encrypt_init(&cbc, rks, iv, cipher);
+    for (in = 0, out = 0; in < TEST_LENGTH; in += fragments[next], next = (next + 1) % 10) {
+        size_t chunk = (TEST_LENGTH - in < fragments[next]) ? TEST_LENGTH - in : fragments[next];
+        out += cbc_update(&cbc, enc + out, pt + in, chunk);
+    }
+    passed &= cbc_final(&cbc) == TEST_LENGTH - length;
+    passed &= out == length && memcmp(enc, expected, length) == 0;
+
+    cbc_decrypt_init(&cbc, drks, iv, cipher);
+    for (in = 0, out = 0; in < length; in += fragments[next], next = (next + 1) % 10) {
+        size_t chunk = (length - in < fragments[next]) ? length - in : fragments[next];
+        out += cbc_update(&cbc, dec + out, enc + in, chunk);
+    }
+    passed &= cbc_final(&cbc) == 0;
+    passed &= out == length && memcmp(dec, pt, length) == 0;
+
+    // whole-block updates in place
+    memcpy(dec, enc, length);
+    cbc_decrypt_init(&cbc, drks, iv, cipher);
+    for (in = 0; in < length; in += 3 * cipher->blocksize) {
+        size_t chunk = (length - in < 3 * cipher->blocksize) ? length - in : 3 * cipher->blocksize;
+        cbc_update(&cbc, dec + in, dec + in, chunk);
+    }
+    passed &= memcmp(dec, pt, length) == 0;
+
+    printf("%-14s streaming ECB/CTR/CBC ", cipher->name);
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+// splits a buffer into segments of the given lengths, the last one takes the rest
+static size_t split_iov(mode_iovec* iov, uint8_t* data, size_t length, const size_t* sizes, size_t nsizes)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < nsizes && length > 0; ++i) {
+        size_t size = (sizes[i] < length) ? sizes[i] : length;
+        iov[count].base = data;
+        iov[count].length = size;
+        data += size;
+        length -= size;
+        count += 1;
+    }
+
+    if (length > 0) {
+        iov[count].base = data;
+        iov[count].length = length;
+        count += 1;
+    }
+
+    return count;
+}
+
+// segment lists with boundaries inside blocks, against the contiguous functions
+static void test_iovec(const block_cipher* cipher)
+{
+    static const size_t in_sizes[] = {7, 0, 33, 100, 1, 2, 3, 256, 15, 17, 64};
+    static const size_t out_sizes[] = {50, 3, 16, 0, 9, 300, 5, 31, 128};
+    mode_iovec in[16];
+    mode_iovec out[16];
+    uint8_t mk[32] = {0};
+    uint8_t iv[16] = {0};
+    uint8_t rks[1024] = {0};
+    uint8_t drks[1024] = {0};
+    uint8_t pt[TEST_LENGTH] = {0};
+    uint8_t expected[TEST_LENGTH] = {0};
+    uint8_t enc[TEST_LENGTH] = {0};
+    uint8_t dec[TEST_LENGTH] = {0};
+    size_t length = TEST_LENGTH - (TEST_LENGTH % cipher->blocksize);
+    int passed = 1;
+
+    for (size_t i = 0; i < sizeof(mk); ++i) {
+        mk[i] = (uint8_t) (0x11 * i);
+    }
+
+    for (size_t i = 0; i < sizeof(iv); ++i) {
+        iv[i] = 0xff - i;
+    }
+
+    for (size_t i = 0; i < sizeof(pt); ++i) {
+        pt[i] = (uint8_t) (i * 7);
+    }
+
+    cipher->keygen(rks, mk);
+    cipher->keygen_dec(drks, mk);
+
+    size_t nin = split_iov(in, pt, TEST_LENGTH, in_sizes, 11);
+    size_t nout = split_iov(out, enc, TEST_LENGTH, out_sizes, 9);
+
+    ecb_encrypt(expected, pt, rks, length, cipher);
+    ecb_encrypt_iov(out, nout, in, nin, rks, cipher);
+    passed &= memcmp(enc, expected, length) == 0;
+
+    ctr_encrypt(expected, pt, rks, iv, TEST_LENGTH, cipher);
+    ctr_encrypt_iov(out, nout, in, nin, rks, iv, cipher);
+    passed &= memcmp(enc, expected, TEST_LENGTH) == 0;
+
+    cbc_encrypt(expected, pt, rks, iv, length, cipher);
+    cbc_encrypt_iov(out, nout, in, nin, rks, iv, cipher);
+    passed &= memcmp(enc, expected, length) == 0;
+
+    // back through the other segmentation, then in place over the same list
+    size_t nback = split_iov(in, enc, TEST_LENGTH, in_sizes, 11);
+    size_t ndec = split_iov(out, dec, TEST_LENGTH, out_sizes, 9);
+    cbc_decrypt_iov(out, ndec, in, nback, drks, iv, cipher);
+    passed &= memcmp(dec, pt, length) == 0;
+
+    ecb_decrypt_iov(out, ndec, in, nback, drks, cipher);
+    ecb_encrypt(expected, dec, rks, length, cipher);
+    passed &= memcmp(expected, enc, length) == 0;
+
+    cbc_decrypt_iov(in, nback, in, nback, drks, iv, cipher);
+    passed &= memcmp(enc, pt, length) == 0;
+
+    printf("%-14s scatter-gather ECB/CTR/CBC ", cipher->name);
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+int main()
+{
+    const block_cipher* ciphers[] = {
+        &CIPHER_AES128, &CIPHER_AES192, &CIPHER_AES256,
+        &CIPHER_ARIA128, &CIPHER_ARIA192, &CIPHER_ARIA256,
+        &CIPHER_CHAM64, &CIPHER_CHAM128, &CIPHER_CHAM256,
+        &CIPHER_HIGHT,
+        &CIPHER_LEA128, &CIPHER_LEA192, &CIPHER_LEA256,
+        &CIPHER_SEED,
+    };
+
+    for (size_t i = 0; i < sizeof(ciphers) / sizeof(ciphers[0]); ++i) {
+        test_cipher(ciphers[i]);
+    }
+
+    for (size_t i = 0; i < sizeof(ciphers) / sizeof(ciphers[0]); ++i) {
+        test_streaming(ciphers[i]);
+    }
+
+    for (size_t i = 0; i < sizeof(ciphers) / sizeof(ciphers[0]); ++i) {
+        test_iovec(ciphers[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#include "ctr.h"
+#include "gcm.h"
+
+#define TEST_LENGTH 1000
+
+static const uint8_t CT_AES128[] = {
+    0x1b, 0x50, 0x01, 0x81, 0x11, 0xd1, 0xe2, 0x4d, 0x9b, 0xcc, 0x7b, 0xd8, 0x09, 0x8b, 0xad, 0x7a,
+    0x43, 0x9e, 0xe4, 0xdd, 0xde, 0x50, 0xf6, 0x28, 0x5b, 0xfd, 0x03, 0xb0, 0x13, 0xde, 0x63, 0x15,
+    0x81, 0xc8, 0x2d, 0x68, 0x4e, 0x7a, 0xb7, 0x1e, 0xee, 0xee, 0xea, 0xa2, 0xc4, 0xb8, 0x1b, 0x7d,
+    0x14, 0x57, 0xb4, 0x9b, 0x9e, 0x84, 0xdb, 0x1d, 0x25, 0x0c, 0x51, 0x3b, 0xcd, 0xdb, 0x43, 0xc8,
+    0x0d, 0x91, 0xd2, 0x9f, 0x0b, 0xb6, 0xfd, 0x5e, 0x07, 0x9a, 0x74, 0x6e, 0x00, 0x13, 0x1e, 0x09,
+    0x4d, 0x3c, 0x5f, 0x1d, 0x26, 0x50, 0x00, 0x9c, 0x51, 0x0c, 0xa2, 0x21, 0x3d, 0x72, 0x0c, 0x68,
+    0x76, 0x47, 0xd9, 0x96,
+};
+
+static const uint8_t TAG_AES128[] = {0x72, 0xbc, 0xe8, 0xec, 0xb6, 0xc0, 0x6c, 0x0a, 0x7a, 0x65, 0x35, 0x8a, 0x52, 0x08, 0xe3, 0x28};
+
+static const uint8_t CT_ARIA128[] = {
+    0x3d, 0x51, 0x77, 0xac, 0x13, 0x37, 0xa5, 0xe6, 0xcf, 0x78, 0x51, 0x65, 0x8c, 0x9b, 0xa3, 0x35,
+    0xfc, 0xef, 0x48, 0x9f, 0xfc, 0xe1, 0xee, 0xf7, 0xda, 0x67, 0xca, 0xcf, 0x89, 0x92, 0x9d, 0x3c,
+    0x55, 0x3b, 0x38, 0xf2, 0x17, 0x44, 0xd0, 0x55, 0x2c, 0x89, 0x2c, 0x10, 0xf5, 0x75, 0x25, 0x5c,
+    0x29, 0xf3, 0x3e, 0xfc, 0x55, 0x27, 0xfe, 0xc6, 0x10, 0x73, 0x26, 0xeb, 0x4e, 0x25, 0x80, 0x67,
+    0xa3, 0xb7, 0x12, 0x66, 0x8d, 0x24, 0x56, 0xed, 0x54, 0xb4, 0xc5, 0x14, 0xe4, 0xfb, 0x4b, 0xa2,
+    0x76, 0xd4, 0x7b, 0x83, 0x1a, 0xc8, 0xf5, 0x53, 0x13, 0xc8, 0x2c, 0xb2, 0x43, 0xc4, 0x8f, 0x29,
+    0x89, 0x37, 0x4c, 0xb9,
+};
+
+static const uint8_t TAG_ARIA128[] = {0xa7, 0x6f, 0x7d, 0xe4, 0x39, 0x07, 0x49, 0x1d, 0x1e, 0xd7, 0xdb, 0xbe, 0xae, 0x44, 0x4e, 0xea};
+
+// tags over TEST_LENGTH bytes, with 96-bit and 480-bit ivs in turn
+static const uint8_t TAGS_LONG[][16] = {
+    {0xaf, 0xa4, 0x7d, 0x7e, 0xbb, 0x72, 0x29, 0xcd, 0xdb, 0x39, 0x79, 0x16, 0xff, 0x9f, 0x5e, 0x92},
+    {0x32, 0x3c, 0x10, 0x56, 0xae, 0x12, 0xce, 0x7c, 0x74, 0x94, 0xba, 0x9c, 0x38, 0x88, 0xd4, 0xab},
+    {0xdf, 0x32, 0x96, 0x0b, 0xad, 0x5a, 0x4d, 0xb8, 0xdf, 0xca, 0xa4, 0xeb, 0x60, 0xfe, 0x69, 0xfe},
+    {0xb5, 0xbd, 0x0e, 0x3c, 0x1f, 0xc6, 0xfc, 0x57, 0x25, 0xec, 0xf0, 0x09, 0xc0, 0x8c, 0xd0, 0xe5},
+    {0x25, 0xad, 0x82, 0xfd, 0xbf, 0x70, 0x81, 0x4d, 0x4d, 0x70, 0x3d, 0x2f, 0x86, 0xd8, 0x70, 0xdd},
+    {0xd6, 0x16, 0x7f, 0x3a, 0x80, 0x33, 0xa2, 0xe2, 0xa0, 0xf7, 0x72, 0xa1, 0x2b, 0x36, 0x30, 0xca},
+};
+
+static uint8_t mk[32];
+static uint8_t iv[60];
+static uint8_t aad[20];
+static uint8_t pt[TEST_LENGTH];
+
+static void init_inputs()
+{
+    for (size_t i = 0; i < sizeof(mk); ++i) {
+        mk[i] = (uint8_t) (i * 3 + 1);
+    }
+
+    for (size_t i = 0; i < sizeof(iv); ++i) {
+        iv[i] = (uint8_t) (0xc0 + i);
+    }
+
+    for (size_t i = 0; i < sizeof(aad); ++i) {
+        aad[i] = (uint8_t) (0xa0 + i);
+    }
+
+    for (size_t i = 0; i < sizeof(pt); ++i) {
+        pt[i] = (uint8_t) (i * 7);
+    }
+}
+
+static void print_result(const char* name, const char* test, int passed)
+{
+    printf("%-14s %s ", name, test);
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+static void test_kat(const block_cipher* cipher, const uint8_t* expected, const uint8_t* expected_tag)
+{
+    uint8_t rks[1024];
+    uint8_t ct[100];
+    uint8_t tag[16];
+    gcm_key key;
+
+    cipher->keygen(rks, mk);
+    gcm_init(&key, rks, cipher);
+    gcm_encrypt(ct, tag, 16, pt, sizeof(ct), aad, sizeof(aad), iv, 12, &key);
+
+    print_result(cipher->name, "GCM", memcmp(ct, expected, sizeof(ct)) == 0 && memcmp(tag, expected_tag, 16) == 0);
+}
+
+static void test_cipher(const block_cipher* cipher, size_t ivlen, const uint8_t* expected_tag)
+{
+    uint8_t rks[1024];
+    uint8_t ct[TEST_LENGTH];
+    uint8_t dec[TEST_LENGTH];
+    uint8_t tag[16];
+    uint8_t tag_short[16];
+    gcm_key key;
+    int passed = 1;
+
+    cipher->keygen(rks, mk);
+    gcm_init(&key, rks, cipher);
+
+    gcm_encrypt(ct, tag, 16, pt, TEST_LENGTH, aad, sizeof(aad), iv, ivlen, &key);
+    if (expected_tag != NULL) {
+        passed &= memcmp(tag, expected_tag, 16) == 0;
+    }
+
+    passed &= gcm_decrypt(dec, ct, TEST_LENGTH, tag, 16, aad, sizeof(aad), iv, ivlen, &key) == 0;
+    passed &= memcmp(dec, pt, TEST_LENGTH) == 0;
+
+    // every length, so that each tail of the 8-block aggregation is covered
+    for (size_t length = 0; length <= 300; ++length) {
+        gcm_encrypt(ct, tag_short, 12, pt, length, aad, length % 21, iv, ivlen, &key);
+        memcpy(dec, ct, length);
+        passed &= gcm_decrypt(dec, dec, length, tag_short, 12, aad, length % 21, iv, ivlen, &key) == 0;
+        passed &= memcmp(dec, pt, length) == 0;
+    }
+
+    tag[15] ^= 1;
+    passed &= gcm_decrypt(dec, ct, TEST_LENGTH, tag, 16, aad, sizeof(aad), iv, ivlen, &key) == -1;
+    tag[15] ^= 1;
+
+    ct[500] ^= 1;
+    passed &= gcm_decrypt(dec, ct, TEST_LENGTH, tag, 16, aad, sizeof(aad), iv, ivlen, &key) == -1;
+    passed &= dec[0] == 0 && dec[TEST_LENGTH - 1] == 0;
+
+    // empty iv, tag lengths outside 4, 8 and 12 to 16 bytes, and more data than the 32-bit counter covers
+    passed &= gcm_encrypt(ct, tag, 16, pt, TEST_LENGTH, aad, sizeof(aad), iv, 0, &key) == -1;
+    passed &= gcm_encrypt(ct, tag, 10, pt, TEST_LENGTH, aad, sizeof(aad), iv, ivlen, &key) == -1;
+    passed &= gcm_decrypt(dec, ct, TEST_LENGTH, tag, 6, aad, sizeof(aad), iv, ivlen, &key) == -1;
+#if SIZE_MAX > 0xffffffff
+    passed &= gcm_encrypt(ct, tag, 16, pt, ((size_t) 1 << 36) - 31, aad, 0, iv, ivlen, &key) == -1;
+#endif
+
+    print_result(cipher->name, "GCM encrypt/decrypt", passed);
+}
+
+static void benchmark(const block_cipher* cipher)
+{
+    size_t length = 1 << 24;
+    uint8_t rks[1024];
+    uint8_t tag[16];
+    uint8_t y[16] = {0};
+    uint8_t* data = calloc(length, 1);
+    gcm_key key;
+
+    cipher->keygen(rks, mk);
+    gcm_init(&key, rks, cipher);
+
+    double start = omp_get_wtime();
+
+    for (size_t i = 0; i < 10; ++i) {
+        ctr_encrypt(data, data, rks, iv, length, cipher);
+        ghash_update(y, data, length, &key.ghash);
+    }
+
+    double elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for 10 x %ld bytes, %s ctr + ghash(two passes): %lf sec\n", length, cipher->name, elapsed);
+
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < 10; ++i) {
+        gcm_encrypt(data, tag, 16, data, length, aad, sizeof(aad), iv, 12, &key);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for 10 x %ld bytes, %s gcm(stitched): %lf sec\n", length, cipher->name, elapsed);
+
+    free(data);
+}
+
+int main()
+{
+    const block_cipher* ciphers[] = {
+        &CIPHER_AES128, &CIPHER_AES192, &CIPHER_AES256,
+        &CIPHER_ARIA128, &CIPHER_ARIA192, &CIPHER_ARIA256,
+    };
+
+    init_inputs();
+
+    test_kat(&CIPHER_AES128, CT_AES128, TAG_AES128);
+    test_kat(&CIPHER_ARIA128, CT_ARIA128, TAG_ARIA128);
+
+    for (size_t i = 0; i < sizeof(ciphers) / sizeof(ciphers[0]); ++i) {
+        test_cipher(ciphers[i], (i % 2 == 0) ? 12 : 60, TAGS_LONG[i]);
+    }
+
+    test_cipher(&CIPHER_LEA128, 12, NULL);
+    test_cipher(&CIPHER_LEA192, 60, NULL);
+    test_cipher(&CIPHER_LEA256, 12, NULL);
+
+    benchmark(&CIPHER_AES128);
+    benchmark(&CIPHER_LEA128);
+
+    return 0;
+}
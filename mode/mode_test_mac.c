@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+
+#include "cmac.h"
+#include "gcm.h"
+
+#define TEST_LENGTH 1000
+
+typedef struct st_mac_vector {
+    const block_cipher* cipher;
+    size_t ivlen;
+    size_t length;
+    uint8_t tag[16];
+} mac_vector;
+
+static const mac_vector CMAC_VECTORS[] = {
+    {&CIPHER_AES128, 0, 0, {0x5d, 0x05, 0xed, 0xa2, 0x5a, 0x56, 0xfa, 0xae, 0x3b, 0xc6, 0x6c, 0x27, 0xf9, 0xa2, 0x5a, 0x4d}},
+    {&CIPHER_AES128, 0, 16, {0x0d, 0x75, 0x1b, 0xe5, 0x9a, 0xdb, 0x26, 0xd4, 0x31, 0x95, 0xf3, 0xae, 0x7f, 0x9f, 0x61, 0x1d}},
+    {&CIPHER_AES128, 0, 1000, {0x7e, 0xe9, 0x13, 0xbd, 0x33, 0x18, 0xbe, 0xf4, 0x2b, 0x93, 0x39, 0xa8, 0xd6, 0x87, 0xd2, 0xca}},
+    {&CIPHER_AES256, 0, 77, {0x73, 0x3d, 0x35, 0xa3, 0xc1, 0x8f, 0xa4, 0xc9, 0x73, 0x5f, 0xaa, 0x48, 0xa7, 0xeb, 0xbb, 0x6a}},
+    {&CIPHER_ARIA128, 0, 1000, {0x0d, 0xf2, 0x28, 0xae, 0xb4, 0xa2, 0xdd, 0x45, 0x13, 0xb8, 0xb6, 0x80, 0x8a, 0x07, 0xfc, 0x5c}},
+    {&CIPHER_ARIA192, 0, 33, {0x59, 0x16, 0xa9, 0x45, 0x15, 0x6d, 0x64, 0xa6, 0x43, 0xf4, 0x56, 0xba, 0xbb, 0x94, 0xd0, 0x9b}},
+};
+
+static const mac_vector GMAC_VECTORS[] = {
+    {&CIPHER_AES128, 12, 1000, {0x0c, 0x95, 0xce, 0x1c, 0xd1, 0x02, 0x1e, 0x54, 0x01, 0xd9, 0xb1, 0x33, 0xa7, 0x18, 0xb3, 0xef}},
+    {&CIPHER_AES256, 60, 45, {0x56, 0x2c, 0x0c, 0xad, 0x44, 0x7b, 0xcc, 0xd5, 0x63, 0x85, 0x2f, 0x10, 0xf6, 0x9b, 0x02, 0x1d}},
+    {&CIPHER_ARIA128, 12, 1000, {0x8f, 0x28, 0x38, 0x67, 0xbe, 0xb3, 0x61, 0x65, 0xcd, 0x88, 0x51, 0x4c, 0x03, 0x9b, 0xc9, 0xe2}},
+};
+
+static uint8_t mk[32];
+static uint8_t iv[60];
+static uint8_t msg[TEST_LENGTH];
+
+static void init_inputs()
+{
+    for (size_t i = 0; i < sizeof(mk); ++i) {
+        mk[i] = (uint8_t) (i * 3 + 1);
+    }
+
+    for (size_t i = 0; i < sizeof(iv); ++i) {
+        iv[i] = (uint8_t) (0xc0 + i);
+    }
+
+    for (size_t i = 0; i < sizeof(msg); ++i) {
+        msg[i] = (uint8_t) (i * 7);
+    }
+}
+
+static void print_result(const char* name, const char* test, int passed)
+{
+    printf("%-14s %s ", name, test);
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+static void test_cmac_vector(const mac_vector* vector)
+{
+    const block_cipher* cipher = vector->cipher;
+    uint8_t rks[1024];
+    uint8_t tag[16];
+    cmac_key key;
+
+    cipher->keygen(rks, mk);
+    cmac_init_key(&key, rks, cipher);
+    cmac(tag, msg, vector->length, &key);
+
+    print_result(cipher->name, "CMAC", memcmp(tag, vector->tag, 16) == 0);
+}
+
+static void test_gmac_vector(const mac_vector* vector)
+{
+    const block_cipher* cipher = vector->cipher;
+    uint8_t rks[1024];
+    uint8_t tag[16];
+    gcm_key key;
+
+    cipher->keygen(rks, mk);
+    gcm_init(&key, rks, cipher);
+    gmac(tag, msg, vector->length, iv, vector->ivlen, &key);
+
+    print_result(cipher->name, "GMAC", memcmp(tag, vector->tag, 16) == 0);
+}
+
+// the incremental API split at every point and fed in small pieces must match the one-shot call
+static void test_cmac_incremental(const block_cipher* cipher)
+{
+    size_t blocksize = cipher->blocksize;
+    uint8_t rks[1024];
+    uint8_t expected[16];
+    uint8_t tag[16];
+    cmac_key key;
+    cmac_context ctx;
+    int passed = 1;
+
+    cipher->keygen(rks, mk);
+    cmac_init_key(&key, rks, cipher);
+    cmac_init(&ctx, &key);
+
+    for (size_t length = 0; length <= 100; ++length) {
+        cmac(expected, msg, length, &key);
+
+        for (size_t split = 0; split <= length; ++split) {
+            cmac_update(&ctx, msg, split);
+            cmac_update(&ctx, msg + split, length - split);
+            cmac_final(&ctx, tag);
+            passed &= memcmp(tag, expected, blocksize) == 0;
+        }
+
+        for (size_t i = 0; i < length; i += 3) {
+            cmac_update(&ctx, msg + i, (length - i < 3) ? length - i : 3);
+        }
+        cmac_final(&ctx, tag);
+        passed &= memcmp(tag, expected, blocksize) == 0;
+    }
+
+    print_result(cipher->name, "CMAC incremental", passed);
+}
+
+static void test_gmac_incremental(const block_cipher* cipher)
+{
+    uint8_t rks[1024];
+    uint8_t expected[16];
+    uint8_t tag[16];
+    gcm_key key;
+    gmac_context ctx;
+    int passed = 1;
+
+    cipher->keygen(rks, mk);
+    gcm_init(&key, rks, cipher);
+
+    for (size_t length = 0; length <= 300; length += 7) {
+        gmac(expected, msg, length, iv, 12, &key);
+
+        for (size_t split = 0; split <= length; ++split) {
+            gmac_init(&ctx, &key, iv, 12);
+            gmac_update(&ctx, msg, split);
+            gmac_update(&ctx, msg + split, length - split);
+            gmac_final(&ctx, tag);
+            passed &= memcmp(tag, expected, 16) == 0;
+        }
+    }
+
+    passed &= gmac_init(&ctx, &key, iv, 0) == -1;
+    passed &= gmac(tag, msg, 16, iv, 0, &key) == -1;
+
+    print_result(cipher->name, "GMAC incremental", passed);
+}
+
+static void benchmark(const block_cipher* cipher)
+{
+    size_t count = 1000000;
+    size_t length = 64;
+    uint8_t rks[1024];
+    uint8_t tag[16];
+    cmac_key key;
+    cmac_context ctx;
+    gcm_key gkey;
+
+    cipher->keygen(rks, mk);
+
+    double start = omp_get_wtime();
+
+    for (size_t i = 0; i < count; ++i) {
+        cmac_init_key(&key, rks, cipher);
+        cmac_init(&ctx, &key);
+        cmac_update(&ctx, msg, length);
+        cmac_final(&ctx, tag);
+    }
+
+    double elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld messages of %ld bytes, %s cmac(subkeys per message): %lf sec\n", count, length, cipher->name, elapsed);
+
+    cmac_init_key(&key, rks, cipher);
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < count; ++i) {
+        cmac(tag, msg, length, &key);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld messages of %ld bytes, %s cmac(cached subkeys, one-shot): %lf sec\n", count, length, cipher->name, elapsed);
+
+    gcm_init(&gkey, rks, cipher);
+    start = omp_get_wtime();
+
+    for (size_t i = 0; i < count; ++i) {
+        gmac(tag, msg, length, iv, 12, &gkey);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld messages of %ld bytes, %s gmac(cached H powers, one-shot): %lf sec\n", count, length, cipher->name, elapsed);
+}
+
+int main()
+{
+    const block_cipher* ciphers[] = {
+        &CIPHER_AES128, &CIPHER_ARIA256, &CIPHER_HIGHT, &CIPHER_LEA128, &CIPHER_SEED,
+    };
+
+    init_inputs();
+
+    for (size_t i = 0; i < sizeof(CMAC_VECTORS) / sizeof(CMAC_VECTORS[0]); ++i) {
+        test_cmac_vector(&CMAC_VECTORS[i]);
+    }
+
+    for (size_t i = 0; i < sizeof(GMAC_VECTORS) / sizeof(GMAC_VECTORS[0]); ++i) {
+        test_gmac_vector(&GMAC_VECTORS[i]);
+    }
+
+    for (size_t i = 0; i < sizeof(ciphers) / sizeof(ciphers[0]); ++i) {
+        test_cmac_incremental(ciphers[i]);
+    }
+
+    test_gmac_incremental(&CIPHER_AES128);
+    test_gmac_incremental(&CIPHER_LEA256);
+
+    benchmark(&CIPHER_AES128);
+
+    return 0;
+}
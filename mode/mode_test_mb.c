@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#include "cbc.h"
+#include "cbc_mb.h"
+
+#define NUM_JOBS 100
+
+static void test_lanes(const lane_cipher* lanes, const block_cipher* cipher)
+{
+    static uint8_t mk[NUM_JOBS][32];
+    static uint8_t rks[NUM_JOBS][1024];
+    static uint8_t iv[NUM_JOBS][16];
+    static uint8_t pt[NUM_JOBS][640];
+    static uint8_t ct[NUM_JOBS][640];
+    static uint8_t expected[640];
+    cbc_job jobs[NUM_JOBS];
+    int passed = 1;
+
+    for (size_t i = 0; i < NUM_JOBS; ++i) {
+        for (size_t j = 0; j < 32; ++j) {
+            mk[i][j] = (uint8_t) (i * 31 + j);
+        }
+
+        for (size_t j = 0; j < 16; ++j) {
+            iv[i][j] = (uint8_t) (i + j * 7);
+        }
+
+        for (size_t j = 0; j < sizeof(pt[i]); ++j) {
+            pt[i][j] = (uint8_t) (i ^ (j * 13));
+        }
+
+        cipher->keygen(rks[i], mk[i]);
+
+        // lengths from 0 to 39 blocks so the lanes finish at different times
+        jobs[i].ct = ct[i];
+        jobs[i].pt = pt[i];
+        jobs[i].length = 16 * ((i * 7) % 40);
+        jobs[i].rks = rks[i];
+        jobs[i].iv = iv[i];
+    }
+
+    cbc_encrypt_jobs(jobs, NUM_JOBS, lanes);
+
+    for (size_t i = 0; i < NUM_JOBS; ++i) {
+        cbc_encrypt(expected, pt[i], rks[i], iv[i], jobs[i].length, cipher);
+        passed &= memcmp(expected, ct[i], jobs[i].length) == 0;
+    }
+
+    printf("%s x%ld multi-buffer CBC ", lanes->name, lanes->lanes);
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+static void benchmark(const lane_cipher* lanes, const block_cipher* cipher, size_t njobs, size_t length)
+{
+    uint8_t mk[32] = {0};
+    uint8_t iv[16] = {0};
+    uint8_t* rks = calloc(njobs, 1024);
+    uint8_t* pt = calloc(njobs, length);
+    uint8_t* ct = calloc(njobs, length);
+    cbc_job* jobs = calloc(njobs, sizeof(cbc_job));
+
+    for (size_t i = 0; i < njobs; ++i) {
+        mk[0] = (uint8_t) i;
+        cipher->keygen(rks + 1024 * i, mk);
+
+        jobs[i].ct = ct + length * i;
+        jobs[i].pt = pt + length * i;
+        jobs[i].length = length;
+        jobs[i].rks = rks + 1024 * i;
+        jobs[i].iv = iv;
+    }
+
+    double start = omp_get_wtime();
+
+    for (size_t i = 0; i < njobs; ++i) {
+        cbc_encrypt(jobs[i].ct, jobs[i].pt, jobs[i].rks, jobs[i].iv, length, cipher);
+    }
+
+    double elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld sessions of %ld bytes, %s cbc(serial): %lf sec\n", njobs, length, cipher->name, elapsed);
+
+    start = omp_get_wtime();
+
+    cbc_encrypt_jobs(jobs, njobs, lanes);
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for %ld sessions of %ld bytes, %s cbc(x%ld lanes): %lf sec\n", njobs, length, cipher->name, lanes->lanes, elapsed);
+
+    free(rks);
+    free(pt);
+    free(ct);
+    free(jobs);
+}
+
+int main()
+{
+    test_lanes(&LANES_AES128, &CIPHER_AES128);
+    test_lanes(&LANES_AES192, &CIPHER_AES192);
+    test_lanes(&LANES_AES256, &CIPHER_AES256);
+    test_lanes(&LANES_LEA128_X8, &CIPHER_LEA128);
+    test_lanes(&LANES_LEA192_X8, &CIPHER_LEA192);
+    test_lanes(&LANES_LEA256_X8, &CIPHER_LEA256);
+    test_lanes(&LANES_LEA128_X16, &CIPHER_LEA128);
+    test_lanes(&LANES_LEA192_X16, &CIPHER_LEA192);
+    test_lanes(&LANES_LEA256_X16, &CIPHER_LEA256);
+
+    benchmark(&LANES_AES128, &CIPHER_AES128, 100000, 256);
+    benchmark(&LANES_LEA128_X8, &CIPHER_LEA128, 100000, 256);
+    benchmark(&LANES_LEA128_X16, &CIPHER_LEA128, 100000, 256);
+
+    return 0;
+}
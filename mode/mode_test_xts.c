@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#include "xts.h"
+
+#define TEST_LENGTH 5000
+#define SECTOR_SIZE 4096
+
+typedef struct st_xts_vector {
+    const block_cipher* cipher;
+    size_t length;
+    uint8_t first[16];
+    uint8_t last[16];
+} xts_vector;
+
+static const xts_vector VECTORS[] = {
+    {&CIPHER_AES128, 1000,
+        {0xe3, 0xcd, 0xf5, 0x4a, 0x94, 0xec, 0x96, 0xa4, 0x5b, 0xe5, 0xf5, 0xf6, 0x9d, 0x28, 0x91, 0x02},
+        {0xdc, 0x81, 0xd7, 0xf6, 0xf1, 0x48, 0xf7, 0x91, 0x27, 0x25, 0x80, 0xff, 0x40, 0x79, 0x0c, 0x83}},
+    {&CIPHER_AES128, 17,
+        {0xc5, 0xf3, 0x72, 0xd1, 0x9c, 0x8b, 0x51, 0x94, 0xf1, 0x48, 0x76, 0x9d, 0x33, 0xf3, 0xa8, 0x02},
+        {0xf3, 0x72, 0xd1, 0x9c, 0x8b, 0x51, 0x94, 0xf1, 0x48, 0x76, 0x9d, 0x33, 0xf3, 0xa8, 0x02, 0xe3}},
+    {&CIPHER_AES256, 512,
+        {0xfb, 0x7f, 0xa3, 0xba, 0xac, 0xe0, 0xfd, 0xb9, 0x22, 0xd0, 0x93, 0xe1, 0x52, 0x16, 0x0c, 0x42},
+        {0x4c, 0xc6, 0x2c, 0x51, 0x34, 0x57, 0xf3, 0xcb, 0xac, 0xf6, 0x98, 0x33, 0xda, 0x9c, 0xc0, 0xf3}},
+    {&CIPHER_AES256, 4101,
+        {0xfb, 0x7f, 0xa3, 0xba, 0xac, 0xe0, 0xfd, 0xb9, 0x22, 0xd0, 0x93, 0xe1, 0x52, 0x16, 0x0c, 0x42},
+        {0x1f, 0x1d, 0xf9, 0x4d, 0xe6, 0xc9, 0xfe, 0x7b, 0xe7, 0x7b, 0x56, 0xe7, 0x82, 0xbf, 0xbc, 0xa1}},
+};
+
+// data key followed by the tweak key
+static uint8_t mk[64];
+static uint8_t tweak[16];
+static uint8_t pt[TEST_LENGTH];
+
+static void init_inputs()
+{
+    for (size_t i = 0; i < sizeof(mk); ++i) {
+        mk[i] = (uint8_t) (i * 3 + 1);
+    }
+
+    for (size_t i = 0; i < sizeof(tweak); ++i) {
+        tweak[i] = (uint8_t) (0x30 + i);
+    }
+
+    for (size_t i = 0; i < sizeof(pt); ++i) {
+        pt[i] = (uint8_t) (i * 7);
+    }
+}
+
+static void print_result(const char* name, const char* test, int passed)
+{
+    printf("%-14s %s ", name, test);
+    if (passed) {
+        printf("passed\n");
+    } else {
+        printf("failed\n");
+    }
+}
+
+static void test_vector(const xts_vector* vector)
+{
+    const block_cipher* cipher = vector->cipher;
+    uint8_t rks[1024], drks[1024], trks[1024];
+    uint8_t ct[TEST_LENGTH];
+    uint8_t dec[TEST_LENGTH];
+    int passed = 1;
+
+    cipher->keygen(rks, mk);
+    cipher->keygen_dec(drks, mk);
+    cipher->keygen(trks, mk + cipher->keysize);
+
+    passed &= xts_encrypt(ct, pt, rks, trks, tweak, vector->length, cipher) == 0;
+    passed &= memcmp(ct, vector->first, 16) == 0;
+    passed &= memcmp(ct + vector->length - 16, vector->last, 16) == 0;
+
+    passed &= xts_decrypt(dec, ct, drks, trks, tweak, vector->length, cipher) == 0;
+    passed &= memcmp(dec, pt, vector->length) == 0;
+
+    print_result(cipher->name, "XTS", passed);
+}
+
+static void test_cipher(const block_cipher* cipher)
+{
+    uint8_t rks[1024], drks[1024], trks[1024];
+    uint8_t sector_tweak[16] = {0};
+    uint8_t* ct = calloc(8, SECTOR_SIZE + 5);
+    uint8_t* expected = calloc(8, SECTOR_SIZE + 5);
+    uint8_t* data = calloc(8, SECTOR_SIZE + 5);
+    int passed = 1;
+
+    cipher->keygen(rks, mk);
+    cipher->keygen_dec(drks, mk);
+    cipher->keygen(trks, mk + cipher->keysize);
+
+    // every tail length, in place
+    for (size_t length = 16; length <= 300; ++length) {
+        xts_encrypt(ct, pt, rks, trks, tweak, length, cipher);
+        xts_decrypt(ct, ct, drks, trks, tweak, length, cipher);
+        passed &= memcmp(ct, pt, length) == 0;
+    }
+
+    passed &= xts_encrypt(ct, pt, rks, trks, tweak, 15, cipher) == -1;
+
+    // sector batches against one call per sector, with whole and stolen sector sizes
+    for (size_t size = SECTOR_SIZE; size <= SECTOR_SIZE + 5; size += 5) {
+        for (size_t i = 0; i < 8 * size; ++i) {
+            data[i] = (uint8_t) (i * 13);
+        }
+
+        for (size_t i = 0; i < 8; ++i) {
+            uint64_t number = 0x1234567890ULL + i;
+            memcpy(sector_tweak, &number, 8);
+            xts_encrypt(expected + i * size, data + i * size, rks, trks, sector_tweak, size, cipher);
+        }
+
+        xts_encrypt_sectors(ct, data, rks, trks, 0x1234567890ULL, size, 8, cipher);
+        passed &= memcmp(ct, expected, 8 * size) == 0;
+
+        xts_decrypt_sectors(ct, ct, drks, trks, 0x1234567890ULL, size, 8, cipher);
+        passed &= memcmp(ct, data, 8 * size) == 0;
+    }
+
+    print_result(cipher->name, "XTS encrypt/decrypt", passed);
+
+    free(ct);
+    free(expected);
+    free(data);
+}
+
+static void benchmark(const block_cipher* cipher)
+{
+    size_t nsectors = 1 << 12;
+    uint8_t rks[1024], trks[1024];
+    uint8_t sector_tweak[16] = {0};
+    uint8_t* data = calloc(nsectors, SECTOR_SIZE);
+
+    cipher->keygen(rks, mk);
+    cipher->keygen(trks, mk + cipher->keysize);
+
+    double start = omp_get_wtime();
+
+    for (size_t r = 0; r < 10; ++r) {
+        for (uint64_t i = 0; i < nsectors; ++i) {
+            memcpy(sector_tweak, &i, 8);
+            xts_encrypt(data + i * SECTOR_SIZE, data + i * SECTOR_SIZE, rks, trks, sector_tweak, SECTOR_SIZE, cipher);
+        }
+    }
+
+    double elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for 10 x %ld sectors, %s xts(per sector): %lf sec\n", nsectors, cipher->name, elapsed);
+
+    start = omp_get_wtime();
+
+    for (size_t r = 0; r < 10; ++r) {
+        xts_encrypt_sectors(data, data, rks, trks, 0, SECTOR_SIZE, nsectors, cipher);
+    }
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed for 10 x %ld sectors, %s xts(sector batch): %lf sec\n", nsectors, cipher->name, elapsed);
+
+    free(data);
+}
+
+int main()
+{
+    const block_cipher* ciphers[] = {
+        &CIPHER_AES128, &CIPHER_AES192, &CIPHER_AES256,
+        &CIPHER_ARIA128, &CIPHER_ARIA192, &CIPHER_ARIA256,
+        &CIPHER_LEA128, &CIPHER_LEA192, &CIPHER_LEA256,
+    };
+
+    init_inputs();
+
+    for (size_t i = 0; i < sizeof(VECTORS) / sizeof(VECTORS[0]); ++i) {
+        test_vector(&VECTORS[i]);
+    }
+
+    for (size_t i = 0; i < sizeof(ciphers) / sizeof(ciphers[0]); ++i) {
+        test_cipher(ciphers[i]);
+    }
+
+    benchmark(&CIPHER_AES128);
+    benchmark(&CIPHER_LEA128);
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "parallel.h"
+#include "ctr.h"
+
+#include <omp.h>
+
+static int thread_count(int nthreads)
+{
+    return nthreads > 0 ? nthreads : omp_get_max_threads();
+}
+
+// chunks are whole batches so ECB blocks and CTR counters never straddle two threads
+static size_t chunk_size(const block_cipher* cipher)
+{
+    size_t unit = cipher->blocksize * (cipher->batch > 0 ? cipher->batch : 1);
+
+    return PARALLEL_CHUNK_SIZE - (PARALLEL_CHUNK_SIZE % unit);
+}
+
+void ecb_encrypt_parallel(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, size_t length, const block_cipher* cipher, int nthreads)
+{
+    size_t blocksize = cipher->blocksize;
+    size_t chunk = chunk_size(cipher);
+    size_t nblocks = length / blocksize;
+    size_t nchunks = (nblocks * blocksize + chunk - 1) / chunk;
+
+    #pragma omp parallel for schedule(static) num_threads(thread_count(nthreads)) if(nchunks > 1)
+    for (size_t i = 0; i < nchunks; ++i) {
+        size_t offset = i * chunk;
+        size_t count = (i == nchunks - 1) ? nblocks - offset / blocksize : chunk / blocksize;
+
+        cipher_encrypt_blocks(cipher, ct + offset, pt + offset, count, rks);
+    }
+}
+
+void ecb_decrypt_parallel(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, size_t length, const block_cipher* cipher, int nthreads)
+{
+    size_t blocksize = cipher->blocksize;
+    size_t chunk = chunk_size(cipher);
+    size_t nblocks = length / blocksize;
+    size_t nchunks = (nblocks * blocksize + chunk - 1) / chunk;
+
+    #pragma omp parallel for schedule(static) num_threads(thread_count(nthreads)) if(nchunks > 1)
+    for (size_t i = 0; i < nchunks; ++i) {
+        size_t offset = i * chunk;
+        size_t count = (i == nchunks - 1) ? nblocks - offset / blocksize : chunk / blocksize;
+
+        cipher_decrypt_blocks(cipher, pt + offset, ct + offset, count, rks);
+    }
+}
+
+void ctr_encrypt_parallel(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* iv, size_t length, const block_cipher* cipher, int nthreads)
+{
+    size_t chunk = chunk_size(cipher);
+    size_t nchunks = (length + chunk - 1) / chunk;
+
+    #pragma omp parallel for schedule(static) num_threads(thread_count(nthreads)) if(nchunks > 1)
+    for (size_t i = 0; i < nchunks; ++i) {
+        size_t offset = i * chunk;
+        size_t count = (i == nchunks - 1) ? length - offset : chunk;
+
+        ctr_crypt_at(ct + offset, pt + offset, rks, iv, offset, count, cipher);
+    }
+}
+
+void ctr_decrypt_parallel(uint8_t* pt, const uint8_t* ct, const uint8_t* rks, const uint8_t* iv, size_t length, const block_cipher* cipher, int nthreads)
+{
+    ctr_encrypt_parallel(pt, ct, rks, iv, length, cipher, nthreads);
+}
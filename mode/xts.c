@@ -0,0 +1,209 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "xts.h"
+#include "util.inc"
+
+// number of blocks, and of sector tweaks, processed at once
+#define XTS_BATCH_BLOCKS 32
+
+/**
+ * writes nblocks consecutive tweaks t, t * alpha, t * alpha^2, ... and leaves the next one in tweak.
+ * The 128-bit value is little-endian, doubling shifts every 32-bit word left and moves the carries
+ * one word up, the carry out of the top word being reduced by x^7 + x^2 + x + 1.
+ */
+static void build_tweaks(uint8_t* out, uint8_t* tweak, size_t nblocks)
+{
+#if defined(__SSE2__)
+    const __m128i poly = _mm_set_epi32(1, 1, 1, 0x87);
+    __m128i t = _mm_loadu_si128((const __m128i*) tweak);
+
+    for (size_t i = 0; i < nblocks; ++i) {
+        _mm_storeu_si128((__m128i*) out, t);
+        out += 16;
+
+        __m128i carry = _mm_shuffle_epi32(_mm_srai_epi32(t, 31), 0x93);
+        t = _mm_xor_si128(_mm_slli_epi32(t, 1), _mm_and_si128(carry, poly));
+    }
+
+    _mm_storeu_si128((__m128i*) tweak, t);
+#else
+    uint64_t lo, hi;
+    memcpy(&lo, tweak, 8);
+    memcpy(&hi, tweak + 8, 8);
+
+    for (size_t i = 0; i < nblocks; ++i) {
+        memcpy(out, &lo, 8);
+        memcpy(out + 8, &hi, 8);
+        out += 16;
+
+        uint64_t carry = 0 - (hi >> 63);
+        hi = (hi << 1) | (lo >> 63);
+        lo = (lo << 1) ^ (carry & 0x87);
+    }
+
+    memcpy(tweak, &lo, 8);
+    memcpy(tweak + 8, &hi, 8);
+#endif
+}
+
+// out = func(in ^ t) ^ t over nblocks whole blocks, tweak is advanced past them
+static void xts_blocks(uint8_t* out, const uint8_t* in, const uint8_t* rks, uint8_t* tweak, size_t nblocks, int decrypt, const block_cipher* cipher)
+{
+    size_t batch = cipher_batch_blocks(cipher, XTS_BATCH_BLOCKS);
+    uint8_t tweaks[XTS_BATCH_BLOCKS * 16];
+    uint8_t buffer[XTS_BATCH_BLOCKS * 16];
+
+    while (nblocks > 0) {
+        size_t count = (nblocks < batch) ? nblocks : batch;
+        size_t chunk = count * 16;
+
+        build_tweaks(tweaks, tweak, count);
+        xor(buffer, in, tweaks, chunk);
+
+        if (decrypt) {
+            cipher_decrypt_blocks(cipher, buffer, buffer, count, rks);
+        } else {
+            cipher_encrypt_blocks(cipher, buffer, buffer, count, rks);
+        }
+
+        xor(out, buffer, tweaks, chunk);
+
+        in += chunk;
+        out += chunk;
+        nblocks -= count;
+    }
+}
+
+// one data unit with its encrypted tweak, the last partial block is stolen from the one before
+static void xts_unit(uint8_t* out, const uint8_t* in, const uint8_t* rks, uint8_t* tweak, size_t length, int decrypt, const block_cipher* cipher)
+{
+    block_func single = decrypt ? cipher->decrypt : cipher->encrypt;
+    size_t remains = length % 16;
+    size_t nblocks = length / 16;
+    uint8_t last[16];
+    uint8_t stolen[16];
+    uint8_t tweaks[32];
+
+    if (remains == 0) {
+        xts_blocks(out, in, rks, tweak, nblocks, decrypt, cipher);
+        return;
+    }
+
+    xts_blocks(out, in, rks, tweak, nblocks - 1, decrypt, cipher);
+    in += 16 * (nblocks - 1);
+    out += 16 * (nblocks - 1);
+
+    // decryption takes the two last tweaks in reverse order
+    build_tweaks(tweaks, tweak, 2);
+    if (decrypt) {
+        memcpy(stolen, tweaks, 16);
+        memcpy(tweaks, tweaks + 16, 16);
+        memcpy(tweaks + 16, stolen, 16);
+    }
+
+    xor(last, in, tweaks, 16);
+    single(last, last, rks);
+    xor(last, last, tweaks, 16);
+
+    memcpy(stolen, in + 16, remains);
+    memcpy(stolen + remains, last + remains, 16 - remains);
+    memcpy(out + 16, last, remains);
+
+    xor(stolen, stolen, tweaks + 16, 16);
+    single(stolen, stolen, rks);
+    xor(out, stolen, tweaks + 16, 16);
+}
+
+static int xts_crypt(uint8_t* out, const uint8_t* in, const uint8_t* rks, const uint8_t* trks, const uint8_t* tweak, size_t length, int decrypt, const block_cipher* cipher)
+{
+    uint8_t t[16];
+
+    if (cipher->blocksize != 16 || length < 16) {
+        return -1;
+    }
+
+    cipher->encrypt(t, tweak, trks);
+    xts_unit(out, in, rks, t, length, decrypt, cipher);
+
+    return 0;
+}
+
+int xts_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* trks, const uint8_t* tweak, size_t length, const block_cipher* cipher)
+{
+    return xts_crypt(ct, pt, rks, trks, tweak, length, 0, cipher);
+}
+
+int xts_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* drks, const uint8_t* trks, const uint8_t* tweak, size_t length, const block_cipher* cipher)
+{
+    return xts_crypt(pt, ct, drks, trks, tweak, length, 1, cipher);
+}
+
+static int xts_crypt_sectors(uint8_t* out, const uint8_t* in, const uint8_t* rks, const uint8_t* trks, uint64_t sector, size_t sector_size, size_t nsectors, int decrypt, const block_cipher* cipher)
+{
+    uint8_t tweaks[XTS_BATCH_BLOCKS * 16];
+    size_t batch = cipher_batch_blocks(cipher, XTS_BATCH_BLOCKS);
+
+    if (cipher->blocksize != 16 || sector_size < 16) {
+        return -1;
+    }
+
+    while (nsectors > 0) {
+        size_t count = (nsectors < batch) ? nsectors : batch;
+
+        memset(tweaks, 0, count * 16);
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t number = sector + i;
+            for (size_t j = 0; j < 8; ++j) {
+                tweaks[16 * i + j] = (uint8_t) (number >> (8 * j));
+            }
+        }
+
+        cipher_encrypt_blocks(cipher, tweaks, tweaks, count, trks);
+
+        for (size_t i = 0; i < count; ++i) {
+            xts_unit(out, in, rks, tweaks + 16 * i, sector_size, decrypt, cipher);
+            in += sector_size;
+            out += sector_size;
+        }
+
+        sector += count;
+        nsectors -= count;
+    }
+
+    return 0;
+}
+
+int xts_encrypt_sectors(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* trks, uint64_t sector, size_t sector_size, size_t nsectors, const block_cipher* cipher)
+{
+    return xts_crypt_sectors(ct, pt, rks, trks, sector, sector_size, nsectors, 0, cipher);
+}
+
+int xts_decrypt_sectors(uint8_t* pt, const uint8_t* ct, const uint8_t* drks, const uint8_t* trks, uint64_t sector, size_t sector_size, size_t nsectors, const block_cipher* cipher)
+{
+    return xts_crypt_sectors(pt, ct, drks, trks, sector, sector_size, nsectors, 1, cipher);
+}
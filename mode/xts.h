@@ -0,0 +1,47 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2019 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "cipher.h"
+
+/**
+ * XTS mode, IEEE 1619 and NIST SP 800-38E, for 16-byte block ciphers.
+ * rks are the data round keys (decryption round keys for xts_decrypt) and trks the encryption
+ * round keys of the tweak key. A trailing partial block is handled by ciphertext stealing,
+ * so length is at least 16 bytes. Both work in place and return -1 for invalid parameters.
+ */
+int xts_encrypt(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* trks, const uint8_t* tweak, size_t length, const block_cipher* cipher);
+int xts_decrypt(uint8_t* pt, const uint8_t* ct, const uint8_t* drks, const uint8_t* trks, const uint8_t* tweak, size_t length, const block_cipher* cipher);
+
+/**
+ * nsectors consecutive data units of sector_size bytes, the first one numbered sector.
+ * The tweak of each unit is its number as a 128-bit little-endian value, and the tweaks
+ * of a batch of sectors are encrypted in one multi-block call.
+ */
+int xts_encrypt_sectors(uint8_t* ct, const uint8_t* pt, const uint8_t* rks, const uint8_t* trks, uint64_t sector, size_t sector_size, size_t nsectors, const block_cipher* cipher);
+int xts_decrypt_sectors(uint8_t* pt, const uint8_t* ct, const uint8_t* drks, const uint8_t* trks, uint64_t sector, size_t sector_size, size_t nsectors, const block_cipher* cipher);
@@ -0,0 +1,95 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2018 Ilwoong Jeong, https://github.com/ilwoong
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cpu.h"
+
+#include <cpuid.h>
+
+static cpu_features features;
+static int probed = 0;
+
+static uint64_t xgetbv(uint32_t index)
+{
+    uint32_t eax, edx;
+
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+
+    return ((uint64_t) edx << 32) | eax;
+}
+
+static void probe(cpu_features* out)
+{
+    uint32_t eax, ebx, ecx, edx;
+    uint32_t max_leaf = __get_cpuid_max(0, NULL);
+    uint64_t xcr0 = 0;
+    int ymm_enabled = 0;
+    int zmm_enabled = 0;
+
+    if (max_leaf < 1) {
+        return;
+    }
+
+    __cpuid(1, eax, ebx, ecx, edx);
+
+    out->sse2 = (edx >> 26) & 1;
+    out->ssse3 = (ecx >> 9) & 1;
+    out->sse41 = (ecx >> 19) & 1;
+    out->sse42 = (ecx >> 20) & 1;
+    out->aesni = (ecx >> 25) & 1;
+    out->pclmul = (ecx >> 1) & 1;
+
+    // OSXSAVE, then check the XMM/YMM and opmask/ZMM state bits
+    if ((ecx >> 27) & 1) {
+        xcr0 = xgetbv(0);
+        ymm_enabled = (xcr0 & 0x06) == 0x06;
+        zmm_enabled = (xcr0 & 0xe6) == 0xe6;
+    }
+
+    out->avx = ymm_enabled && ((ecx >> 28) & 1);
+
+    if (max_leaf < 7) {
+        return;
+    }
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+    out->avx2 = out->avx && ((ebx >> 5) & 1);
+    out->avx512f = zmm_enabled && ((ebx >> 16) & 1);
+    out->avx512vl = out->avx512f && ((ebx >> 31) & 1);
+    out->vaes = out->avx && ((ecx >> 9) & 1);
+    out->vpclmulqdq = out->avx && ((ecx >> 10) & 1);
+}
+
+const cpu_features* cpu_get_features(void)
+{
+    if (probed == 0) {
+        probe(&features);
+        probed = 1;
+    }
+
+    return &features;
+}